@@ -0,0 +1,185 @@
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace Haze
+{
+  // what a processor is prepared for (message thread, before the first block)
+  struct ProcessSpec
+  {
+    double sampleRate = 44100.0;
+    int maxBlockSize = 512;
+    int numChannels = 2;
+  };
+
+
+  // per-block information handed to ProcessorInterface::processBlock
+  struct BlockContext
+  {
+    double sampleRate = 44100.0;
+    juce::int64 samplePosition = 0; // timeline position of the block's first sample
+
+    // context for the part of a block starting numSamples later
+    [[nodiscard]] BlockContext Advanced(int numSamples) const noexcept { return { sampleRate, samplePosition + numSamples }; }
+  };
+
+
+  // non-owning view of planar (one pointer per channel) audio, float or double
+  // cheap to copy and pass by value; any block size, including sub-blocks of a larger buffer
+  template <typename T>
+  class AudioBlockView
+  {
+  public:
+    static_assert(std::is_same<T, float>::value || std::is_same<T, double>::value);
+
+    AudioBlockView() = default;
+    AudioBlockView(T* const* channels, int numChannels, int numSamples, int startSample = 0) noexcept
+    : channels_(channels)
+    , numChannels_(numChannels)
+    , numSamples_(numSamples)
+    , startSample_(startSample)
+    {}
+
+    [[nodiscard]] int GetNumChannels() const noexcept { return numChannels_; }
+    [[nodiscard]] int GetNumSamples() const noexcept { return numSamples_; }
+
+    [[nodiscard]] T* GetChannel(int channel) const noexcept
+    {
+      jassert(juce::isPositiveAndBelow(channel, numChannels_));
+      return channels_[channel] + startSample_;
+    }
+
+    [[nodiscard]] AudioBlockView GetSubBlock(int startSample, int numSamples) const noexcept
+    {
+      jassert(startSample >= 0 && numSamples >= 0 && startSample + numSamples <= numSamples_);
+      return { channels_, numChannels_, numSamples, startSample_ + startSample };
+    }
+
+    [[nodiscard]] AudioBlockView GetChannelRange(int firstChannel, int numChannels) const noexcept
+    {
+      jassert(firstChannel >= 0 && numChannels >= 0 && firstChannel + numChannels <= numChannels_);
+      return { channels_ + firstChannel, numChannels, numSamples_, startSample_ };
+    }
+
+    // (channel/sample counts must match)
+    void Clear() const noexcept
+    {
+      for (int ch = 0; ch < numChannels_; ++ch)
+      {
+        juce::FloatVectorOperations::clear(GetChannel(ch), numSamples_);
+      }
+    }
+
+    void CopyFrom(const AudioBlockView& source) const noexcept
+    {
+      jassert(source.numChannels_ == numChannels_ && source.numSamples_ == numSamples_);
+      for (int ch = 0; ch < numChannels_; ++ch)
+      {
+        juce::FloatVectorOperations::copy(GetChannel(ch), source.GetChannel(ch), numSamples_);
+      }
+    }
+
+    void AddFrom(const AudioBlockView& source) const noexcept
+    {
+      jassert(source.numChannels_ == numChannels_ && source.numSamples_ == numSamples_);
+      for (int ch = 0; ch < numChannels_; ++ch)
+      {
+        juce::FloatVectorOperations::add(GetChannel(ch), source.GetChannel(ch), numSamples_);
+      }
+    }
+
+    void Multiply(T gain) const noexcept
+    {
+      for (int ch = 0; ch < numChannels_; ++ch)
+      {
+        juce::FloatVectorOperations::multiply(GetChannel(ch), gain, numSamples_);
+      }
+    }
+
+  private:
+    T* const* channels_ = nullptr;
+    int numChannels_ = 0;
+    int numSamples_ = 0;
+    int startSample_ = 0;
+  }; // AudioBlockView<T>
+
+
+  // owning planar buffer, every channel starts on a 64 byte boundary (one allocation for all channels)
+  template <typename T>
+  class AlignedAudioBuffer
+  {
+  public:
+    static constexpr size_t Alignment = 64;
+
+    AlignedAudioBuffer() = default;
+    AlignedAudioBuffer(int numChannels, int numSamples) { SetSize(numChannels, numSamples); }
+    AlignedAudioBuffer(AlignedAudioBuffer&& other) noexcept { swap(other); }
+    AlignedAudioBuffer& operator=(AlignedAudioBuffer&& other) noexcept { swap(other); return *this; }
+    ~AlignedAudioBuffer() { Free(data_); }
+
+    void swap(AlignedAudioBuffer& other) noexcept
+    {
+      std::swap(data_, other.data_);
+      channels_.swap(other.channels_);
+      std::swap(numSamples_, other.numSamples_);
+    }
+
+    // (re)allocates and clears (message thread)
+    void SetSize(int numChannels, int numSamples)
+    {
+      jassert(numChannels >= 0 && numSamples >= 0);
+
+      constexpr size_t valuesPerLine = Alignment / sizeof(T);
+      const size_t stride = (static_cast<size_t>(numSamples) + valuesPerLine - 1) / valuesPerLine * valuesPerLine;
+
+      Free(data_);
+      data_ = nullptr;
+      channels_.assign(static_cast<size_t>(numChannels), nullptr);
+      numSamples_ = numSamples;
+
+      if (stride * static_cast<size_t>(numChannels) > 0)
+      {
+        data_ = static_cast<T*>(::operator new(sizeof(T) * stride * static_cast<size_t>(numChannels), std::align_val_t(Alignment)));
+        std::fill(data_, data_ + stride * static_cast<size_t>(numChannels), T {});
+      }
+
+      for (size_t ch = 0; ch < channels_.size(); ++ch)
+      {
+        channels_[ch] = data_ + stride * ch;
+      }
+    }
+
+    [[nodiscard]] int GetNumChannels() const noexcept { return static_cast<int>(channels_.size()); }
+    [[nodiscard]] int GetNumSamples() const noexcept { return numSamples_; }
+    [[nodiscard]] T* GetChannel(int channel) const noexcept { return channels_[static_cast<size_t>(channel)]; }
+
+    [[nodiscard]] AudioBlockView<T> GetView() const noexcept { return { channels_.data(), GetNumChannels(), numSamples_ }; }
+
+    // the first numChannels x numSamples (both may be less than allocated)
+    [[nodiscard]] AudioBlockView<T> GetView(int numChannels, int numSamples) const noexcept
+    {
+      jassert(numChannels <= GetNumChannels() && numSamples <= numSamples_);
+      return { channels_.data(), numChannels, numSamples };
+    }
+
+  private:
+    static void Free(T* ptr) noexcept
+    {
+      if (ptr != nullptr)
+      {
+        ::operator delete(ptr, std::align_val_t(Alignment));
+      }
+    }
+
+    T* data_ = nullptr;
+    std::vector<T*> channels_;
+    int numSamples_ = 0;
+
+    JUCE_DECLARE_NON_COPYABLE(AlignedAudioBuffer)
+  }; // AlignedAudioBuffer<T>
+
+} // namespace Haze
@@ -0,0 +1,343 @@
+
+#include "Automation.h"
+#include "ParameterSmoothing.h"
+
+namespace Haze
+{
+// AutomationLane impl:
+  void AutomationLane::Add(juce::int64 position, float value)
+  {
+    jassert(breakpoints_.empty() || position > breakpoints_.back().position);
+    breakpoints_.push_back({ position, value });
+  }
+
+  float AutomationLane::Evaluate(juce::int64 position) const noexcept
+  {
+    if (breakpoints_.empty())
+    {
+      return 0.f;
+    }
+
+    const int segment = FindSegment(position, -2); // (no hint)
+    if (segment < 0)
+    {
+      return breakpoints_.front().value;
+    }
+
+    const Breakpoint& start = breakpoints_[static_cast<size_t>(segment)];
+    if (segment + 1 >= GetNumBreakpoints())
+    {
+      return start.value;
+    }
+
+    return static_cast<float>(start.value + GetSlope(segment) * static_cast<double>(position - start.position));
+  }
+
+  void AutomationLane::RenderBlock(juce::int64 startPosition, float* dst, int numSamples, int& segmentHint) const noexcept
+  {
+    const int numBreakpoints = GetNumBreakpoints();
+    if (numBreakpoints == 0)
+    {
+      juce::FloatVectorOperations::clear(dst, numSamples);
+      return;
+    }
+
+    int segment = FindSegment(startPosition, segmentHint);
+    for (int done = 0; done < numSamples;)
+    {
+      const juce::int64 position = startPosition + done;
+      while (segment + 1 < numBreakpoints && breakpoints_[static_cast<size_t>(segment + 1)].position <= position)
+      {
+        ++segment;
+      }
+
+      // up to the next breakpoint, or the end of the block
+      int length = numSamples - done;
+      if (segment + 1 < numBreakpoints)
+      {
+        length = static_cast<int>(juce::jmin(static_cast<juce::int64>(length), breakpoints_[static_cast<size_t>(segment + 1)].position - position));
+      }
+
+      if (segment < 0 || segment + 1 >= numBreakpoints)
+      {
+        // held before the first/after the last breakpoint
+        juce::FloatVectorOperations::fill(dst + done, breakpoints_[static_cast<size_t>(juce::jmax(0, segment))].value, length);
+      }
+      else
+      {
+        const Breakpoint& start = breakpoints_[static_cast<size_t>(segment)];
+        const double slope = GetSlope(segment);
+        const double first = start.value + slope * static_cast<double>(position - start.position);
+        FillLinearRamp(dst + done, static_cast<float>(first - slope), static_cast<float>(slope), length);
+      }
+
+      done += length;
+    }
+
+    segmentHint = segment;
+  }
+
+  int AutomationLane::FindSegment(juce::int64 position, int hint) const noexcept
+  {
+    const int numBreakpoints = GetNumBreakpoints();
+    const auto contains = [this, numBreakpoints, position](int segment)
+    {
+      return (segment < 0 || breakpoints_[static_cast<size_t>(segment)].position <= position)
+          && (segment + 1 >= numBreakpoints || position < breakpoints_[static_cast<size_t>(segment + 1)].position);
+    };
+
+    // sequential playback: the hint's segment, or the one right after it
+    for (int segment = hint; segment >= -1 && segment < numBreakpoints && segment <= hint + 1; ++segment)
+    {
+      if (contains(segment))
+      {
+        return segment;
+      }
+    }
+
+    const auto next = std::upper_bound(breakpoints_.begin(), breakpoints_.end(), position,
+                                       [](juce::int64 lhs, const Breakpoint& rhs) { return lhs < rhs.position; });
+    return static_cast<int>(next - breakpoints_.begin()) - 1;
+  }
+
+  double AutomationLane::GetSlope(int segment) const noexcept
+  {
+    const Breakpoint& start = breakpoints_[static_cast<size_t>(segment)];
+    const Breakpoint& end = breakpoints_[static_cast<size_t>(segment + 1)];
+    return (static_cast<double>(end.value) - start.value) / static_cast<double>(end.position - start.position);
+  }
+
+// AutomationCompressor impl:
+  AutomationCompressor::AutomationCompressor(float tolerance)
+  : tolerance_(tolerance)
+  {
+    jassert(tolerance >= 0.f);
+  }
+
+  void AutomationCompressor::Add(juce::int64 position, float value)
+  {
+    if (lane_.GetNumBreakpoints() == 0)
+    {
+      lane_.Add(position, value);
+      return;
+    }
+
+    const AutomationLane::Breakpoint anchor = lane_.GetBreakpoints().back();
+    const juce::int64 lastPosition = bHasPending_ ? pending_.position : anchor.position;
+    jassert(position > lastPosition);
+    if (position <= lastPosition)
+    {
+      return;
+    }
+
+    const double distance = static_cast<double>(position - anchor.position);
+    const double lower = (static_cast<double>(value) - tolerance_ - anchor.value) / distance;
+    const double upper = (static_cast<double>(value) + tolerance_ - anchor.value) / distance;
+
+    if (!bHasPending_)
+    {
+      minSlope_ = lower;
+      maxSlope_ = upper;
+      pending_ = { position, value };
+      bHasPending_ = true;
+      return;
+    }
+
+    // still one line through every point so far?
+    const double minSlope = juce::jmax(minSlope_, lower);
+    const double maxSlope = juce::jmin(maxSlope_, upper);
+    if (minSlope <= maxSlope)
+    {
+      minSlope_ = minSlope;
+      maxSlope_ = maxSlope;
+      pending_ = { position, value };
+      return;
+    }
+
+    // no: end the segment at the previous point and start the next one from there
+    Flush();
+    Add(position, value);
+  }
+
+  void AutomationCompressor::Flush()
+  {
+    if (!bHasPending_)
+    {
+      return;
+    }
+
+    // the slope closest to the pending point's own, out of those that fit every point
+    const AutomationLane::Breakpoint anchor = lane_.GetBreakpoints().back();
+    const double distance = static_cast<double>(pending_.position - anchor.position);
+    const double slope = juce::jlimit(minSlope_, maxSlope_, (static_cast<double>(pending_.value) - anchor.value) / distance);
+
+    lane_.Add(pending_.position, static_cast<float>(anchor.value + slope * distance));
+    bHasPending_ = false;
+  }
+
+  AutomationLane AutomationCompressor::TakeLane()
+  {
+    Flush();
+
+    AutomationLane lane;
+    std::swap(lane, lane_);
+    return lane;
+  }
+
+// AutomationRecording impl:
+  int AutomationRecording::GetNumBreakpoints() const noexcept
+  {
+    int numBreakpoints = 0;
+    for (const AutomationLane& lane : lanes)
+    {
+      numBreakpoints += lane.GetNumBreakpoints();
+    }
+    return numBreakpoints;
+  }
+
+  size_t AutomationRecording::GetNumBytes() const noexcept
+  {
+    size_t numBytes = 0;
+    for (const AutomationLane& lane : lanes)
+    {
+      numBytes += lane.GetNumBytes();
+    }
+    return numBytes;
+  }
+
+  double AutomationRecording::GetCompressionRatio() const noexcept
+  {
+    const int numBreakpoints = GetNumBreakpoints();
+    return numBreakpoints > 0 ? static_cast<double>(numChanges) / numBreakpoints : 0.0;
+  }
+
+// AutomationRecorder impl:
+  AutomationRecorder::AutomationRecorder(const ParameterList& list, float tolerance)
+  : trackOfParameter_(static_cast<size_t>(list.GetNumParameters()), -1)
+  {
+    for (int i = 0; i < list.GetNumParameters(); ++i)
+    {
+      if (const auto* param = dynamic_cast<const ParamType<float>*>(&list.GetParameter(i)))
+      {
+        float laneTolerance = tolerance;
+        if (const auto& range = param->GetRange())
+        {
+          laneTolerance *= range->max - range->min;
+        }
+
+        trackOfParameter_[static_cast<size_t>(i)] = static_cast<int>(tracks_.size());
+        tracks_.push_back({ i, param, laneTolerance, AutomationCompressor(laneTolerance) });
+      }
+    }
+  }
+
+  void AutomationRecorder::Capture(juce::int64 position)
+  {
+    for (Track& track : tracks_)
+    {
+      Add(track, position, **track.param);
+    }
+  }
+
+  void AutomationRecorder::Record(int parameterIndex, juce::int64 position, float value)
+  {
+    const int track = juce::isPositiveAndBelow(parameterIndex, static_cast<int>(trackOfParameter_.size()))
+                    ? trackOfParameter_[static_cast<size_t>(parameterIndex)] : -1;
+    jassert(track >= 0); // not a float parameter of this list
+    if (track >= 0)
+    {
+      Add(tracks_[static_cast<size_t>(track)], position, value);
+    }
+  }
+
+  void AutomationRecorder::Add(Track& track, juce::int64 position, float value)
+  {
+    if (position <= track.lastPosition)
+    {
+      return;
+    }
+
+    if (track.lastPosition >= 0)
+    {
+      if (value == track.lastValue)
+      {
+        track.lastPosition = position; // (held, nothing to store yet)
+        return;
+      }
+
+      // the value was held up to here, so the segment towards the new value starts at the last capture
+      if (track.lastPosition > track.lastAdded)
+      {
+        track.compressor.Add(track.lastPosition, track.lastValue);
+      }
+    }
+
+    track.compressor.Add(position, value);
+    track.lastValue = value;
+    track.lastPosition = position;
+    track.lastAdded = position;
+    ++numChanges_;
+  }
+
+  AutomationRecording AutomationRecorder::Finish()
+  {
+    AutomationRecording recording;
+    recording.numChanges = numChanges_;
+
+    for (Track& track : tracks_)
+    {
+      recording.parameterIndices.push_back(track.parameterIndex);
+      recording.lanes.push_back(track.compressor.TakeLane());
+
+      track.lastPosition = -1;
+      track.lastAdded = -1;
+    }
+
+    numChanges_ = 0;
+    return recording;
+  }
+
+// AutomationPlayer impl:
+  AutomationPlayer::AutomationPlayer(const AutomationRecording& recording, ParameterList& list)
+  : recording_(recording)
+  , segmentHints_(recording.lanes.size(), -1)
+  {
+    jassert(recording.parameterIndices.size() == recording.lanes.size());
+
+    for (const int parameterIndex : recording.parameterIndices)
+    {
+      auto* param = dynamic_cast<ParamType<float>*>(&list.GetParameter(parameterIndex));
+      jassert(param != nullptr); // recorded from a different list?
+      params_.emplace_back(param);
+    }
+  }
+
+  void AutomationPlayer::Prepare(int maxBlockSize)
+  {
+    values_.SetSize(GetNumLanes(), maxBlockSize);
+  }
+
+  void AutomationPlayer::RenderBlock(juce::int64 startPosition, int numSamples)
+  {
+    jassert(numSamples <= values_.GetNumSamples()); // Prepare() first
+
+    for (int lane = 0; lane < GetNumLanes(); ++lane)
+    {
+      const AutomationLane& automation = recording_.lanes[static_cast<size_t>(lane)];
+      if (automation.GetNumBreakpoints() == 0 || numSamples <= 0)
+      {
+        continue;
+      }
+
+      float* values = values_.GetChannel(lane);
+      automation.RenderBlock(startPosition, values, numSamples, segmentHints_[static_cast<size_t>(lane)]);
+
+      const ParamHandle<float>& param = params_[static_cast<size_t>(lane)];
+      if (param && !param.IsEqualTo(values[0]))
+      {
+        param.Set(values[0]);
+      }
+    }
+  }
+
+} // namespace Haze
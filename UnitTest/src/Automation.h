@@ -0,0 +1,167 @@
+
+#pragma once
+
+#include "ParameterTypes.h"
+#include "AudioBlock.h"
+#include <vector>
+
+namespace Haze
+{
+  // automation for one float parameter, as piecewise-linear segments between breakpoints
+  // (linear in between, held before the first breakpoint and after the last)
+  class AutomationLane
+  {
+  public:
+    struct Breakpoint
+    {
+      juce::int64 position; // in samples
+      float value;
+    };
+
+    // appends a breakpoint (positions strictly increasing)
+    void Add(juce::int64 position, float value);
+
+    [[nodiscard]] int GetNumBreakpoints() const noexcept { return static_cast<int>(breakpoints_.size()); }
+    [[nodiscard]] const std::vector<Breakpoint>& GetBreakpoints() const noexcept { return breakpoints_; }
+    [[nodiscard]] size_t GetNumBytes() const noexcept { return breakpoints_.size() * sizeof(Breakpoint); }
+
+    // value at one position (binary search)
+    [[nodiscard]] float Evaluate(juce::int64 position) const noexcept;
+
+    // values for [startPosition, startPosition + numSamples) into dst, one juce::FloatVectorOperations ramp per segment.
+    // segmentHint remembers where the last block ended, so sequential playback never searches (any start value works)
+    void RenderBlock(juce::int64 startPosition, float* dst, int numSamples, int& segmentHint) const noexcept;
+
+  private:
+    // last breakpoint at or before position (-1 before the first), starting the scan from hint
+    [[nodiscard]] int FindSegment(juce::int64 position, int hint) const noexcept;
+
+    [[nodiscard]] double GetSlope(int segment) const noexcept;
+
+    std::vector<Breakpoint> breakpoints_;
+  }; // class AutomationLane
+
+
+  // online piecewise-linear compression of a stream of (position, value) points into an AutomationLane
+  //
+  // keeps the range of slopes that pass within tolerance of every point since the last breakpoint
+  // (the "swinging door"), and only writes a breakpoint once a point no longer fits it.
+  // every input point stays within tolerance of the lane, O(1) per point
+  class AutomationCompressor
+  {
+  public:
+    // ctor
+    explicit AutomationCompressor(float tolerance = 0.f);
+
+    // points in increasing position order
+    void Add(juce::int64 position, float value);
+
+    // writes the pending breakpoint, if any (more points may follow)
+    void Flush();
+
+    [[nodiscard]] const AutomationLane& GetLane() const noexcept { return lane_; }
+
+    // flushes and hands over the lane (the compressor starts over empty)
+    [[nodiscard]] AutomationLane TakeLane();
+
+  private:
+    AutomationLane lane_;
+    float tolerance_;
+
+    // last raw point, not written yet
+    AutomationLane::Breakpoint pending_ {};
+    bool bHasPending_ = false;
+
+    // slopes from the last breakpoint that keep every point since within tolerance
+    double minSlope_ = 0.0;
+    double maxSlope_ = 0.0;
+  }; // class AutomationCompressor
+
+
+  // compressed lanes for some of a ParameterList's float parameters
+  struct AutomationRecording
+  {
+    std::vector<int> parameterIndices; // ParameterList position of each lane
+    std::vector<AutomationLane> lanes;
+    juce::int64 numChanges = 0;        // value changes seen while recording
+
+    [[nodiscard]] int GetNumBreakpoints() const noexcept;
+    [[nodiscard]] size_t GetNumBytes() const noexcept;
+
+    // changes per stored breakpoint
+    [[nodiscard]] double GetCompressionRatio() const noexcept;
+  };
+
+
+  // records the float parameters of a ParameterList as compressed automation
+  //
+  // Capture() samples every float parameter (typically once per block, at the block's position) and only
+  // changed values reach the compressor, so a held value costs nothing until it moves again.
+  // tolerance is a fraction of each parameter's range (absolute for parameters w/o one).
+  // reads the list's storage directly: call it from the thread that writes the parameters
+  class AutomationRecorder
+  {
+  public:
+    // ctor
+    explicit AutomationRecorder(const ParameterList& list, float tolerance = 1.0e-3f);
+
+    // every float parameter that changed since the last capture gets a point at position
+    void Capture(juce::int64 position);
+
+    // one explicit point (i.e. a ParameterEvent, at its offset), parameterIndex = ParameterList position
+    // (one value per sample and parameter: later points at the same position are dropped)
+    void Record(int parameterIndex, juce::int64 position, float value);
+
+    [[nodiscard]] int GetNumLanes() const noexcept { return static_cast<int>(tracks_.size()); }
+    [[nodiscard]] juce::int64 GetNumChanges() const noexcept { return numChanges_; }
+
+    // ends the recording (the recorder starts over empty)
+    [[nodiscard]] AutomationRecording Finish();
+
+  private:
+    struct Track
+    {
+      int parameterIndex;
+      const ParamType<float>* param;
+      float tolerance;
+      AutomationCompressor compressor;
+      float lastValue = 0.f;
+      juce::int64 lastPosition = -1; // last capture/record
+      juce::int64 lastAdded = -1;    // last point the compressor got
+    };
+
+    void Add(Track& track, juce::int64 position, float value);
+
+    std::vector<Track> tracks_;
+    std::vector<int> trackOfParameter_; // ParameterList position -> tracks_ position (-1: not a float)
+    juce::int64 numChanges_ = 0;
+  }; // class AutomationRecorder
+
+
+  // plays an AutomationRecording back into the ParameterList it was recorded from, block by block
+  //
+  // RenderBlock() renders every lane for the block (per-sample values, see GetLaneValues) and
+  // sets each parameter to its value at the block's first sample, so smoothed readers follow it
+  class AutomationPlayer
+  {
+  public:
+    // ctor
+    AutomationPlayer(const AutomationRecording& recording, ParameterList& list);
+
+    // (message thread, allocates)
+    void Prepare(int maxBlockSize);
+
+    // (never allocates, numSamples <= maxBlockSize)
+    void RenderBlock(juce::int64 startPosition, int numSamples);
+
+    [[nodiscard]] int GetNumLanes() const noexcept { return static_cast<int>(params_.size()); }
+    [[nodiscard]] const float* GetLaneValues(int lane) const noexcept { return values_.GetChannel(lane); }
+
+  private:
+    const AutomationRecording& recording_;
+    std::vector<ParamHandle<float>> params_;
+    std::vector<int> segmentHints_;
+    AlignedAudioBuffer<float> values_; // (one channel per lane)
+  }; // class AutomationPlayer
+
+} // namespace Haze
@@ -0,0 +1,75 @@
+
+#include "Benchmark.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+// Measurement impl:
+  juce::var Measurement::ToVar() const
+  {
+    juce::DynamicObject::Ptr object = new juce::DynamicObject();
+    object->setProperty("suite", suite);
+    object->setProperty("name", name);
+    object->setProperty("iterations", numIterations);
+    object->setProperty("repetitions", numRepetitions);
+    object->setProperty("ns_min", minNs);
+    object->setProperty("ns_median", medianNs);
+    object->setProperty("ns_mean", meanNs);
+    object->setProperty("ns_stddev", stdDevNs);
+    object->setProperty("cycles_median", medianCycles);
+    return juce::var(object.get());
+  }
+
+  juce::String Measurement::ToString() const
+  {
+    return name + ": " + juce::String(medianNs, 2) + " ns (min " + juce::String(minNs, 2) + ", +/- " + juce::String(stdDevNs, 2) + "), "
+           + juce::String(medianCycles, 1) + " cycles";
+  }
+
+// BenchmarkReport impl:
+  BenchmarkReport& BenchmarkReport::Get()
+  {
+    static BenchmarkReport report;
+    return report;
+  }
+
+  void BenchmarkReport::Add(const Measurement& measurement)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    measurements_.push_back(measurement);
+  }
+
+  std::vector<Measurement> BenchmarkReport::GetMeasurements() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return measurements_;
+  }
+
+  juce::String BenchmarkReport::ToJson() const
+  {
+    juce::DynamicObject::Ptr machine = new juce::DynamicObject();
+    machine->setProperty("cpu", juce::SystemStats::getCpuModel());
+    machine->setProperty("num_cpus", juce::SystemStats::getNumCpus());
+    machine->setProperty("os", juce::SystemStats::getOperatingSystemName());
+
+    const MeasureOptions& defaults = MeasureOptions::Defaults();
+    juce::DynamicObject::Ptr options = new juce::DynamicObject();
+    options->setProperty("warmups", defaults.numWarmups);
+    options->setProperty("repetitions", defaults.numRepetitions);
+
+    juce::var results;
+    for (const Measurement& measurement : GetMeasurements())
+    {
+      results.append(measurement.ToVar());
+    }
+
+    juce::DynamicObject::Ptr report = new juce::DynamicObject();
+    report->setProperty("machine", juce::var(machine.get()));
+    report->setProperty("options", juce::var(options.get()));
+    report->setProperty("results", results);
+    return juce::JSON::toString(juce::var(report.get()));
+  }
+
+} // Benchmarks
+} // Haze
@@ -0,0 +1,220 @@
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <mutex>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+ #if defined(_MSC_VER)
+  #include <intrin.h>
+ #else
+  #include <x86intrin.h>
+ #endif
+#endif
+
+#if JUCE_LINUX
+ #include <malloc.h>
+ #include <unistd.h>
+#elif JUCE_MAC
+ #include <mach/mach.h>
+ #include <malloc/malloc.h>
+#endif
+
+namespace Haze
+{
+namespace Benchmarks
+{
+  // the juce::UnitTest category of every Benchmark_* suite: HazeBenchmarks (BenchmarkMain.cpp) runs the tests in it
+  constexpr const char* Category = "Benchmarks";
+
+  // keeps the optimizer from discarding a value we computed only to time it
+  template <typename T>
+  inline void DoNotOptimize(const T& value)
+  {
+   #if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+   #else
+    static_cast<void>(*reinterpret_cast<const volatile char*>(&value));
+   #endif
+  }
+
+  // resident set size of this process in bytes (0 where the platform isn't supported)
+  inline juce::int64 ResidentMemoryBytes()
+  {
+   #if JUCE_LINUX
+    long numPages = 0, numResident = 0;
+    if (std::FILE* statm = std::fopen("/proc/self/statm", "r"))
+    {
+      const int numRead = std::fscanf(statm, "%ld %ld", &numPages, &numResident);
+      std::fclose(statm);
+
+      if (numRead == 2)
+      {
+        return static_cast<juce::int64>(numResident) * sysconf(_SC_PAGESIZE);
+      }
+    }
+   #elif JUCE_MAC
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS)
+    {
+      return static_cast<juce::int64>(info.resident_size);
+    }
+   #endif
+
+    return 0;
+  }
+
+  // bytes the heap has handed out and not had back (0 where the platform isn't supported)
+  // (unlike the resident size, memory freed earlier and reused doesn't hide an allocation)
+  inline juce::int64 HeapBytesInUse()
+  {
+   #if JUCE_LINUX && defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    const struct mallinfo2 info = mallinfo2();
+    return static_cast<juce::int64>(info.uordblks + info.hblkhd);
+   #elif JUCE_MAC
+    malloc_statistics_t stats;
+    malloc_zone_statistics(nullptr, &stats);
+    return static_cast<juce::int64>(stats.size_in_use);
+   #else
+    return 0;
+   #endif
+  }
+
+  // free running cpu counter: the TSC on x86 (constant rate, so reference cycles rather than core cycles
+  // under turbo/throttling), the virtual counter on arm64, 0 where neither exists
+  inline juce::uint64 ReadCycleCounter() noexcept
+  {
+   #if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    return __rdtsc();
+   #elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+    juce::uint64 counter;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(counter));
+    return counter;
+   #else
+    return 0;
+   #endif
+  }
+
+
+  // how Measure() samples a piece of code
+  struct MeasureOptions
+  {
+    int numWarmups = 2;       // repetitions run and thrown away first (caches, branch predictors, lazy init)
+    int numRepetitions = 10;  // timed repetitions, each runs fn numIterations times
+    int numIterations = 1000;
+
+    // process-wide defaults (HazeBenchmarks sets them from its command line)
+    static MeasureOptions& Defaults()
+    {
+      static MeasureOptions defaults;
+      return defaults;
+    }
+
+    // the defaults w/ a different iteration count (heavier workloads run fewer iterations)
+    static MeasureOptions WithIterations(int numIterations)
+    {
+      MeasureOptions options = Defaults();
+      options.numIterations = numIterations;
+      return options;
+    }
+  };
+
+
+  // per-call statistics over the timed repetitions
+  struct Measurement
+  {
+    juce::String suite;
+    juce::String name;
+    int numIterations = 0;
+    int numRepetitions = 0;
+
+    double minNs = 0.0;
+    double medianNs = 0.0;
+    double meanNs = 0.0;
+    double stdDevNs = 0.0;
+    double medianCycles = 0.0; // (0 w/o a cycle counter)
+
+    [[nodiscard]] juce::var ToVar() const;
+    [[nodiscard]] juce::String ToString() const;
+  };
+
+
+  // every Measurement taken in this process, in order (thread safe)
+  class BenchmarkReport
+  {
+  public:
+    static BenchmarkReport& Get();
+
+    void Add(const Measurement& measurement);
+    [[nodiscard]] std::vector<Measurement> GetMeasurements() const;
+
+    // {"machine": {...}, "options": {...}, "results": [...]}
+    [[nodiscard]] juce::String ToJson() const;
+
+  private:
+    mutable std::mutex mutex_;
+    std::vector<Measurement> measurements_;
+  };
+
+
+  // times fn(iteration) numIterations times per repetition, after the warmup repetitions
+  template <typename Fn>
+  Measurement Measure(const juce::String& suite, const juce::String& name, const MeasureOptions& options, Fn&& fn)
+  {
+    jassert(options.numRepetitions > 0 && options.numIterations > 0);
+
+    std::vector<double> ns, cycles;
+    for (int repetition = -options.numWarmups; repetition < options.numRepetitions; ++repetition)
+    {
+      const juce::uint64 startCycles = ReadCycleCounter();
+      const juce::int64 startTicks = juce::Time::getHighResolutionTicks();
+      for (int i = 0; i < options.numIterations; ++i)
+      {
+        fn(i);
+      }
+      const juce::int64 endTicks = juce::Time::getHighResolutionTicks();
+      const juce::uint64 endCycles = ReadCycleCounter();
+
+      if (repetition >= 0)
+      {
+        ns.push_back(juce::Time::highResolutionTicksToSeconds(endTicks - startTicks) * 1.0e9 / options.numIterations);
+        cycles.push_back(static_cast<double>(endCycles - startCycles) / options.numIterations);
+      }
+    }
+
+    const auto median = [](std::vector<double> values)
+    {
+      std::sort(values.begin(), values.end());
+      const size_t mid = values.size() / 2;
+      return values.size() % 2 != 0 ? values[mid] : 0.5 * (values[mid - 1] + values[mid]);
+    };
+
+    Measurement result;
+    result.suite = suite;
+    result.name = name;
+    result.numIterations = options.numIterations;
+    result.numRepetitions = options.numRepetitions;
+    result.minNs = *std::min_element(ns.begin(), ns.end());
+    result.medianNs = median(ns);
+    result.medianCycles = median(cycles);
+
+    for (const double value : ns)
+    {
+      result.meanNs += value / static_cast<double>(ns.size());
+    }
+    for (const double value : ns)
+    {
+      result.stdDevNs += (value - result.meanNs) * (value - result.meanNs) / static_cast<double>(ns.size());
+    }
+    result.stdDevNs = std::sqrt(result.stdDevNs);
+
+    BenchmarkReport::Get().Add(result);
+    return result;
+  }
+
+} // Benchmarks
+} // Haze
@@ -0,0 +1,75 @@
+
+/*
+  ==============================================================================
+
+    HazeBenchmarks: performance regression suite
+
+    HazeBenchmarks [options]
+      --filter=<text>       only benchmarks whose name contains text
+      --warmups=<n>         untimed repetitions before measuring (default: 2)
+      --repetitions=<n>     timed repetitions per measurement (default: 10)
+      --json=<file>         also write every measurement as json
+      --list                print the benchmark names and exit
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "Benchmark.h"
+#include <iostream>
+
+int main(int argc, char* argv[])
+{
+  const juce::ArgumentList args(argc, argv);
+  const juce::String filter = args.getValueForOption("--filter");
+
+  juce::Array<juce::UnitTest*> benchmarks;
+  for (auto* test : juce::UnitTest::getAllTests())
+  {
+    if (test->getCategory() == Haze::Benchmarks::Category && test->getName().containsIgnoreCase(filter))
+    {
+      benchmarks.add(test);
+    }
+  }
+
+  if (args.containsOption("--list"))
+  {
+    for (auto* benchmark : benchmarks)
+    {
+      std::cout << benchmark->getName() << std::endl;
+    }
+    return 0;
+  }
+
+  Haze::Benchmarks::MeasureOptions& defaults = Haze::Benchmarks::MeasureOptions::Defaults();
+  if (args.containsOption("--warmups"))
+  {
+    defaults.numWarmups = juce::jmax(0, args.getValueForOption("--warmups").getIntValue());
+  }
+  if (args.containsOption("--repetitions"))
+  {
+    defaults.numRepetitions = juce::jmax(1, args.getValueForOption("--repetitions").getIntValue());
+  }
+
+  juce::UnitTestRunner runner;
+  runner.runTests(benchmarks);
+
+  int numFailures = 0;
+  for (int i = 0; i < runner.getNumResults(); ++i)
+  {
+    numFailures += runner.getResult(i)->failures;
+  }
+
+  if (args.containsOption("--json"))
+  {
+    const juce::File jsonFile = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--json"));
+    if (!jsonFile.replaceWithText(Haze::Benchmarks::BenchmarkReport::Get().ToJson()))
+    {
+      std::cerr << "HazeBenchmarks: can't write " << jsonFile.getFullPathName() << std::endl;
+      return 1;
+    }
+    std::cout << "measurements written to " << jsonFile.getFullPathName() << std::endl;
+  }
+
+  return numFailures == 0 ? 0 : 1;
+}
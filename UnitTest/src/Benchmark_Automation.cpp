@@ -0,0 +1,97 @@
+
+#include "Benchmark_Automation.h"
+#include "Automation.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  void AutomationBenchmark::runTest()
+  {
+    constexpr double SampleRate = 48000.0;
+    constexpr int CaptureBlockSize = 64;
+    constexpr int PlaybackBlockSize = 512;
+    constexpr juce::int64 NumSamples = static_cast<juce::int64>(SampleRate) * 60 * 60;
+
+    // four dense lanes, all moving on every captured block:
+    // a 0.5 Hz lfo, a slow sweep w/ a faster wobble on top, a random walk and 8th note steps at 120 bpm
+    ParameterList param_list;
+    param_list
+      .add(juce::Identifier("lfo"), 0.f, ParamRange<float>(-1.f, 1.f))
+      .add(juce::Identifier("sweep"), 0.f, ParamRange<float>(0.f, 1.f))
+      .add(juce::Identifier("walk"), 0.f, ParamRange<float>(-10.f, 10.f))
+      .add(juce::Identifier("steps"), 0.f, ParamRange<float>(0.f, 8.f))
+    ;
+
+    ParamHandle<float> lfo = param_list.GetHandle<float>("lfo");
+    ParamHandle<float> sweep = param_list.GetHandle<float>("sweep");
+    ParamHandle<float> walk = param_list.GetHandle<float>("walk");
+    ParamHandle<float> steps = param_list.GetHandle<float>("steps");
+
+    AutomationRecording recording;
+
+    beginTest("Record: one capture per " + juce::String(CaptureBlockSize) + " samples, tolerance 0.1% of range");
+    {
+      AutomationRecorder recorder(param_list);
+      juce::Random rng(1234);
+      float walkValue = 0.f;
+
+      juce::int64 captureTicks = 0;
+      for (juce::int64 position = 0; position < NumSamples; position += CaptureBlockSize)
+      {
+        const double seconds = static_cast<double>(position) / SampleRate;
+        walkValue = juce::jlimit(-10.f, 10.f, walkValue + (rng.nextFloat() - 0.5f) * 0.01f);
+
+        lfo.Set(static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * 0.5 * seconds)));
+        sweep.Set(static_cast<float>(std::fmod(seconds / 60.0, 1.0) + 0.01 * std::sin(juce::MathConstants<double>::twoPi * 7.0 * seconds)));
+        walk.Set(walkValue);
+        steps.Set(static_cast<float>(static_cast<juce::int64>(seconds * 4.0) % 8));
+
+        const juce::int64 start = juce::Time::getHighResolutionTicks();
+        recorder.Capture(position);
+        captureTicks += juce::Time::getHighResolutionTicks() - start;
+      }
+
+      const juce::int64 numChanges = recorder.GetNumChanges();
+      recording = recorder.Finish();
+
+      const double numCaptures = static_cast<double>(NumSamples / CaptureBlockSize);
+      const auto kilobytes = [](double numBytes) { return juce::String(numBytes / 1024.0, 1) + " KB"; };
+
+      logMessage("  " + juce::String(numChanges) + " changes -> " + juce::String(recording.GetNumBreakpoints()) + " breakpoints, ratio "
+                 + juce::String(recording.GetCompressionRatio(), 1) + ":1");
+      logMessage("  " + kilobytes(static_cast<double>(numChanges) * sizeof(AutomationLane::Breakpoint)) + " uncompressed -> "
+                 + kilobytes(static_cast<double>(recording.GetNumBytes())) + " compressed");
+      for (size_t lane = 0; lane < recording.lanes.size(); ++lane)
+      {
+        logMessage("    " + param_list.GetName(recording.parameterIndices[lane]).toString() + ": "
+                   + juce::String(recording.lanes[lane].GetNumBreakpoints()) + " breakpoints");
+      }
+      logMessage("  capture: " + juce::String(juce::Time::highResolutionTicksToSeconds(captureTicks) * 1.0e9 / numCaptures, 1) + " ns/capture (4 lanes)");
+
+      expectEquals(numChanges, recording.numChanges);
+      expect(recording.GetCompressionRatio() > 1.0);
+    }
+
+    beginTest("Playback: " + juce::String(PlaybackBlockSize) + " sample blocks over the whole hour");
+    {
+      AutomationPlayer player(recording, param_list);
+      player.Prepare(PlaybackBlockSize);
+
+      constexpr int NumBlocks = static_cast<int>(NumSamples / PlaybackBlockSize);
+      const Measurement measurement = Measure("Automation", "playback, 4 lanes x " + juce::String(PlaybackBlockSize) + " samples",
+                                              MeasureOptions::WithIterations(NumBlocks), [&](int block)
+      {
+        player.RenderBlock(static_cast<juce::int64>(block) * PlaybackBlockSize, PlaybackBlockSize);
+        DoNotOptimize(player.GetLaneValues(0)[0]);
+      });
+
+      logMessage("  " + measurement.ToString());
+      logMessage("  " + juce::String(measurement.medianNs / (4.0 * PlaybackBlockSize), 3) + " ns/sample/lane, "
+                 + juce::String(static_cast<double>(NumSamples) / SampleRate / (measurement.medianNs * NumBlocks * 1.0e-9), 0) + "x realtime");
+    }
+  }
+
+} // Benchmarks
+} // Haze
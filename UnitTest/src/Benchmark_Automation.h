@@ -0,0 +1,24 @@
+
+#pragma once
+
+#include "Benchmark.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  class AutomationBenchmark : public juce::UnitTest
+  {
+  public:
+    // ctor
+    AutomationBenchmark() : UnitTest("Automation, one hour of dense lanes", Category) {}
+
+    virtual void runTest() override final;
+
+  }; // AutomationBenchmark
+
+  static AutomationBenchmark AutomationLaneBenchmark; // static addition to the test array
+
+} // Benchmarks
+} // Haze
@@ -0,0 +1,95 @@
+
+#include "Benchmark_BinaryPreset.h"
+#include "BinaryPreset.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  void BinaryPresetBenchmark::runTest()
+  {
+    constexpr const char* Suite = "BinaryPreset";
+    constexpr int NumParams = 500;
+    constexpr int NumIterations = 200;
+
+    ParameterList param_list;
+    juce::Random rng(1234);
+    for (int i = 0; i < NumParams; ++i)
+    {
+      const juce::Identifier name("param_" + juce::String(i));
+      switch (i % 4)
+      {
+        case 0: param_list.add(name, rng.nextFloat()); break;
+        case 1: param_list.add(name, rng.nextInt(1000)); break;
+        case 2: param_list.add(name, rng.nextBool()); break;
+        default: param_list.add(name, rng.nextDouble()); break;
+      }
+    }
+
+    // report per format: encoded size, encode + decode throughput (MB/s of encoded data)
+    const auto report = [this](const juce::String& format, size_t numBytes, const Measurement& encode, const Measurement& decode)
+    {
+      const auto megabytesPerSecond = [numBytes](const Measurement& m) { return juce::String(static_cast<double>(numBytes) / m.medianNs * 1.0e3, 1) + " MB/s"; };
+      logMessage("  " + format + ": " + juce::String(static_cast<juce::int64>(numBytes)) + " bytes");
+      logMessage("  " + encode.ToString() + ", " + megabytesPerSecond(encode));
+      logMessage("  " + decode.ToString() + ", " + megabytesPerSecond(decode));
+    };
+
+    beginTest("500 parameters: size, encode and decode (decode includes applying to the list)");
+
+    // binary
+    {
+      juce::MemoryBlock block;
+      const Measurement encode = Measure(Suite, "binary encode", MeasureOptions::WithIterations(NumIterations), [&](int)
+      {
+        BinaryPreset::Encode(param_list, block);
+        DoNotOptimize(block.getData());
+      });
+
+      const Measurement decode = Measure(Suite, "binary decode", MeasureOptions::WithIterations(NumIterations), [&](int)
+      {
+        DoNotOptimize(BinaryPresetView(block).ApplyTo(param_list));
+      });
+
+      report("binary", block.getSize(), encode, decode);
+      expect(BinaryPresetView(block).ApplyTo(param_list) == NumParams);
+    }
+
+    // xml
+    {
+      juce::String xml;
+      const Measurement encode = Measure(Suite, "xml encode", MeasureOptions::WithIterations(NumIterations / 10), [&](int)
+      {
+        xml = param_list.GetStateAsTree().toXmlString();
+        DoNotOptimize(xml);
+      });
+
+      const Measurement decode = Measure(Suite, "xml decode", MeasureOptions::WithIterations(NumIterations / 10), [&](int)
+      {
+        param_list.RestoreFromTree(juce::ValueTree::fromXml(xml));
+      });
+
+      report("xml", xml.getNumBytesAsUTF8(), encode, decode);
+    }
+
+    // ValueTree::writeToStream
+    {
+      juce::MemoryBlock block;
+      const Measurement encode = Measure(Suite, "ValueTree stream encode", MeasureOptions::WithIterations(NumIterations), [&](int)
+      {
+        juce::MemoryOutputStream stream(block, false);
+        param_list.GetStateAsTree().writeToStream(stream);
+      });
+
+      const Measurement decode = Measure(Suite, "ValueTree stream decode", MeasureOptions::WithIterations(NumIterations), [&](int)
+      {
+        param_list.RestoreFromTree(juce::ValueTree::readFromData(block.getData(), block.getSize()));
+      });
+
+      report("ValueTree stream", block.getSize(), encode, decode);
+    }
+  }
+
+} // Benchmarks
+} // Haze
@@ -0,0 +1,24 @@
+
+#pragma once
+
+#include "Benchmark.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  class BinaryPresetBenchmark : public juce::UnitTest
+  {
+  public:
+    // ctor
+    BinaryPresetBenchmark() : UnitTest("Binary preset vs. XML vs. ValueTree stream", Category) {}
+
+    virtual void runTest() override final;
+
+  }; // BinaryPresetBenchmark
+
+  static BinaryPresetBenchmark PresetFormatBenchmark; // static addition to the test array
+
+} // Benchmarks
+} // Haze
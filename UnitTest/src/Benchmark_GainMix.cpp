@@ -0,0 +1,105 @@
+
+#include "Benchmark_GainMix.h"
+#include "GainMixProcessor.h"
+#include <type_traits>
+
+namespace Haze
+{
+namespace Benchmarks
+{
+  namespace
+  {
+    // what processors wrote before processBlock(): one smoother step and one multiply per sample
+    // (scalar reference for the vectorized kernel)
+    template <typename T>
+    void PerSampleGainMix(ParamSmoother& gain, ParamSmoother& mix, AudioBlockView<T> block)
+    {
+      for (int i = 0; i < block.GetNumSamples(); ++i)
+      {
+        const T factor = static_cast<T>(1.f + mix.GetNextValue() * (gain.GetNextValue() - 1.f));
+        for (int ch = 0; ch < block.GetNumChannels(); ++ch)
+        {
+          block.GetChannel(ch)[i] *= factor;
+        }
+      }
+    }
+  } // namespace
+
+  void GainMixBenchmark::runTest()
+  {
+    constexpr const char* Suite = "GainMix";
+    constexpr double SampleRate = 48000.0;
+    constexpr int NumChannels = 2;
+    constexpr int SamplesPerRun = 1 << 18;
+
+    const auto run = [&](auto sampleType)
+    {
+      using T = decltype(sampleType);
+      const juce::String typeName = std::is_same_v<T, float> ? "float" : "double";
+
+      for (int blockSize = 32; blockSize <= 4096; blockSize *= 2)
+      {
+        const int numBlocks = SamplesPerRun / blockSize;
+        const juce::String size = typeName + ", " + juce::String(blockSize) + " samples";
+
+        AlignedAudioBuffer<T> buffer(NumChannels, blockSize);
+        for (int ch = 0; ch < NumChannels; ++ch)
+        {
+          juce::FloatVectorOperations::fill(buffer.GetChannel(ch), static_cast<T>(0.25), blockSize);
+        }
+
+        GainMixProcessor processor;
+        ParameterList& params = processor.GetParameterList();
+        processor.prepare({ SampleRate, blockSize, NumChannels });
+
+        // (gain alternates between two values that multiply to 1, so the buffer stays put)
+        *params[GainMixProcessor::Gain] = 1.25f;
+        *params[GainMixProcessor::Mix] = 1.f;
+        processor.processBlock(buffer.GetView(), {});
+        processor.exec(); // (let the ramp settle)
+        processor.exec();
+
+        const Measurement settled = Measure(Suite, "processBlock settled, " + size, MeasureOptions::WithIterations(numBlocks), [&](int)
+        {
+          processor.processBlock(buffer.GetView(), {});
+          DoNotOptimize(buffer.GetChannel(0)[0]);
+        });
+
+        // a new gain and mix every block, so every block is mid-ramp
+        const Measurement ramping = Measure(Suite, "processBlock ramping, " + size, MeasureOptions::WithIterations(numBlocks), [&](int i)
+        {
+          *params[GainMixProcessor::Gain] = (i & 1) != 0 ? 1.25f : 0.8f;
+          *params[GainMixProcessor::Mix] = (i & 1) != 0 ? 1.f : 0.9f;
+          processor.processBlock(buffer.GetView(), {});
+          DoNotOptimize(buffer.GetChannel(0)[0]);
+        });
+
+        ParamSmoother gain(ParamSmoother::Ramp::Linear, 1.f);
+        ParamSmoother mix(ParamSmoother::Ramp::Linear, 1.f);
+        gain.Prepare(SampleRate, GainMixProcessor::RampSeconds);
+        mix.Prepare(SampleRate, GainMixProcessor::RampSeconds);
+
+        const Measurement perSampleLoop = Measure(Suite, "per-sample loop, " + size, MeasureOptions::WithIterations(numBlocks), [&](int i)
+        {
+          gain.SetTarget((i & 1) != 0 ? 1.25f : 0.8f);
+          mix.SetTarget((i & 1) != 0 ? 1.f : 0.9f);
+          PerSampleGainMix(gain, mix, buffer.GetView());
+          DoNotOptimize(buffer.GetChannel(0)[0]);
+        });
+
+        const auto perSample = [&](const Measurement& m) { return " (" + juce::String(m.medianNs / (blockSize * NumChannels), 3) + " ns/sample)"; };
+        logMessage("  " + settled.ToString() + perSample(settled));
+        logMessage("  " + ramping.ToString() + perSample(ramping));
+        logMessage("  " + perSampleLoop.ToString() + perSample(perSampleLoop));
+      }
+    };
+
+    beginTest("float, " + juce::String(NumChannels) + " channels");
+    run(float {});
+
+    beginTest("double, " + juce::String(NumChannels) + " channels");
+    run(double {});
+  }
+
+} // Benchmarks
+} // Haze
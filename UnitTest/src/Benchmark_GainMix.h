@@ -0,0 +1,24 @@
+
+#pragma once
+
+#include "Benchmark.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  class GainMixBenchmark : public juce::UnitTest
+  {
+  public:
+    // ctor
+    GainMixBenchmark() : UnitTest("Gain/mix processor, 32..4096 sample blocks", Category) {}
+
+    virtual void runTest() override final;
+
+  }; // GainMixBenchmark
+
+  static GainMixBenchmark BlockGainBenchmark; // static addition to the test array
+
+} // Benchmarks
+} // Haze
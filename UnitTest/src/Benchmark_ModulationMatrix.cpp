@@ -0,0 +1,126 @@
+
+#include "Benchmark_ModulationMatrix.h"
+#include "ModulationMatrix.h"
+#include <cmath>
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  void ModulationMatrixBenchmark::runTest()
+  {
+    constexpr int NumSources = 64;
+    constexpr int NumTargets = 256;
+    constexpr int RoutesPerTarget = 4; // (sparse: a typical patch)
+    constexpr int BlockSize = 64;
+    constexpr double SampleRate = 48000.0;
+
+    ParameterList param_list;
+    ParameterList modulated_list; // (per-parameter path: where the modulated values are written)
+    for (int i = 0; i < NumTargets; ++i)
+    {
+      const juce::Identifier name("param_" + juce::String(i));
+      param_list.add(name, 0.5f, ParamRange<float>(0.f, 1.f));
+      modulated_list.add(name, 0.5f, ParamRange<float>(0.f, 1.f));
+    }
+
+    ModulationMatrix sparse(param_list, NumSources);
+    ModulationMatrix dense(param_list, NumSources);
+    for (int t = 0; t < NumTargets; ++t)
+    {
+      const juce::Identifier& name = param_list.GetName(t);
+      sparse.AddTarget(name);
+      dense.AddTarget(name);
+    }
+
+    for (int t = 0; t < NumTargets; ++t)
+    {
+      for (int r = 0; r < RoutesPerTarget; ++r)
+      {
+        sparse.SetDepth((t * 7 + r * 13) % NumSources, t, 0.1f);
+      }
+      for (int s = 0; s < NumSources; ++s)
+      {
+        dense.SetDepth(s, t, 0.01f);
+      }
+    }
+
+    // sources: one block of 64 lfos at different rates (rendered once, the cost under test is the matrix)
+    std::vector<std::vector<float>> lfos(NumSources, std::vector<float>(BlockSize));
+    for (int s = 0; s < NumSources; ++s)
+    {
+      for (int i = 0; i < BlockSize; ++i)
+      {
+        lfos[static_cast<size_t>(s)][static_cast<size_t>(i)] = std::sin(juce::MathConstants<float>::twoPi * static_cast<float>((s + 1) * i) / (8.f * BlockSize));
+      }
+    }
+
+    for (ModulationMatrix* matrix : { &sparse, &dense })
+    {
+      matrix->Prepare(BlockSize);
+      for (int s = 0; s < NumSources; ++s)
+      {
+        std::copy(lfos[static_cast<size_t>(s)].begin(), lfos[static_cast<size_t>(s)].end(), matrix->GetSourceBuffer(s));
+      }
+    }
+
+    const double blockNs = 1.0e9 * BlockSize / SampleRate;
+    const auto report = [&](const Measurement& measurement, int numRoutes)
+    {
+      logMessage("  " + measurement.ToString());
+      logMessage("  " + juce::String(numRoutes) + " routes: " + juce::String(measurement.medianNs / (static_cast<double>(numRoutes) * BlockSize), 2)
+                 + " ns/route/sample, " + juce::String(100.0 * measurement.medianNs / blockNs, 2) + "% of realtime at 48 kHz");
+    };
+
+    beginTest("Per parameter and sample: Get<float>() / operator=");
+    {
+      const Measurement measurement = Measure("ModulationMatrix", "per-parameter, " + juce::String(sparse.GetNumRoutes()) + " routes, per block",
+                                              MeasureOptions::WithIterations(10), [&](int)
+      {
+        for (int i = 0; i < BlockSize; ++i)
+        {
+          for (int t = 0; t < NumTargets; ++t)
+          {
+            float value = param_list.GetParameter(t).Get<float>();
+            for (int r = 0; r < RoutesPerTarget; ++r)
+            {
+              value += 0.1f * lfos[static_cast<size_t>((t * 7 + r * 13) % NumSources)][static_cast<size_t>(i)];
+            }
+            modulated_list.GetParameter(t) = value;
+          }
+        }
+        DoNotOptimize(modulated_list.GetParameter(0).Get<float>());
+      });
+      report(measurement, sparse.GetNumRoutes());
+    }
+
+    beginTest("ModulationMatrix, sparse (" + juce::String(RoutesPerTarget) + " routes per target)");
+    {
+      const Measurement measurement = Measure("ModulationMatrix", "matrix, " + juce::String(sparse.GetNumRoutes()) + " routes, per block",
+                                              MeasureOptions::WithIterations(100), [&](int)
+      {
+        sparse.RenderBlock(BlockSize);
+        DoNotOptimize(sparse.GetTargetValues(0)[0]);
+      });
+      report(measurement, sparse.GetNumRoutes());
+    }
+
+    beginTest("ModulationMatrix, dense (every source to every target)");
+    {
+      const Measurement measurement = Measure("ModulationMatrix", "matrix, " + juce::String(dense.GetNumRoutes()) + " routes, per block",
+                                              MeasureOptions::WithIterations(20), [&](int)
+      {
+        dense.RenderBlock(BlockSize);
+        DoNotOptimize(dense.GetTargetValues(0)[0]);
+      });
+      report(measurement, dense.GetNumRoutes());
+      expectEquals(dense.GetNumRoutes(), NumSources * NumTargets);
+    }
+
+    // the matrix leaves the list alone
+    expectEquals(param_list.GetParameter(0).Get<float>(), 0.5f);
+  }
+
+} // Benchmarks
+} // Haze
@@ -0,0 +1,24 @@
+
+#pragma once
+
+#include "Benchmark.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  class ModulationMatrixBenchmark : public juce::UnitTest
+  {
+  public:
+    // ctor
+    ModulationMatrixBenchmark() : UnitTest("Modulation matrix, 64 sources x 256 targets", Category) {}
+
+    virtual void runTest() override final;
+
+  }; // ModulationMatrixBenchmark
+
+  static ModulationMatrixBenchmark ModMatrixBenchmark; // static addition to the test array
+
+} // Benchmarks
+} // Haze
@@ -0,0 +1,93 @@
+
+#include "Benchmark_ParameterBank.h"
+#include "ParameterBank.h"
+#include <numeric>
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  void ParameterBankBenchmark::runTest()
+  {
+    constexpr const char* Suite = "ParameterBank";
+    constexpr int NumParams = 1000;
+    constexpr int NumSweeps = 2000;
+
+    ParameterList param_list;
+    for (int i = 0; i < NumParams; ++i)
+    {
+      param_list.add(juce::Identifier("param_" + juce::String(i)), static_cast<float>(i));
+    }
+
+    ParameterBank bank = ParameterBank::FromList(param_list);
+
+    std::vector<ParamHandle<float>> handles;
+    for (int i = 0; i < NumParams; ++i)
+    {
+      handles.push_back(param_list.GetHandle<float>(param_list.GetName(i)));
+    }
+
+    beginTest("Sum every float parameter (1000 parameters)");
+    {
+      float sum = 0.f;
+
+      const Measurement list = Measure(Suite, "sum 1000 floats: ParameterList (Get<float>)", MeasureOptions::WithIterations(NumSweeps), [&](int)
+      {
+        for (int i = 0; i < NumParams; ++i)
+        {
+          sum += param_list.GetParameter(i).Get<float>();
+        }
+        DoNotOptimize(sum);
+      });
+
+      const Measurement handle = Measure(Suite, "sum 1000 floats: ParameterList (ParamHandle)", MeasureOptions::WithIterations(NumSweeps), [&](int)
+      {
+        for (const auto& handle : handles)
+        {
+          sum += handle.Get();
+        }
+        DoNotOptimize(sum);
+      });
+
+      const auto& floats = bank.GetColumn<float>();
+      const Measurement column = Measure(Suite, "sum 1000 floats: ParameterBank (float column)", MeasureOptions::WithIterations(NumSweeps), [&](int)
+      {
+        sum += std::accumulate(floats.begin(), floats.end(), 0.f);
+        DoNotOptimize(sum);
+      });
+
+      for (const Measurement* measurement : { &list, &handle, &column })
+      {
+        logMessage("  " + measurement->ToString() + " (" + juce::String(measurement->medianNs / NumParams, 3) + " ns/parameter)");
+      }
+    }
+
+    beginTest("Snapshot every float parameter (1000 parameters)");
+    {
+      std::vector<float> snapshot(NumParams);
+
+      const Measurement handle = Measure(Suite, "snapshot 1000 floats: ParameterList (ParamHandle)", MeasureOptions::WithIterations(NumSweeps), [&](int)
+      {
+        for (size_t i = 0; i < handles.size(); ++i)
+        {
+          snapshot[i] = handles[i].Get();
+        }
+        DoNotOptimize(snapshot[0]);
+      });
+
+      const auto& floats = bank.GetColumn<float>();
+      const Measurement column = Measure(Suite, "snapshot 1000 floats: ParameterBank (float column)", MeasureOptions::WithIterations(NumSweeps), [&](int)
+      {
+        juce::FloatVectorOperations::copy(snapshot.data(), floats.data(), floats.size());
+        DoNotOptimize(snapshot[0]);
+      });
+
+      logMessage("  " + handle.ToString());
+      logMessage("  " + column.ToString());
+      expect(snapshot[NumParams - 1] == static_cast<float>(NumParams - 1));
+    }
+  }
+
+} // Benchmarks
+} // Haze
@@ -0,0 +1,24 @@
+
+#pragma once
+
+#include "Benchmark.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  class ParameterBankBenchmark : public juce::UnitTest
+  {
+  public:
+    // ctor
+    ParameterBankBenchmark() : UnitTest("ParameterList vs. ParameterBank iteration", Category) {}
+
+    virtual void runTest() override final;
+
+  }; // ParameterBankBenchmark
+
+  static ParameterBankBenchmark BankBenchmark; // static addition to the test array
+
+} // Benchmarks
+} // Haze
@@ -0,0 +1,121 @@
+
+#include "Benchmark_ParameterControls.h"
+#include "ParameterControls.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  void ParameterControlsBenchmark::runTest()
+  {
+    constexpr int NumParams = 2000;
+    constexpr int RowHeight = ParameterListView::DefaultRowHeight;
+    constexpr int EditorWidth = 600;
+    constexpr int EditorHeight = 800;
+
+    // (HazeBenchmarks is a console app: components need the message manager + fonts)
+    const juce::ScopedJuceInitialiser_GUI gui;
+
+    // a realistic mix: knobs, sliders, log knobs, toggles and number boxes
+    ParameterList param_list;
+    for (int i = 0; i < NumParams; ++i)
+    {
+      const juce::Identifier name("param_" + juce::String(i));
+      switch (i % 5)
+      {
+        case 0: param_list.add(name, 0.5f, ParamRange<float>(0.f, 1.f), {"Knob"}); break;
+        case 1: param_list.add(name, 0.5f, ParamRange<float>(0.f, 1.f), {"Slider", "", "", /*bPreferSliderOverKnob*/true}); break;
+        case 2: param_list.add(name, 1000.f, ParamRange<float>(20.f, 20000.f), {"Freq", "", "Hz", false, /*bIsLogarithmic*/true}); break;
+        case 3: param_list.add(name, true); break;
+        default: param_list.add(name, int { i }); break;
+      }
+    }
+
+    const auto megabytes = [](juce::int64 numBytes) { return juce::String(static_cast<double>(numBytes) / (1024.0 * 1024.0), 2) + " MB"; };
+
+    // heap taken by one open editor, sampled before the timed runs below build and free it over and over
+    // (one control is built first, so state shared by all controls (fonts, look and feel) isn't counted)
+    param_list.CreateComponent(0).reset();
+    const auto heapBytes = [](auto&& openEditor)
+    {
+      const juce::int64 before = HeapBytesInUse();
+      const auto editor = openEditor();
+      return HeapBytesInUse() - before;
+    };
+
+    const juce::int64 eagerBytes = heapBytes([&]
+    {
+      std::vector<std::unique_ptr<ParameterControl>> controls;
+      for (int i = 0; i < NumParams; ++i)
+      {
+        controls.push_back(param_list.CreateComponent(i));
+        controls.back()->setBounds(0, i * RowHeight, EditorWidth, RowHeight);
+      }
+      return controls;
+    });
+
+    const juce::int64 virtualizedBytes = heapBytes([&]
+    {
+      auto view = std::make_unique<ParameterListView>(param_list);
+      view->setSize(EditorWidth, EditorHeight);
+      return view;
+    });
+
+    beginTest("Eager: every control built and laid out");
+    {
+      const Measurement measurement = Measure("ParameterControls", "eager open, " + juce::String(NumParams) + " parameters",
+                                              MeasureOptions::WithIterations(1), [&](int)
+      {
+        juce::Component editor;
+        editor.setSize(EditorWidth, NumParams * RowHeight);
+        std::vector<std::unique_ptr<ParameterControl>> controls;
+        for (int i = 0; i < NumParams; ++i)
+        {
+          controls.push_back(param_list.CreateComponent(i));
+          editor.addAndMakeVisible(*controls.back());
+          controls.back()->setBounds(0, i * RowHeight, EditorWidth, RowHeight);
+        }
+        DoNotOptimize(editor.getNumChildComponents());
+      });
+
+      logMessage("  " + measurement.ToString());
+      if (eagerBytes > 0)
+      {
+        logMessage("  " + juce::String(NumParams) + " controls, " + megabytes(eagerBytes) + " heap");
+      }
+    }
+
+    beginTest("Virtualized: ParameterListView, " + juce::String(EditorHeight / RowHeight) + " rows on screen");
+    {
+      const Measurement measurement = Measure("ParameterControls", "virtualized open, " + juce::String(NumParams) + " parameters",
+                                              MeasureOptions::WithIterations(1), [&](int)
+      {
+        ParameterListView view(param_list);
+        view.setSize(EditorWidth, EditorHeight);
+        DoNotOptimize(view.GetNumControlsCreated());
+      });
+
+      ParameterListView view(param_list);
+      view.setSize(EditorWidth, EditorHeight);
+
+      logMessage("  " + measurement.ToString());
+      if (virtualizedBytes > 0)
+      {
+        logMessage("  " + juce::String(view.GetNumLiveControls()) + " controls, " + megabytes(virtualizedBytes) + " heap");
+      }
+
+      // scrolling through everything, one row at a time
+      const Measurement scroll = Measure("ParameterControls", "virtualized scroll, per row", MeasureOptions::WithIterations(NumParams), [&](int row)
+      {
+        view.GetListBox().scrollToEnsureRowIsOnscreen(row);
+      });
+
+      logMessage("  " + scroll.ToString());
+      logMessage("  " + juce::String(view.GetNumControlsCreated()) + " controls built in total while scrolling");
+      expect(view.GetNumLiveControls() < NumParams / 10);
+    }
+  }
+
+} // Benchmarks
+} // Haze
@@ -0,0 +1,24 @@
+
+#pragma once
+
+#include "Benchmark.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  class ParameterControlsBenchmark : public juce::UnitTest
+  {
+  public:
+    // ctor
+    ParameterControlsBenchmark() : UnitTest("Editor open, 2000 parameters", Category) {}
+
+    virtual void runTest() override final;
+
+  }; // ParameterControlsBenchmark
+
+  static ParameterControlsBenchmark ControlsBenchmark; // static addition to the test array
+
+} // Benchmarks
+} // Haze
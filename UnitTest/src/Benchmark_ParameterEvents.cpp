@@ -0,0 +1,64 @@
+
+#include "Benchmark_ParameterEvents.h"
+#include "GainMixProcessor.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  void ParameterEventsBenchmark::runTest()
+  {
+    constexpr const char* Suite = "ParameterEvents";
+    constexpr double SampleRate = 48000.0;
+    constexpr int NumChannels = 2;
+    constexpr int BlockSize = 512;
+
+    const auto log = [this](const Measurement& measurement) { logMessage("  " + measurement.ToString()); };
+
+    for (const int numEvents : { 0, 10, 1000 })
+    {
+      beginTest(juce::String(numEvents) + " events per " + juce::String(BlockSize) + " sample block");
+
+      // evenly spread over the block, alternating between two gains (every event starts a new ramp)
+      const auto queueEvents = [numEvents](ParameterEventQueue& queue, int block)
+      {
+        for (int i = 0; i < numEvents; ++i)
+        {
+          const float gain = ((block + i) & 1) != 0 ? 1.25f : 0.8f;
+          queue.Add(i * BlockSize / numEvents, GainMixProcessor::GainIndex, gain);
+        }
+      };
+
+      // the queue alone: Add() + Dispatch() w/ empty callbacks
+      ParameterEventQueue queue;
+      int numSubBlocks = 0;
+      log(Measure(Suite, "queue + dispatch, " + juce::String(numEvents) + " events", MeasureOptions::WithIterations(10000), [&](int block)
+      {
+        queueEvents(queue, block);
+        queue.Dispatch(BlockSize, [](const ParameterEvent&) {}, [&numSubBlocks](int, int) { ++numSubBlocks; });
+        DoNotOptimize(numSubBlocks);
+      }));
+
+      // a whole GainMixProcessor block, sub-blocks and ramps included
+      AlignedAudioBuffer<float> buffer(NumChannels, BlockSize);
+      for (int ch = 0; ch < NumChannels; ++ch)
+      {
+        juce::FloatVectorOperations::fill(buffer.GetChannel(ch), 0.25f, BlockSize);
+      }
+
+      GainMixProcessor processor;
+      processor.prepare({ SampleRate, BlockSize, NumChannels });
+      ParameterEventQueue& events = *processor.getParameterEvents();
+
+      log(Measure(Suite, "GainMixProcessor block, " + juce::String(numEvents) + " events", MeasureOptions::WithIterations(10000), [&](int block)
+      {
+        queueEvents(events, block);
+        processor.processBlock(buffer.GetView(), {});
+        DoNotOptimize(buffer.GetChannel(0)[0]);
+      }));
+    }
+  }
+
+} // Benchmarks
+} // Haze
@@ -0,0 +1,24 @@
+
+#pragma once
+
+#include "Benchmark.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  class ParameterEventsBenchmark : public juce::UnitTest
+  {
+  public:
+    // ctor
+    ParameterEventsBenchmark() : UnitTest("Parameter events, 0..1000 per block", Category) {}
+
+    virtual void runTest() override final;
+
+  }; // ParameterEventsBenchmark
+
+  static ParameterEventsBenchmark EventBenchmark; // static addition to the test array
+
+} // Benchmarks
+} // Haze
@@ -0,0 +1,71 @@
+
+#include "Benchmark_ParameterFeedback.h"
+#include "ParameterFeedback.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  void ParameterFeedbackBenchmark::runTest()
+  {
+    constexpr const char* Suite = "ParameterFeedback";
+    constexpr int NumParams = 500;
+    constexpr int FifoSize = 4096;
+
+    ParameterList param_list;
+    for (int i = 0; i < NumParams; ++i)
+    {
+      param_list.add(juce::Identifier("meter_" + juce::String(i)), 0.f);
+    }
+
+    juce::ValueTree paramListTree = param_list.GetStateAsTree();
+    param_list.SyncToTree(paramListTree);
+
+    beginTest("Audio side: Push()");
+    {
+      // (a fifo big enough for every push of the measurement, warmups included: nothing is dropped or drained)
+      const MeasureOptions options = MeasureOptions::WithIterations(20000);
+      ParameterFeedback feedback(param_list, paramListTree, (options.numWarmups + options.numRepetitions) * options.numIterations + 1);
+
+      const Measurement push = Measure(Suite, "Push()", options, [&](int i)
+      {
+        feedback.Push(i % NumParams, static_cast<double>(i));
+      });
+
+      logMessage("  " + push.ToString() + ", " + juce::String(1.0e3 / push.medianNs, 2) + " M pushes/s");
+      expect(feedback.GetNumDropped() == 0);
+    }
+
+    beginTest("Message side: drain cost at 10k updates/s");
+    {
+      // one timer tick of a simulated second: 10k updates spread over a 30 Hz timer
+      constexpr int UpdatesPerSecond = 10000;
+      constexpr int TimerHz = 30;
+      constexpr int UpdatesPerTick = UpdatesPerSecond / TimerHz;
+
+      ParameterFeedback feedback(param_list, paramListTree, FifoSize);
+      juce::Random rng(1234);
+      juce::int64 numWritten = 0;
+      juce::int64 numTicks = 0;
+
+      const Measurement tick = Measure(Suite, "timer tick: " + juce::String(UpdatesPerTick) + " x Push() + Drain()", MeasureOptions::WithIterations(TimerHz), [&](int)
+      {
+        for (int i = 0; i < UpdatesPerTick; ++i)
+        {
+          feedback.Push(rng.nextInt(NumParams), rng.nextDouble());
+        }
+        numWritten += feedback.Drain();
+        ++numTicks;
+      });
+
+      logMessage("  " + tick.ToString());
+      logMessage("  " + juce::String(UpdatesPerTick) + " updates per tick coalesced into " + juce::String(static_cast<double>(numWritten) / static_cast<double>(numTicks), 1)
+                 + " tree writes, " + juce::String(tick.medianNs * TimerHz * 1.0e-6, 3) + " ms/s of message thread time");
+      expect(numWritten <= numTicks * UpdatesPerTick);
+      expect(feedback.GetNumDropped() == 0);
+    }
+  }
+
+} // Benchmarks
+} // Haze
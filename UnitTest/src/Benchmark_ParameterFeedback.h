@@ -0,0 +1,24 @@
+
+#pragma once
+
+#include "Benchmark.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  class ParameterFeedbackBenchmark : public juce::UnitTest
+  {
+  public:
+    // ctor
+    ParameterFeedbackBenchmark() : UnitTest("ParameterFeedback push/drain", Category) {}
+
+    virtual void runTest() override final;
+
+  }; // ParameterFeedbackBenchmark
+
+  static ParameterFeedbackBenchmark FeedbackBenchmark; // static addition to the test array
+
+} // Benchmarks
+} // Haze
@@ -0,0 +1,119 @@
+
+#include "Benchmark_ParameterGroups.h"
+#include "ParameterTypes.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  void ParameterGroupsBenchmark::runTest()
+  {
+    constexpr const char* Suite = "ParameterGroups";
+    constexpr int NumGroups = 50;
+    constexpr int ParamsPerGroup = 20;
+
+    // the same 1000 parameters, flat and one group per eq band
+    ParameterList flat_list;
+    ParameterList grouped_list;
+    for (int group = 0; group < NumGroups; ++group)
+    {
+      grouped_list.BeginGroup(juce::Identifier("band_" + juce::String(group)));
+      for (int i = 0; i < ParamsPerGroup; ++i)
+      {
+        const juce::Identifier name("band_" + juce::String(group) + "_param_" + juce::String(i));
+        flat_list.add(name, 0.f);
+        grouped_list.add(name, 0.f);
+      }
+      grouped_list.EndGroup();
+    }
+
+    // one ui page per band, listening to what it shows: the whole tree when flat, its band's subtree when grouped
+    struct PageListener : public juce::ValueTree::Listener
+    {
+      void valueTreePropertyChanged(juce::ValueTree&, const juce::Identifier&) override { ++numNotifications; }
+      int numNotifications = 0;
+    };
+
+    const auto measure = [&](ParameterList& list, const juce::String& layout)
+    {
+      juce::ValueTree tree = list.GetStateAsTree();
+
+      // (attach + detach, SyncToTree() alone would pile up listeners)
+      const Measurement sync = Measure(Suite, layout + ": SyncToTree + DesyncFromTree", MeasureOptions::WithIterations(100), [&](int)
+      {
+        list.SyncToTree(tree);
+        list.DesyncFromTree(tree);
+      });
+      logMessage("  " + sync.ToString());
+
+      list.SyncToTree(tree);
+
+      std::vector<PageListener> pages(NumGroups);
+      std::vector<juce::ValueTree> pageTrees;
+      for (int group = 0; group < NumGroups; ++group)
+      {
+        pageTrees.push_back(list.GetGroupTree(tree, juce::jmin(group + 1, list.GetNumGroups() - 1))); // (flat: the root)
+        pageTrees.back().addListener(&pages[static_cast<size_t>(group)]);
+      }
+
+      // a preset for one band, written into the synced tree (alternating values, so every write is a change)
+      const int band = NumGroups / 2;
+      const std::vector<int>& bandParams = grouped_list.GetGroupParameters(band + 1);
+      juce::ValueTree bandTree = list.GetGroupTree(tree, juce::jmin(band + 1, list.GetNumGroups() - 1));
+
+      const Measurement preset = Measure(Suite, layout + ": one band preset into the synced tree", MeasureOptions::WithIterations(100), [&](int iteration)
+      {
+        for (const int index : bandParams)
+        {
+          bandTree.setProperty(list.GetName(index), static_cast<float>(iteration & 1), nullptr);
+        }
+      });
+
+      int numNotifications = 0;
+      int numPagesNotified = 0;
+      for (size_t page = 0; page < pages.size(); ++page)
+      {
+        pageTrees[page].removeListener(&pages[page]);
+        numNotifications += pages[page].numNotifications;
+        numPagesNotified += pages[page].numNotifications > 0 ? 1 : 0;
+      }
+      list.DesyncFromTree(tree);
+
+      const int numPresets = (MeasureOptions::Defaults().numWarmups + preset.numRepetitions) * preset.numIterations;
+      logMessage("  " + preset.ToString());
+      logMessage("  " + juce::String(numPagesNotified) + " pages notified, " + juce::String(numNotifications / numPresets)
+                 + " page notifications per band preset (" + juce::String(ParamsPerGroup) + " parameters)");
+      expectEquals(list[list.GetName(bandParams.front())]->Get<float>(), static_cast<float>((preset.numIterations - 1) & 1));
+      return numPagesNotified;
+    };
+
+    beginTest("Flat: one Parameter_List tree");
+    {
+      expectEquals(measure(flat_list, "flat"), NumGroups);
+    }
+
+    beginTest("Grouped: one subtree per band");
+    {
+      expectEquals(measure(grouped_list, "grouped"), 1);
+    }
+
+    beginTest("Band preset w/o a tree: RestoreGroup vs. RestoreFromTree");
+    {
+      const juce::ValueTree state = grouped_list.GetStateAsTree();
+      const juce::ValueTree bandState = grouped_list.GetGroupStateAsTree(NumGroups / 2 + 1);
+
+      logMessage("  " + Measure(Suite, "RestoreFromTree, 1000 parameters", MeasureOptions::WithIterations(100), [&](int)
+      {
+        grouped_list.RestoreFromTree(state);
+      }).ToString());
+
+      logMessage("  " + Measure(Suite, "RestoreGroup, " + juce::String(ParamsPerGroup) + " parameters", MeasureOptions::WithIterations(1000), [&](int)
+      {
+        grouped_list.RestoreGroup(NumGroups / 2 + 1, bandState);
+      }).ToString());
+    }
+  }
+
+} // Benchmarks
+} // Haze
@@ -0,0 +1,24 @@
+
+#pragma once
+
+#include "Benchmark.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  class ParameterGroupsBenchmark : public juce::UnitTest
+  {
+  public:
+    // ctor
+    ParameterGroupsBenchmark() : UnitTest("Parameter groups, 1000 parameters in 50 groups", Category) {}
+
+    virtual void runTest() override final;
+
+  }; // ParameterGroupsBenchmark
+
+  static ParameterGroupsBenchmark GroupsBenchmark; // static addition to the test array
+
+} // Benchmarks
+} // Haze
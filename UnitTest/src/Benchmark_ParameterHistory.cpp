@@ -0,0 +1,94 @@
+
+#include "Benchmark_ParameterHistory.h"
+#include "ParameterHistory.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  void ParameterHistoryBenchmark::runTest()
+  {
+    constexpr int NumParams = 500;
+    constexpr int NumEdits = 1000000;
+    constexpr size_t Budget = 256 * 1024;
+
+    ParameterList param_list;
+    for (int i = 0; i < NumParams; ++i)
+    {
+      param_list.add(juce::Identifier("param_" + juce::String(i)), 0.f);
+    }
+
+    beginTest("1M edits into a " + juce::String(static_cast<int>(Budget / 1024)) + " KB history");
+    {
+      // knob drags: one gesture of 50 ticks on one parameter, every 10th gesture moves 20 parameters at once
+      ParameterHistory history(param_list, Budget, 0);
+      juce::Random rng(1234);
+
+      size_t peakBytes = 0;
+      int numEdits = 0;
+      const juce::int64 start = juce::Time::getHighResolutionTicks();
+
+      for (int gesture = 0; numEdits < NumEdits; ++gesture)
+      {
+        history.BeginGesture();
+        const int numTouched = gesture % 10 == 0 ? 20 : 1;
+        for (int tick = 0; tick < 50; ++tick)
+        {
+          for (int i = 0; i < numTouched; ++i)
+          {
+            history.Set((gesture + i * 7) % NumParams, rng.nextFloat());
+            ++numEdits;
+          }
+        }
+        history.EndGesture();
+
+        peakBytes = juce::jmax(peakBytes, history.GetNumBytes());
+      }
+
+      const double seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+      logMessage("  " + juce::String(numEdits) + " edits: " + juce::String(seconds * 1.0e9 / numEdits, 1) + " ns/edit, "
+                 + juce::String(history.GetNumTransactions()) + " undo steps kept, peak " + juce::String(static_cast<double>(peakBytes) / 1024.0, 1)
+                 + " KB (budget " + juce::String(static_cast<int>(Budget / 1024)) + " KB)");
+      expect(peakBytes <= Budget);
+    }
+
+    beginTest("Undo + redo: cost per changed parameter, 1 / 10 / 100 per step");
+    {
+      for (const int numChanged : { 1, 10, 100 })
+      {
+        // 100 ticks per parameter and step: what's undone is the number of parameters, not edits
+        constexpr int NumSteps = 64;
+        ParameterHistory history(param_list, 64 * 1024 * 1024, 0);
+        for (int step = 0; step < NumSteps; ++step)
+        {
+          history.BeginGesture();
+          for (int tick = 0; tick < 100; ++tick)
+          {
+            for (int i = 0; i < numChanged; ++i)
+            {
+              history.Set(i, static_cast<float>(step * 100 + tick + 1));
+            }
+          }
+          history.EndGesture();
+        }
+
+        // walk the whole history back and forth
+        const Measurement measurement = Measure("ParameterHistory", "undo + redo, " + juce::String(numChanged) + " parameters/step",
+                                                MeasureOptions::WithIterations(100), [&](int)
+        {
+          while (history.Undo()) {}
+          while (history.Redo()) {}
+          DoNotOptimize(history.CanRedo());
+        });
+
+        logMessage("  " + juce::String(numChanged).paddedLeft(' ', 3) + " parameters/step: "
+                   + juce::String(measurement.medianNs / (2.0 * NumSteps), 1) + " ns/step, "
+                   + juce::String(measurement.medianNs / (2.0 * NumSteps * numChanged), 1) + " ns/parameter");
+        expectEquals(static_cast<float>(param_list.GetParameter(0).GetAsVar()), static_cast<float>(NumSteps * 100));
+      }
+    }
+  }
+
+} // Benchmarks
+} // Haze
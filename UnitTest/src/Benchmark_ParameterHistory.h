@@ -0,0 +1,24 @@
+
+#pragma once
+
+#include "Benchmark.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  class ParameterHistoryBenchmark : public juce::UnitTest
+  {
+  public:
+    // ctor
+    ParameterHistoryBenchmark() : UnitTest("Parameter undo/redo, 1M edits", Category) {}
+
+    virtual void runTest() override final;
+
+  }; // ParameterHistoryBenchmark
+
+  static ParameterHistoryBenchmark HistoryBenchmark; // static addition to the test array
+
+} // Benchmarks
+} // Haze
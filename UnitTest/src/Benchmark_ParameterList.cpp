@@ -0,0 +1,124 @@
+
+#include "Benchmark_ParameterList.h"
+#include "ParameterTypes.h"
+#include <array>
+#include <numeric>
+#include <random>
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  void ParameterListBenchmark::runTest()
+  {
+    constexpr const char* Suite = "ParameterList";
+    constexpr int NumParams = 100;
+
+    std::vector<juce::Identifier> names;
+    for (int i = 0; i < NumParams; ++i)
+    {
+      names.emplace_back("param_" + juce::String(i));
+    }
+
+    // float/int/bool in turn
+    const auto fill = [&](ParameterList& list)
+    {
+      for (int i = 0; i < NumParams; ++i)
+      {
+        switch (i % 3)
+        {
+          case 0: list.add(names[static_cast<size_t>(i)], static_cast<float>(i)); break;
+          case 1: list.add(names[static_cast<size_t>(i)], static_cast<int>(i)); break;
+          default: list.add(names[static_cast<size_t>(i)], false); break;
+        }
+      }
+    };
+
+    // scrambled (but fixed) visiting order, so the branch predictor can't learn it
+    std::vector<int> order(NumParams);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::mt19937(1234));
+
+    const auto log = [this](const Measurement& measurement) { logMessage("  " + measurement.ToString()); };
+
+    beginTest("add(), " + juce::String(NumParams) + " parameters per list");
+    {
+      log(Measure(Suite, "add x" + juce::String(NumParams), MeasureOptions::WithIterations(100), [&](int)
+      {
+        ParameterList list;
+        fill(list);
+        DoNotOptimize(list.GetNumParameters());
+      }));
+    }
+
+    ParameterList list;
+    fill(list);
+
+    beginTest("Lookups and reads, " + juce::String(NumParams) + " parameters");
+    {
+      log(Measure(Suite, "operator[]", MeasureOptions::WithIterations(100000), [&](int i)
+      {
+        DoNotOptimize(list[names[static_cast<size_t>(order[static_cast<size_t>(i % NumParams)])]].get());
+      }));
+
+      const juce::Identifier& floatName = names[0];
+      float sum = 0.f;
+      log(Measure(Suite, "operator[]->Get<float>()", MeasureOptions::WithIterations(100000), [&](int)
+      {
+        sum += list[floatName]->Get<float>();
+        DoNotOptimize(sum);
+      }));
+
+      const ParamHandle<float> handle = list.GetHandle<float>(floatName);
+      log(Measure(Suite, "ParamHandle<float>::Get()", MeasureOptions::WithIterations(100000), [&](int)
+      {
+        sum += handle.Get();
+        DoNotOptimize(sum);
+      }));
+    }
+
+    beginTest("Writes");
+    {
+      const std::array<juce::var, 2> values { juce::var(1), juce::var(0) };
+      log(Measure(Suite, "SetAsVar", MeasureOptions::WithIterations(100000), [&](int i)
+      {
+        list.GetParameter(order[static_cast<size_t>(i % NumParams)]).SetAsVar(values[static_cast<size_t>(i & 1)]);
+      }));
+
+      log(Measure(Suite, "operator[]->SetAsVar", MeasureOptions::WithIterations(100000), [&](int i)
+      {
+        list[names[static_cast<size_t>(order[static_cast<size_t>(i % NumParams)])]]->SetAsVar(values[static_cast<size_t>(i & 1)]);
+      }));
+    }
+
+    beginTest("juce::ValueTree sync, " + juce::String(NumParams) + " parameters");
+    {
+      log(Measure(Suite, "GetStateAsTree", MeasureOptions::WithIterations(1000), [&](int)
+      {
+        DoNotOptimize(list.GetStateAsTree().getNumProperties());
+      }));
+
+      // (attach + detach, SyncToTree() alone would pile up listeners)
+      juce::ValueTree tree = list.GetStateAsTree();
+      log(Measure(Suite, "SyncToTree + DesyncFromTree", MeasureOptions::WithIterations(1000), [&](int)
+      {
+        list.SyncToTree(tree);
+        list.DesyncFromTree(tree);
+      }));
+
+      // property changes on a synced tree land in valueTreePropertyChanged()
+      list.SyncToTree(tree);
+      log(Measure(Suite, "valueTreePropertyChanged (via setProperty)", MeasureOptions::WithIterations(100000), [&](int i)
+      {
+        const int index = order[static_cast<size_t>(i % NumParams)];
+        tree.setProperty(names[static_cast<size_t>(index)], (i & 1) != 0 ? 1 : 0, nullptr);
+      }));
+      list.DesyncFromTree(tree);
+
+      expect(list[names[static_cast<size_t>(order[0])]]->GetAsVar() == tree.getProperty(names[static_cast<size_t>(order[0])]));
+    }
+  }
+
+} // Benchmarks
+} // Haze
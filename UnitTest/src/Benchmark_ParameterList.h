@@ -0,0 +1,24 @@
+
+#pragma once
+
+#include "Benchmark.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  class ParameterListBenchmark : public juce::UnitTest
+  {
+  public:
+    // ctor
+    ParameterListBenchmark() : UnitTest("ParameterList hot paths", Category) {}
+
+    virtual void runTest() override final;
+
+  }; // ParameterListBenchmark
+
+  static ParameterListBenchmark ListBenchmark; // static addition to the test array
+
+} // Benchmarks
+} // Haze
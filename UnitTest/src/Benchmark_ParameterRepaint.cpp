@@ -0,0 +1,134 @@
+
+#include "Benchmark_ParameterRepaint.h"
+#include "ParameterControls.h"
+#include <utility>
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  void ParameterRepaintBenchmark::runTest()
+  {
+    constexpr int NumParams = 500;
+    constexpr int RowHeight = 16;
+    constexpr int EditorWidth = 400;
+    constexpr int BlocksPerSecond = 48000 / 64;
+    constexpr int FrameHz = ParameterListView::DefaultFrameHz;
+
+    // (HazeBenchmarks is a console app: components need the message manager + fonts)
+    const juce::ScopedJuceInitialiser_GUI gui;
+
+    ParameterList param_list;
+    std::vector<ParamHandle<float>> params;
+    for (int i = 0; i < NumParams; ++i)
+    {
+      const juce::Identifier name("param_" + juce::String(i));
+      param_list.add(name, 0.f, ParamRange<float>(0.f, 1.f), {"", "", "", /*bPreferSliderOverKnob*/true});
+      params.push_back(param_list.GetHandle<float>(name));
+    }
+
+    // worst case: every automated control on screen
+    ParameterListView view(param_list, RowHeight);
+    view.setSize(EditorWidth, NumParams * RowHeight);
+
+    std::vector<ParameterControl*> controls;
+    for (int i = 0; i < NumParams; ++i)
+    {
+      controls.push_back(dynamic_cast<ParameterControl*>(view.GetListBox().getComponentForRowNumber(i)));
+      expect(controls.back() != nullptr);
+    }
+
+    // audio-rate automation (one write per parameter and 64 sample block), the frame's share of it
+    const auto automate = [&](int frame, auto&& onChange)
+    {
+      for (int block = frame * BlocksPerSecond / FrameHz; block < (frame + 1) * BlocksPerSecond / FrameHz; ++block)
+      {
+        for (int i = 0; i < NumParams; ++i)
+        {
+          params[static_cast<size_t>(i)].Set(static_cast<float>((block + i) % 100) / 100.f);
+          onChange(i);
+        }
+      }
+    };
+
+    // what the peer does once a frame: paint the invalidated area
+    juce::Image frameImage(juce::Image::ARGB, EditorWidth, NumParams * RowHeight, true);
+    const auto paintFrame = [&](const juce::RectangleList<int>& region)
+    {
+      juce::Graphics g(frameImage);
+      g.reduceClipRegion(region);
+      view.paintEntireComponent(g, true);
+    };
+
+    // the area the peer was asked to repaint: the flagged rows' controls, adjacent rows merged (clears the flags)
+    std::vector<char> isRepainted(NumParams, 0);
+    const auto repaintedRegion = [&]
+    {
+      juce::RectangleList<int> region;
+      for (int i = 0; i < NumParams; ++i)
+      {
+        if (std::exchange(isRepainted[static_cast<size_t>(i)], 0) != 0)
+        {
+          region.add(view.getLocalArea(controls[static_cast<size_t>(i)], controls[static_cast<size_t>(i)]->getLocalBounds()));
+        }
+      }
+      region.consolidate();
+      return region;
+    };
+
+    // message thread share of one display frame -> cpu use and the frame rate it still allows
+    const auto report = [this](const Measurement& measurement, int refreshesPerFrame)
+    {
+      const double load = measurement.medianNs * FrameHz / 1.0e9;
+      logMessage("  " + measurement.ToString());
+      logMessage("  " + juce::String(refreshesPerFrame * FrameHz) + " control refreshes/s, message thread "
+                 + juce::String(load * 100.0, 1) + "% busy, " + juce::String(FrameHz * juce::jmin(1.0, 1.0 / load), 1) + " fps");
+      return load;
+    };
+
+    double perChangeLoad = 0.0;
+    beginTest("Before: every change refreshes its control");
+    {
+      // (i.e. a tree listener per control): same painted area as below, many more refreshes
+      int numRefreshes = 0;
+      const Measurement measurement = Measure("ParameterRepaint", "refresh per change, per frame", MeasureOptions::WithIterations(FrameHz), [&](int frame)
+      {
+        numRefreshes = 0;
+        automate(frame, [&](int i)
+        {
+          if (controls[static_cast<size_t>(i)]->Refresh())
+          {
+            isRepainted[static_cast<size_t>(i)] = 1;
+            ++numRefreshes;
+          }
+        });
+        paintFrame(repaintedRegion());
+      });
+      perChangeLoad = report(measurement, numRefreshes);
+    }
+
+    beginTest("After: changes marked, refreshed once per frame");
+    {
+      int numRefreshes = 0;
+      const Measurement measurement = Measure("ParameterRepaint", "refresh per frame, per frame", MeasureOptions::WithIterations(FrameHz), [&](int frame)
+      {
+        // (the automation moves every parameter each frame, so every marked row's control repaints)
+        automate(frame, [&](int i)
+        {
+          view.MarkChanged(i);
+          isRepainted[static_cast<size_t>(i)] = 1;
+        });
+        numRefreshes = view.FlushChanges();
+        paintFrame(repaintedRegion());
+      });
+      const double perFrameLoad = report(measurement, numRefreshes);
+
+      logMessage("  " + juce::String(perChangeLoad / perFrameLoad, 1) + "x less message thread time");
+      expect(numRefreshes <= NumParams);
+      expect(perFrameLoad < perChangeLoad);
+    }
+  }
+
+} // Benchmarks
+} // Haze
@@ -0,0 +1,24 @@
+
+#pragma once
+
+#include "Benchmark.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  class ParameterRepaintBenchmark : public juce::UnitTest
+  {
+  public:
+    // ctor
+    ParameterRepaintBenchmark() : UnitTest("Control repaint, 500 automated parameters", Category) {}
+
+    virtual void runTest() override final;
+
+  }; // ParameterRepaintBenchmark
+
+  static ParameterRepaintBenchmark RepaintBenchmark; // static addition to the test array
+
+} // Benchmarks
+} // Haze
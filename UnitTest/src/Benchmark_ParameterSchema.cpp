@@ -0,0 +1,100 @@
+
+#include "Benchmark_ParameterSchema.h"
+#include "ParameterTypes.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  void ParameterSchemaBenchmark::runTest()
+  {
+    constexpr const char* Suite = "ParameterSchema";
+    constexpr int NumInstances = 200;
+    constexpr int NumParams = 200;
+
+    // the plugin's layout: every instance of the plugin builds the same one
+    std::vector<juce::Identifier> names;
+    for (int i = 0; i < NumParams; ++i)
+    {
+      names.emplace_back("param_" + juce::String(i));
+    }
+
+    const auto build = [&names](ParameterList& list)
+    {
+      for (int i = 0; i < NumParams; ++i)
+      {
+        const auto label = [i] { return "Parameter " + juce::String(i); };
+        switch (i % 4)
+        {
+          case 0: list.add(names[static_cast<size_t>(i)], 0.5f, ParamRange<float>(0.f, 1.f), {label(), "a knob w/ a tooltip", "dB"}); break;
+          case 1: list.add(names[static_cast<size_t>(i)], 1000.f, ParamRange<float>(20.f, 20000.f), {label(), "a frequency", "Hz", false, /*bIsLogarithmic*/true}); break;
+          case 2: list.add(names[static_cast<size_t>(i)], true); break;
+          default: list.add(names[static_cast<size_t>(i)], int { i }, UiMetadata(label())); break;
+        }
+      }
+    };
+
+    // heap bytes per instance while NumInstances of them are alive
+    // (taken before the timed runs below, which build and free thousands of lists)
+    const auto bytesPerInstance = [](auto&& makeInstance)
+    {
+      const juce::int64 before = HeapBytesInUse();
+      std::vector<std::unique_ptr<ParameterList>> instances;
+      for (int i = 0; i < NumInstances; ++i)
+      {
+        instances.push_back(makeInstance());
+      }
+      return std::make_pair((HeapBytesInUse() - before) / NumInstances, std::move(instances));
+    };
+    const auto kilobytes = [](juce::int64 numBytes) { return juce::String(static_cast<double>(numBytes) / 1024.0, 1) + " KB"; };
+
+    beginTest("Per instance: every list built w/ add()");
+    {
+      const auto [numBytes, instances] = bytesPerInstance([&]
+      {
+        auto list = std::make_unique<ParameterList>();
+        build(*list);
+        return list;
+      });
+      expect(instances.front()->GetSchema() != instances.back()->GetSchema());
+
+      const Measurement built = Measure(Suite, "one instance built w/ add(), " + juce::String(NumParams) + " parameters", MeasureOptions::WithIterations(NumInstances), [&](int)
+      {
+        ParameterList list;
+        build(list);
+        DoNotOptimize(list.GetNumParameters());
+      });
+
+      logMessage("  " + built.ToString());
+      if (numBytes > 0)
+      {
+        logMessage("  heap per instance: " + kilobytes(numBytes) + " (" + juce::String(NumInstances) + " alive)");
+      }
+    }
+
+    beginTest("Shared: every list made from one ParameterSchema");
+    {
+      ParameterList prototype;
+      build(prototype);
+      const ParameterSchema::Ptr schema = prototype.GetSchema();
+
+      const auto [numBytes, instances] = bytesPerInstance([&] { return std::make_unique<ParameterList>(schema); });
+      expectEquals(schema->getReferenceCount(), NumInstances + 2);
+
+      const Measurement shared = Measure(Suite, "one instance from a shared schema, " + juce::String(NumParams) + " parameters", MeasureOptions::WithIterations(NumInstances), [&](int)
+      {
+        ParameterList list(schema);
+        DoNotOptimize(list.GetNumParameters());
+      });
+
+      logMessage("  " + shared.ToString());
+      if (numBytes > 0)
+      {
+        logMessage("  heap per instance: " + kilobytes(numBytes) + " (" + juce::String(NumInstances) + " alive, the schema itself not counted)");
+      }
+    }
+  }
+
+} // Benchmarks
+} // Haze
@@ -0,0 +1,24 @@
+
+#pragma once
+
+#include "Benchmark.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  class ParameterSchemaBenchmark : public juce::UnitTest
+  {
+  public:
+    // ctor
+    ParameterSchemaBenchmark() : UnitTest("Shared schema, 200 instances", Category) {}
+
+    virtual void runTest() override final;
+
+  }; // ParameterSchemaBenchmark
+
+  static ParameterSchemaBenchmark SchemaBenchmark; // static addition to the test array
+
+} // Benchmarks
+} // Haze
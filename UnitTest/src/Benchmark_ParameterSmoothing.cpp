@@ -0,0 +1,82 @@
+
+#include "Benchmark_ParameterSmoothing.h"
+#include "ParameterSmoothing.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  void ParameterSmoothingBenchmark::runTest()
+  {
+    constexpr const char* Suite = "ParameterSmoothing";
+    constexpr double SampleRate = 48000.0;
+    constexpr int SamplesPerRun = 1 << 18;
+
+    for (const auto ramp : { ParamSmoother::Ramp::Linear, ParamSmoother::Ramp::Multiplicative })
+    {
+      const juce::String rampName = ramp == ParamSmoother::Ramp::Linear ? "Linear" : "Multiplicative";
+      beginTest(rampName);
+
+      for (int blockSize = 64; blockSize <= 2048; blockSize *= 2)
+      {
+        const int numBlocks = SamplesPerRun / blockSize;
+        std::vector<float> block(static_cast<size_t>(blockSize));
+
+        // ramp long enough that every block is mid-ramp; flip the target when it gets close
+        ParamSmoother blockSmoother(ramp, 100.f);
+        ParamSmoother sampleSmoother(ramp, 100.f);
+        blockSmoother.Prepare(SampleRate, 1.0);
+        sampleSmoother.Prepare(SampleRate, 1.0);
+
+        const auto retarget = [](ParamSmoother& smoother)
+        {
+          smoother.SetTarget(smoother.GetTarget() == 1000.f ? 100.f : 1000.f);
+        };
+
+        const juce::String size = ", " + juce::String(blockSize) + " samples";
+        const Measurement rendered = Measure(Suite, rampName + " RenderBlock" + size, MeasureOptions::WithIterations(numBlocks), [&](int i)
+        {
+          if (i % 16 == 0)
+          {
+            retarget(blockSmoother);
+          }
+          blockSmoother.RenderBlock(block.data(), blockSize);
+          DoNotOptimize(block[0]);
+        });
+
+        const Measurement perSample = Measure(Suite, rampName + " per-sample loop" + size, MeasureOptions::WithIterations(numBlocks), [&](int i)
+        {
+          if (i % 16 == 0)
+          {
+            retarget(sampleSmoother);
+          }
+          for (auto& x : block)
+          {
+            x = sampleSmoother.GetNextValue();
+          }
+          DoNotOptimize(block[0]);
+        });
+
+        logMessage("  " + rendered.ToString() + " (" + juce::String(rendered.medianNs / blockSize, 3) + " ns/sample)");
+        logMessage("  " + perSample.ToString() + " (" + juce::String(perSample.medianNs / blockSize, 3) + " ns/sample)");
+      }
+    }
+
+    beginTest("Settled");
+    {
+      ParamSmoother smoother(ParamSmoother::Ramp::Linear, 1.f);
+      smoother.Prepare(SampleRate, 0.05);
+      std::vector<float> block(512);
+
+      const Measurement settled = Measure(Suite, "RenderBlock, 512 samples, no ramp", MeasureOptions::WithIterations(SamplesPerRun / 512), [&](int)
+      {
+        DoNotOptimize(smoother.RenderBlock(block.data(), 512));
+      });
+      logMessage("  " + settled.ToString());
+      expect(!smoother.IsSmoothing());
+    }
+  }
+
+} // Benchmarks
+} // Haze
@@ -0,0 +1,24 @@
+
+#pragma once
+
+#include "Benchmark.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  class ParameterSmoothingBenchmark : public juce::UnitTest
+  {
+  public:
+    // ctor
+    ParameterSmoothingBenchmark() : UnitTest("ParamSmoother block rendering", Category) {}
+
+    virtual void runTest() override final;
+
+  }; // ParameterSmoothingBenchmark
+
+  static ParameterSmoothingBenchmark SmoothingBenchmark; // static addition to the test array
+
+} // Benchmarks
+} // Haze
@@ -0,0 +1,235 @@
+
+#include "Benchmark_ParameterTypes.h"
+#include "ParameterTypes.h"
+#include <algorithm>
+#include <random>
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  void ParameterLookupBenchmark::runTest()
+  {
+    constexpr const char* Suite = "ParameterTypes";
+    constexpr int NumLookups = 100000;
+
+    for (const int numParams : { 10, 100, 1000 })
+    {
+      beginTest("operator[] w/ " + juce::String(numParams) + " parameters");
+
+      std::vector<juce::Identifier> names;
+      ParameterList param_list;
+      for (int i = 0; i < numParams; ++i)
+      {
+        names.emplace_back("param_" + juce::String(i));
+        param_list.add(names.back(), static_cast<float>(i));
+      }
+
+      // visit the parameters in a scrambled (but fixed) order so the branch predictor can't learn it
+      std::vector<juce::Identifier> lookupOrder(names);
+      std::shuffle(lookupOrder.begin(), lookupOrder.end(), std::mt19937(1234));
+
+      const juce::String size = ", " + juce::String(numParams) + " parameters";
+      const Measurement indexed = Measure(Suite, "operator[] lookup" + size, MeasureOptions::WithIterations(NumLookups), [&](int i)
+      {
+        DoNotOptimize(param_list[lookupOrder[static_cast<size_t>(i % numParams)]].get());
+      });
+
+      // reference: the linear search operator[] used before the index existed
+      const Measurement linear = Measure(Suite, "linear search lookup" + size, MeasureOptions::WithIterations(NumLookups), [&](int i)
+      {
+        const auto& name = lookupOrder[static_cast<size_t>(i % numParams)];
+        DoNotOptimize(&*std::find(names.begin(), names.end(), name));
+      });
+
+      logMessage("  " + indexed.ToString());
+      logMessage("  " + linear.ToString());
+
+      // sanity: every name still resolves to its own entry
+      bool bAllFound = true;
+      for (int i = 0; i < numParams; ++i)
+      {
+        bAllFound &= param_list[names[static_cast<size_t>(i)]]->IsEqualTo(static_cast<float>(i));
+      }
+      expect(bAllFound);
+    }
+  }
+
+  void ParameterHandleBenchmark::runTest()
+  {
+    constexpr const char* Suite = "ParameterTypes";
+    constexpr int NumReads = 1000000;
+
+    const juce::Identifier Freq("freq");
+    const juce::Identifier NumTaps("NumTaps");
+    const juce::Identifier Enabled("Enabled");
+
+    ParameterList param_list;
+    param_list
+      .add(Freq, 500.f)
+      .add(NumTaps, 4)
+      .add(Enabled, true)
+    ;
+
+    beginTest("Get<float>() read");
+    float sum = 0.f;
+    const Measurement indexed = Measure(Suite, "param_list[Freq]->Get<float>()", MeasureOptions::WithIterations(NumReads), [&](int)
+    {
+      sum += param_list[Freq]->Get<float>();
+      DoNotOptimize(sum);
+    });
+
+    const ParamHandle<float> freqHandle = param_list.GetHandle<float>(Freq);
+    const Measurement handle = Measure(Suite, "ParamHandle<float>::Get()", MeasureOptions::WithIterations(NumReads), [&](int)
+    {
+      sum += freqHandle.Get();
+      DoNotOptimize(sum);
+    });
+
+    logMessage("  " + indexed.ToString());
+    logMessage("  " + handle.ToString());
+    expect(freqHandle.IsEqualTo(500.f));
+  }
+
+  void PresetLoadBenchmark::runTest()
+  {
+    constexpr const char* Suite = "ParameterTypes";
+    constexpr int NumParams = 500;
+    constexpr int NumPresets = 1000;
+    constexpr int NumDistinctPresets = 64; // cycled through, to keep the working set realistic
+
+    std::vector<juce::Identifier> names;
+    ParameterList param_list;
+    for (int i = 0; i < NumParams; ++i)
+    {
+      names.emplace_back("param_" + juce::String(i));
+      switch (i % 3)
+      {
+        case 0: param_list.add(names.back(), 0.f); break;
+        case 1: param_list.add(names.back(), 0); break;
+        default: param_list.add(names.back(), false); break;
+      }
+    }
+
+    juce::Random rng(1234);
+    std::vector<juce::ValueTree> presetTrees;
+    std::vector<ParameterSnapshot> presetSnapshots(NumDistinctPresets);
+    for (int p = 0; p < NumDistinctPresets; ++p)
+    {
+      for (int i = 0; i < NumParams; ++i)
+      {
+        param_list.GetParameter(i).SetAsVar(rng.nextInt(1000));
+      }
+      presetTrees.push_back(param_list.GetStateAsTree());
+      param_list.CaptureSnapshot(presetSnapshots[static_cast<size_t>(p)]);
+    }
+
+    beginTest("Restore presets of 500 parameters");
+    {
+      // reference: what SyncToTree did before (linear name search per property)
+      const Measurement linear = Measure(Suite, "restore preset: ValueTree, linear search", MeasureOptions::WithIterations(NumPresets), [&](int p)
+      {
+        const juce::ValueTree& tree = presetTrees[static_cast<size_t>(p % NumDistinctPresets)];
+        for (int i = 0; i < tree.getNumProperties(); ++i)
+        {
+          const juce::Identifier name (tree.getPropertyName(i));
+          const auto index = std::find(names.begin(), names.end(), name) - names.begin();
+          param_list.GetParameter(static_cast<int>(index)).SetAsVar(tree.getProperty(name));
+        }
+      });
+
+      const Measurement tree = Measure(Suite, "restore preset: RestoreFromTree (by position)", MeasureOptions::WithIterations(NumPresets), [&](int p)
+      {
+        param_list.RestoreFromTree(presetTrees[static_cast<size_t>(p % NumDistinctPresets)]);
+      });
+
+      const Measurement snapshot = Measure(Suite, "restore preset: RestoreSnapshot (flat buffer)", MeasureOptions::WithIterations(NumPresets), [&](int p)
+      {
+        param_list.RestoreSnapshot(presetSnapshots[static_cast<size_t>(p % NumDistinctPresets)]);
+      });
+
+      logMessage("  " + linear.ToString());
+      logMessage("  " + tree.ToString());
+      logMessage("  " + snapshot.ToString());
+      expect(param_list.GetParameter(NumParams - 1).GetAsVar() == presetSnapshots[(NumPresets - 1) % NumDistinctPresets].values.back());
+    }
+
+    beginTest("Capture presets of 500 parameters");
+    {
+      const Measurement tree = Measure(Suite, "capture preset: GetStateAsTree", MeasureOptions::WithIterations(NumPresets), [&](int)
+      {
+        DoNotOptimize(param_list.GetStateAsTree());
+      });
+
+      ParameterSnapshot snapshot;
+      const Measurement captured = Measure(Suite, "capture preset: CaptureSnapshot (reused buffer)", MeasureOptions::WithIterations(NumPresets), [&](int)
+      {
+        param_list.CaptureSnapshot(snapshot);
+        DoNotOptimize(snapshot.values[0]);
+      });
+
+      logMessage("  " + tree.ToString());
+      logMessage("  " + captured.ToString());
+    }
+  }
+
+  void ClampedWriteBenchmark::runTest()
+  {
+    constexpr const char* Suite = "ParameterTypes";
+    constexpr int NumWrites = 1000000;
+
+    const juce::Identifier Free("free");
+    const juce::Identifier Cutoff("cutoff");
+
+    ParameterList param_list;
+    param_list
+      .add(Free, 0.f)
+      .add(Cutoff, 1000.f, ParamRange<float>(20.f, 20000.f))
+    ;
+
+    // input sweeps past both ends of the range
+    const auto input = [](int i) { return static_cast<float>(i % 40000) - 10000.f; };
+
+    beginTest("float writes");
+
+    const ParamHandle<float> freeHandle = param_list.GetHandle<float>(Free);
+    const Measurement unclamped = Measure(Suite, "ParamHandle::Set, no range", MeasureOptions::WithIterations(NumWrites), [&](int i)
+    {
+      freeHandle.Set(input(i));
+      DoNotOptimize(freeHandle.Get());
+    });
+
+    const ParamHandle<float> cutoffHandle = param_list.GetHandle<float>(Cutoff);
+    const Measurement typed = Measure(Suite, "ParamHandle::Set, ParamRange clamp", MeasureOptions::WithIterations(NumWrites), [&](int i)
+    {
+      cutoffHandle.Set(input(i));
+      DoNotOptimize(cutoffHandle.Get());
+    });
+
+    UiParameter& cutoff = *param_list[Cutoff];
+    const Measurement var = Measure(Suite, "SetAsVar, ParamRange clamp", MeasureOptions::WithIterations(NumWrites), [&](int i)
+    {
+      cutoff.SetAsVar(input(i));
+      DoNotOptimize(cutoffHandle.Get());
+    });
+
+    // what a write used to cost w/ a type-erased clamp working on juce::var
+    const std::function<void(juce::var&)> varClamper = [](juce::var& x) { x = juce::jlimit(20.f, 20000.f, static_cast<float>(x)); };
+    const Measurement erased = Measure(Suite, "juce::var + std::function clamp", MeasureOptions::WithIterations(NumWrites), [&](int i)
+    {
+      juce::var value(input(i));
+      varClamper(value);
+      freeHandle.Set(static_cast<float>(value));
+      DoNotOptimize(freeHandle.Get());
+    });
+
+    logMessage("  " + unclamped.ToString());
+    logMessage("  " + typed.ToString());
+    logMessage("  " + var.ToString());
+    logMessage("  " + erased.ToString());
+    expect(cutoffHandle.Get() >= 20.f && cutoffHandle.Get() <= 20000.f);
+  }
+
+} // Benchmarks
+} // Haze
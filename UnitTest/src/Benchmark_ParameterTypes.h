@@ -0,0 +1,63 @@
+
+#pragma once
+
+#include "Benchmark.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  class ParameterLookupBenchmark : public juce::UnitTest
+  {
+  public:
+    // ctor
+    ParameterLookupBenchmark() : UnitTest("ParameterList lookup", Category) {}
+
+    virtual void runTest() override final;
+
+  }; // ParameterLookupBenchmark
+
+  static ParameterLookupBenchmark LookupBenchmark; // static addition to the test array
+
+
+  class ParameterHandleBenchmark : public juce::UnitTest
+  {
+  public:
+    // ctor
+    ParameterHandleBenchmark() : UnitTest("ParamHandle vs. operator[] access", Category) {}
+
+    virtual void runTest() override final;
+
+  }; // ParameterHandleBenchmark
+
+  static ParameterHandleBenchmark HandleBenchmark; // static addition to the test array
+
+
+  class PresetLoadBenchmark : public juce::UnitTest
+  {
+  public:
+    // ctor
+    PresetLoadBenchmark() : UnitTest("ParameterList preset capture/restore", Category) {}
+
+    virtual void runTest() override final;
+
+  }; // PresetLoadBenchmark
+
+  static PresetLoadBenchmark PresetBenchmark; // static addition to the test array
+
+
+  class ClampedWriteBenchmark : public juce::UnitTest
+  {
+  public:
+    // ctor
+    ClampedWriteBenchmark() : UnitTest("Clamped parameter writes", Category) {}
+
+    virtual void runTest() override final;
+
+  }; // ClampedWriteBenchmark
+
+  static ClampedWriteBenchmark ClampBenchmark; // static addition to the test array
+
+} // Benchmarks
+} // Haze
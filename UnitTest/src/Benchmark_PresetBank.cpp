@@ -0,0 +1,92 @@
+
+#include "Benchmark_PresetBank.h"
+#include "PresetBank.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  void PresetBankBenchmark::runTest()
+  {
+    constexpr int NumPresets = 10000;
+    constexpr int NumParams = 100;
+
+    ParameterList param_list;
+    for (int i = 0; i < NumParams; ++i)
+    {
+      param_list.add(juce::Identifier("param_" + juce::String(i)), static_cast<float>(i));
+    }
+
+    const auto presetName = [](int i) { return "Factory " + juce::String(i).paddedLeft('0', 5); };
+
+    juce::TemporaryFile bankFile(".hzpk");
+    {
+      PresetBankWriter writer;
+      juce::Random rng(1234);
+      for (int p = 0; p < NumPresets; ++p)
+      {
+        for (int i = 0; i < NumParams; ++i)
+        {
+          param_list.GetParameter(i) = rng.nextFloat();
+        }
+        writer.AddPreset(presetName(p), param_list);
+      }
+      expect(writer.WriteTo(bankFile.getFile()));
+    }
+
+    const auto megabytes = [](juce::int64 numBytes) { return juce::String(static_cast<double>(numBytes) / (1024.0 * 1024.0), 2) + " MB"; };
+
+    beginTest("Time-to-first-preset and resident memory (page cache is warm from writing the bank)");
+    {
+      constexpr const char* Suite = "PresetBank";
+
+      logMessage("  bank file: " + megabytes(bankFile.getFile().getSize()) + " (" + juce::String(NumPresets) + " presets x "
+                 + juce::String(NumParams) + " parameters)");
+
+      // resident memory of one bank, before the timed runs below open and close it over and over
+      const juce::int64 rssBefore = ResidentMemoryBytes();
+      const PresetBank bank(bankFile.getFile());
+      expect(bank.IsValid() && bank.LoadPreset(presetName(NumPresets / 2), param_list));
+      const juce::int64 rssFirstPreset = ResidentMemoryBytes();
+
+      const Measurement open = Measure(Suite, "open (map + index check)", MeasureOptions::WithIterations(10), [&](int)
+      {
+        const PresetBank opened(bankFile.getFile());
+        DoNotOptimize(opened.GetNumPresets());
+      });
+
+      bool bAllLoaded = true;
+      const Measurement firstPreset = Measure(Suite, "time-to-first-preset (open + LoadPreset)", MeasureOptions::WithIterations(10), [&](int)
+      {
+        const PresetBank opened(bankFile.getFile());
+        bAllLoaded &= opened.LoadPreset(presetName(NumPresets / 2), param_list);
+      });
+      expect(bAllLoaded);
+
+      // what startup costs when every preset is decoded up front
+      std::vector<ParameterSnapshot> allPresets(static_cast<size_t>(NumPresets));
+      const Measurement decodeAll = Measure(Suite, "decode all " + juce::String(NumPresets) + " presets", MeasureOptions::WithIterations(1), [&](int)
+      {
+        for (int p = 0; p < bank.GetNumPresets(); ++p)
+        {
+          bank.GetPreset(p).ApplyTo(param_list);
+          param_list.CaptureSnapshot(allPresets[static_cast<size_t>(p)]);
+        }
+      });
+      const juce::int64 rssAllPresets = ResidentMemoryBytes();
+
+      logMessage("  " + open.ToString());
+      logMessage("  " + firstPreset.ToString());
+      logMessage("  " + decodeAll.ToString());
+
+      if (rssBefore > 0)
+      {
+        logMessage("  resident, first preset: +" + megabytes(rssFirstPreset - rssBefore));
+        logMessage("  resident, all decoded:  +" + megabytes(rssAllPresets - rssBefore));
+      }
+    }
+  }
+
+} // Benchmarks
+} // Haze
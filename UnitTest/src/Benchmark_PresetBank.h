@@ -0,0 +1,24 @@
+
+#pragma once
+
+#include "Benchmark.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  class PresetBankBenchmark : public juce::UnitTest
+  {
+  public:
+    // ctor
+    PresetBankBenchmark() : UnitTest("Memory-mapped preset bank (10k presets)", Category) {}
+
+    virtual void runTest() override final;
+
+  }; // PresetBankBenchmark
+
+  static PresetBankBenchmark MappedBankBenchmark; // static addition to the test array
+
+} // Benchmarks
+} // Haze
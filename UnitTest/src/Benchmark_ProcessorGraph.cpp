@@ -0,0 +1,257 @@
+
+#include "Benchmark_ProcessorGraph.h"
+#include "ProcessorGraph.h"
+#include <algorithm>
+#include <thread>
+
+namespace Haze
+{
+namespace Benchmarks
+{
+  namespace
+  {
+    // a few microseconds of filtering per exec(), standing in for a real processor
+    // (optionally publishes its buffer to mailboxes in other domains, or analyses the frames it receives)
+    class BusyProcessor : public ProcessorInterface
+    {
+    public:
+      explicit BusyProcessor(int numPasses = 8) : numPasses_(numPasses) { buffer_.fill(0.5f); }
+
+      const ParameterList& getUiParameterList() const override { return params_; }
+
+      void exec() override
+      {
+        if (input_ != nullptr)
+        {
+          const FrameMailbox::Frame frame = input_->Read();
+          std::copy(frame.data, frame.data + juce::jmin(frame.numSamples, static_cast<int>(buffer_.size())), buffer_.begin());
+        }
+
+        for (int pass = 0; pass < numPasses_; ++pass)
+        {
+          for (float& sample : buffer_)
+          {
+            state_ = 0.99f * state_ + 0.01f * sample;
+            sample = state_ * 1.0001f;
+          }
+        }
+        DoNotOptimize(buffer_[0]);
+
+        for (FrameMailbox* output : outputs_)
+        {
+          output->Write(buffer_.data(), static_cast<int>(buffer_.size()));
+        }
+      }
+
+      FrameMailbox* input_ = nullptr;
+      std::vector<FrameMailbox*> outputs_;
+
+    private:
+      const int numPasses_;
+      std::array<float, 256> buffer_;
+      float state_ = 0.f;
+      ParameterList params_;
+    };
+
+    // every node feeds one sink
+    void BuildWide(ProcessorGraph& graph, int numNodes)
+    {
+      const ProcessorGraph::NodeId sink = graph.AddNode(std::make_unique<BusyProcessor>());
+      for (int i = 1; i < numNodes; ++i)
+      {
+        graph.Connect(graph.AddNode(std::make_unique<BusyProcessor>()), sink);
+      }
+      graph.Prepare();
+    }
+
+    // one long chain
+    void BuildDeep(ProcessorGraph& graph, int numNodes)
+    {
+      ProcessorGraph::NodeId previous = graph.AddNode(std::make_unique<BusyProcessor>());
+      for (int i = 1; i < numNodes; ++i)
+      {
+        const ProcessorGraph::NodeId node = graph.AddNode(std::make_unique<BusyProcessor>());
+        graph.Connect(previous, node);
+        previous = node;
+      }
+      graph.Prepare();
+    }
+
+    // per-block durations next to Measure(), for the tail latencies its summary leaves out
+    // (records every repetition, warmups included, and keeps the last numRepetitions)
+    class BlockTimes
+    {
+    public:
+      explicit BlockTimes(const MeasureOptions& options) : numKept_(static_cast<size_t>(options.numRepetitions))
+      {
+        microseconds_.reserve(static_cast<size_t>(options.numWarmups + options.numRepetitions));
+      }
+
+      void Clear() { microseconds_.clear(); }
+
+      // p in [0, 1] over the kept blocks, in us
+      juce::String Percentile(double p) const
+      {
+        const size_t numKept = juce::jmin(numKept_, microseconds_.size());
+        if (numKept == 0)
+        {
+          return "-";
+        }
+
+        std::vector<double> kept(microseconds_.end() - static_cast<std::ptrdiff_t>(numKept), microseconds_.end());
+        std::sort(kept.begin(), kept.end());
+        return juce::String(kept[static_cast<size_t>(p * static_cast<double>(numKept - 1))], 1);
+      }
+
+      // times one block
+      class Scope
+      {
+      public:
+        explicit Scope(BlockTimes& times) : times_(times), start_(juce::Time::getHighResolutionTicks()) {}
+        ~Scope() { times_.microseconds_.push_back(juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start_) * 1.0e6); }
+
+      private:
+        BlockTimes& times_;
+        const juce::int64 start_;
+      };
+
+    private:
+      const size_t numKept_;
+      std::vector<double> microseconds_;
+    };
+  } // namespace
+
+  void ProcessorGraphBenchmark::runTest()
+  {
+    constexpr const char* Suite = "ProcessorGraph";
+    constexpr int NumNodes = 64;
+
+    // one block per repetition: the median is the p50 block, the tail comes from BlockTimes
+    MeasureOptions options = MeasureOptions::WithIterations(1);
+    options.numWarmups = 20;
+    options.numRepetitions = 500;
+
+    BlockTimes blockTimes(options);
+    const auto measure = [&](const juce::String& name, ProcessorGraph& graph, WorkerPool* pool)
+    {
+      blockTimes.Clear();
+      const Measurement m = Measure(Suite, name, options, [&](int)
+      {
+        const BlockTimes::Scope scope(blockTimes);
+        pool != nullptr ? graph.Process(*pool) : graph.Process();
+      });
+      return m.ToString() + ", p90 " + blockTimes.Percentile(0.9) + " us, p99 " + blockTimes.Percentile(0.99) + " us, max " + blockTimes.Percentile(1.0) + " us";
+    };
+
+    for (const bool bIsWide : { true, false })
+    {
+      beginTest(juce::String(bIsWide ? "Wide" : "Deep") + " graph, " + juce::String(NumNodes) + " nodes (per-block latency)");
+
+      ProcessorGraph graph;
+      bIsWide ? BuildWide(graph, NumNodes) : BuildDeep(graph, NumNodes);
+      const juce::String shape = juce::String(bIsWide ? "wide" : "deep") + " " + juce::String(NumNodes) + " nodes";
+
+      logMessage("  " + measure(shape + ", serial Process()", graph, nullptr));
+
+      for (const int numThreads : { 1, 2, 4, 8, 16 })
+      {
+        WorkerPool pool(numThreads);
+        logMessage("  " + measure(shape + ", " + juce::String(numThreads) + " thread(s)", graph, &pool));
+      }
+    }
+
+    logMessage("  (" + juce::String(juce::SystemStats::getNumCpus()) + " cpus available)");
+  }
+
+  void ThreadDomainBenchmark::runTest()
+  {
+    constexpr int NumAudioNodes = 16;
+    constexpr int NumAnalysisNodes = 8;
+    constexpr int NumAnalysisPasses = 128; // ~16x an audio node
+    constexpr const char* Suite = "ProcessorGraph";
+
+    // NumAudioNodes -> sink, sink -> analysis nodes (in the audio or the ui domain)
+    const auto build = [&](ProcessorGraph& graph, int numAnalysisNodes, ThreadDomain analysisDomain)
+    {
+      auto* sink = new BusyProcessor();
+      const ProcessorGraph::NodeId sinkNode = graph.AddNode(std::unique_ptr<ProcessorInterface>(sink));
+      for (int i = 0; i < NumAudioNodes; ++i)
+      {
+        graph.Connect(graph.AddNode(std::make_unique<BusyProcessor>()), sinkNode);
+      }
+
+      for (int i = 0; i < numAnalysisNodes; ++i)
+      {
+        auto* analysis = new BusyProcessor(NumAnalysisPasses);
+        const ProcessorGraph::NodeId analysisNode = graph.AddNode(std::unique_ptr<ProcessorInterface>(analysis), analysisDomain);
+        graph.Connect(sinkNode, analysisNode, 256);
+
+        if (FrameMailbox* mailbox = graph.GetMailbox(sinkNode, analysisNode))
+        {
+          sink->outputs_.push_back(mailbox);
+          analysis->input_ = mailbox;
+        }
+      }
+      graph.Prepare();
+    };
+
+    // one block per repetition, as above
+    MeasureOptions options = MeasureOptions::WithIterations(1);
+    options.numWarmups = 0;
+    options.numRepetitions = 1000;
+
+    BlockTimes blockTimes(options);
+    const auto measure = [&](const juce::String& name, ProcessorGraph& graph)
+    {
+      WorkerPool pool(1);
+      blockTimes.Clear();
+      const Measurement m = Measure(Suite, name, options, [&](int)
+      {
+        const BlockTimes::Scope scope(blockTimes);
+        graph.Process(pool, ThreadDomain::Audio);
+      });
+      return m.ToString() + ", p99 " + blockTimes.Percentile(0.99) + " us, max " + blockTimes.Percentile(1.0) + " us";
+    };
+
+    beginTest(juce::String(NumAudioNodes) + " audio nodes + " + juce::String(NumAnalysisNodes) + " heavy analysis nodes (audio-thread time per block)");
+
+    {
+      ProcessorGraph graph;
+      build(graph, 0, ThreadDomain::Audio);
+      logMessage("  " + measure("no analysis", graph));
+    }
+
+    {
+      ProcessorGraph graph;
+      build(graph, NumAnalysisNodes, ThreadDomain::Audio);
+      logMessage("  " + measure("analysis in the audio domain", graph));
+    }
+
+    {
+      ProcessorGraph graph;
+      build(graph, NumAnalysisNodes, ThreadDomain::Ui);
+
+      // ui domain at ~60 Hz on its own thread
+      std::atomic<bool> bStop { false };
+      int numUiPasses = 0;
+      std::thread uiThread([&]
+      {
+        while (!bStop.load())
+        {
+          graph.Process(ThreadDomain::Ui);
+          ++numUiPasses;
+          std::this_thread::sleep_for(std::chrono::milliseconds(16));
+        }
+      });
+
+      const juce::String result = measure("analysis in the ui domain", graph);
+      bStop.store(true);
+      uiThread.join();
+
+      logMessage("  " + result + " (" + juce::String(numUiPasses) + " ui passes alongside)");
+      expect(numUiPasses > 0);
+    }
+  }
+
+} // Benchmarks
+} // Haze
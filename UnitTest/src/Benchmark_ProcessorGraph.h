@@ -0,0 +1,37 @@
+
+#pragma once
+
+#include "Benchmark.h"
+
+namespace Haze
+{
+namespace Benchmarks
+{
+
+  class ProcessorGraphBenchmark : public juce::UnitTest
+  {
+  public:
+    // ctor
+    ProcessorGraphBenchmark() : UnitTest("Processor graph, wide vs. deep, 1-16 threads", Category) {}
+
+    virtual void runTest() override final;
+
+  }; // ProcessorGraphBenchmark
+
+  static ProcessorGraphBenchmark GraphBenchmark; // static addition to the test array
+
+
+  class ThreadDomainBenchmark : public juce::UnitTest
+  {
+  public:
+    // ctor
+    ThreadDomainBenchmark() : UnitTest("Audio-thread time w/ ui-rate analysis nodes", Category) {}
+
+    virtual void runTest() override final;
+
+  }; // ThreadDomainBenchmark
+
+  static ThreadDomainBenchmark DomainBenchmark; // static addition to the test array
+
+} // Benchmarks
+} // Haze
@@ -0,0 +1,255 @@
+
+#include "BinaryPreset.h"
+#include <limits>
+
+namespace Haze
+{
+  namespace
+  {
+    using BinaryPreset::ReadLE;
+    using BinaryPreset::WriteLE;
+
+    template <typename To, typename From>
+    To BitCast(From from) noexcept
+    {
+      static_assert(sizeof(To) == sizeof(From));
+      To to;
+      std::memcpy(&to, &from, sizeof(To));
+      return to;
+    }
+
+    constexpr char Magic[4] = { 'H', 'Z', 'P', 'B' };
+
+    // appends utf-8 bytes to the string table, returns their offset
+    juce::uint32 AddString(std::vector<char>& table, const juce::String& str)
+    {
+      const auto offset = static_cast<juce::uint32>(table.size());
+      const char* utf8 = str.toRawUTF8();
+      table.insert(table.end(), utf8, utf8 + str.getNumBytesAsUTF8());
+      return offset;
+    }
+
+    // tag + payload for one parameter
+    std::pair<BinaryPreset::TypeTag, juce::uint64> EncodeValue(const UiParameter& param, std::vector<char>& table)
+    {
+      using BinaryPreset::TypeTag;
+
+      const std::type_info& type = param.Type();
+      const juce::var value = param.GetAsVar();
+
+      const auto encodeString = [&table](const juce::String& str)
+      {
+        const juce::uint64 length = str.getNumBytesAsUTF8();
+        return std::make_pair(TypeTag::String, AddString(table, str) | (length << 32));
+      };
+
+      if (type == typeid(bool))         { return { TypeTag::Bool, static_cast<bool>(value) ? 1u : 0u }; }
+      if (type == typeid(int))          { return { TypeTag::Int32, static_cast<juce::uint32>(static_cast<int>(value)) }; }
+      if (type == typeid(juce::int64))  { return { TypeTag::Int64, static_cast<juce::uint64>(static_cast<juce::int64>(value)) }; }
+      if (type == typeid(float))        { return { TypeTag::Float32, BitCast<juce::uint32>(static_cast<float>(value)) }; }
+      if (type == typeid(double))       { return { TypeTag::Float64, BitCast<juce::uint64>(static_cast<double>(value)) }; }
+      if (type == typeid(juce::String)) { return encodeString(value.toString()); }
+
+      // anything else: go by what it serializes to
+      if (value.isBool())   { return { TypeTag::Bool, static_cast<bool>(value) ? 1u : 0u }; }
+      if (value.isInt())    { return { TypeTag::Int32, static_cast<juce::uint32>(static_cast<int>(value)) }; }
+      if (value.isInt64())  { return { TypeTag::Int64, static_cast<juce::uint64>(static_cast<juce::int64>(value)) }; }
+      if (value.isDouble()) { return { TypeTag::Float64, BitCast<juce::uint64>(static_cast<double>(value)) }; }
+      return encodeString(value.toString());
+    }
+  } // namespace
+
+  void BinaryPreset::Encode(const ParameterList& list, juce::MemoryBlock& dest)
+  {
+    const int numEntries = list.GetNumParameters();
+
+    std::vector<char> table;
+    std::vector<juce::uint8> entries(EntrySize * static_cast<size_t>(numEntries));
+
+    for (int i = 0; i < numEntries; ++i)
+    {
+      const juce::String& name = list.GetName(i).toString();
+      jassert(name.getNumBytesAsUTF8() <= 0xffff);
+
+      const juce::uint32 nameOffset = AddString(table, name);
+      const auto [tag, payload] = EncodeValue(list.GetParameter(i), table);
+
+      juce::uint8* entry = entries.data() + EntrySize * static_cast<size_t>(i);
+      WriteLE<juce::uint32>(entry, nameOffset);
+      WriteLE<juce::uint16>(entry + 4, static_cast<juce::uint16>(name.getNumBytesAsUTF8()));
+      entry[6] = static_cast<juce::uint8>(tag);
+      entry[7] = 0;
+      WriteLE<juce::uint64>(entry + 8, payload);
+    }
+
+    dest.setSize(HeaderSize + entries.size() + table.size());
+    auto* out = static_cast<juce::uint8*>(dest.getData());
+
+    std::memcpy(out, Magic, sizeof(Magic));
+    WriteLE<juce::uint16>(out + 4, Version);
+    WriteLE<juce::uint16>(out + 6, 0);
+    WriteLE<juce::uint32>(out + 8, static_cast<juce::uint32>(numEntries));
+    WriteLE<juce::uint32>(out + 12, static_cast<juce::uint32>(table.size()));
+
+    std::copy(entries.begin(), entries.end(), out + HeaderSize);
+    std::copy(table.begin(), table.end(), out + HeaderSize + entries.size());
+  }
+
+// BinaryPresetView impl:
+  BinaryPresetView::BinaryPresetView(const void* data, size_t size)
+  : data_(static_cast<const juce::uint8*>(data))
+  , size_(size)
+  {
+    bIsValid_ = Validate();
+
+    if (!bIsValid_)
+    {
+      numEntries_ = 0;
+    }
+  }
+
+  bool BinaryPresetView::Validate() noexcept
+  {
+    using namespace BinaryPreset;
+
+    if (data_ == nullptr || size_ < HeaderSize || std::memcmp(data_, Magic, sizeof(Magic)) != 0)
+    {
+      return false;
+    }
+
+    if (ReadLE<juce::uint16>(data_ + 4) != Version)
+    {
+      return false;
+    }
+
+    const auto numEntries = static_cast<size_t>(ReadLE<juce::uint32>(data_ + 8));
+    const auto stringTableSize = static_cast<size_t>(ReadLE<juce::uint32>(data_ + 12));
+    if (numEntries > static_cast<size_t>(std::numeric_limits<int>::max())
+        || numEntries > (size_ - HeaderSize) / EntrySize
+        || HeaderSize + numEntries * EntrySize + stringTableSize != size_)
+    {
+      return false;
+    }
+
+    numEntries_ = static_cast<int>(numEntries);
+    strings_ = reinterpret_cast<const char*>(data_ + HeaderSize + numEntries * EntrySize);
+    stringTableSize_ = stringTableSize;
+
+    const auto isValidUtf8 = [this](size_t offset, size_t length)
+    {
+      return offset + length <= stringTableSize_
+          && juce::CharPointer_UTF8::isValidString(strings_ + offset, static_cast<int>(length));
+    };
+
+    for (int i = 0; i < numEntries_; ++i)
+    {
+      const Entry entry = ReadEntry(i);
+
+      if (entry.nameLength == 0 || !isValidUtf8(entry.nameOffset, entry.nameLength))
+      {
+        return false;
+      }
+
+      switch (entry.type)
+      {
+        case TypeTag::Bool:
+        case TypeTag::Int32:
+        case TypeTag::Int64:
+        case TypeTag::Float32:
+        case TypeTag::Float64:
+          break;
+
+        case TypeTag::String:
+          if (!isValidUtf8(static_cast<size_t>(entry.payload & 0xffffffffu), static_cast<size_t>(entry.payload >> 32)))
+          {
+            return false;
+          }
+          break;
+
+        default:
+          return false;
+      }
+    }
+
+    return true;
+  }
+
+  BinaryPresetView::Entry BinaryPresetView::ReadEntry(int index) const noexcept
+  {
+    const juce::uint8* entry = data_ + BinaryPreset::HeaderSize + BinaryPreset::EntrySize * static_cast<size_t>(index);
+    return { ReadLE<juce::uint32>(entry),
+             ReadLE<juce::uint16>(entry + 4),
+             static_cast<BinaryPreset::TypeTag>(entry[6]),
+             ReadLE<juce::uint64>(entry + 8) };
+  }
+
+  juce::Identifier BinaryPresetView::GetName(int index) const
+  {
+    jassert(juce::isPositiveAndBelow(index, numEntries_));
+    const Entry entry = ReadEntry(index);
+    const char* name = strings_ + entry.nameOffset;
+    return juce::Identifier(juce::CharPointer_UTF8(name), juce::CharPointer_UTF8(name + entry.nameLength));
+  }
+
+  BinaryPreset::TypeTag BinaryPresetView::GetType(int index) const
+  {
+    jassert(juce::isPositiveAndBelow(index, numEntries_));
+    return ReadEntry(index).type;
+  }
+
+  juce::var BinaryPresetView::GetValue(int index) const
+  {
+    using BinaryPreset::TypeTag;
+    jassert(juce::isPositiveAndBelow(index, numEntries_));
+
+    const Entry entry = ReadEntry(index);
+    switch (entry.type)
+    {
+      case TypeTag::Bool:    return juce::var(entry.payload != 0);
+      case TypeTag::Int32:   return juce::var(static_cast<int>(static_cast<juce::uint32>(entry.payload)));
+      case TypeTag::Int64:   return juce::var(static_cast<juce::int64>(entry.payload));
+      case TypeTag::Float32: return juce::var(static_cast<double>(BitCast<float>(static_cast<juce::uint32>(entry.payload))));
+      case TypeTag::Float64: return juce::var(BitCast<double>(entry.payload));
+      case TypeTag::String:
+        return juce::var(juce::String::fromUTF8(strings_ + (entry.payload & 0xffffffffu), static_cast<int>(entry.payload >> 32)));
+    }
+
+    return {};
+  }
+
+  int BinaryPresetView::ApplyTo(ParameterList& list) const
+  {
+    int numApplied = 0;
+
+    for (int i = 0; i < numEntries_; ++i)
+    {
+      const Entry entry = ReadEntry(i);
+
+      // presets written from the same layout line up by position: compare the name bytes and
+      // skip the string pool lookup entirely
+      int listIndex = IdentifierIndex::NotFound;
+      if (i < list.GetNumParameters())
+      {
+        const juce::String& name = list.GetName(i).toString();
+        if (name.getNumBytesAsUTF8() == entry.nameLength && std::memcmp(name.toRawUTF8(), strings_ + entry.nameOffset, entry.nameLength) == 0)
+        {
+          listIndex = i;
+        }
+      }
+
+      if (listIndex == IdentifierIndex::NotFound)
+      {
+        listIndex = list.IndexOf(GetName(i));
+      }
+
+      if (listIndex != IdentifierIndex::NotFound)
+      {
+        list.GetParameter(listIndex).SetAsVar(GetValue(i));
+        ++numApplied;
+      }
+    }
+
+    return numApplied;
+  }
+
+} // namespace Haze
@@ -0,0 +1,94 @@
+
+#pragma once
+
+#include "ParameterTypes.h"
+#include <cstring>
+
+namespace Haze
+{
+  // compact, versioned binary encoding of a ParameterList's values
+  //
+  // layout (all integers little-endian):
+  //   header   "HZPB" | u16 version | u16 reserved | u32 numEntries | u32 stringTableSize
+  //   entries  numEntries x { u32 nameOffset | u16 nameLength | u8 typeTag | u8 reserved | u64 payload }
+  //   strings  utf-8 bytes of every name and string value (offsets are relative to the table)
+  //
+  // entries are fixed size, so a reader indexes straight into the blob (see BinaryPresetView).
+  // payload: bool/ints as integers, floats as their IEEE bits, strings as (u32 offset | u32 length << 32)
+  namespace BinaryPreset
+  {
+    constexpr juce::uint16 Version = 1;
+    constexpr size_t HeaderSize = 16;
+    constexpr size_t EntrySize = 16;
+
+    enum class TypeTag : juce::uint8
+    {
+      Bool = 1,
+      Int32,
+      Int64,
+      Float32,
+      Float64,
+      String
+    };
+
+    // replaces dest's contents w/ the encoded list
+    void Encode(const ParameterList& list, juce::MemoryBlock& dest);
+
+    // little-endian field access (unaligned safe)
+    template <typename T>
+    T ReadLE(const juce::uint8* src) noexcept
+    {
+      T value;
+      std::memcpy(&value, src, sizeof(T));
+      return juce::ByteOrder::swapIfBigEndian(value);
+    }
+
+    template <typename T>
+    void WriteLE(juce::uint8* dest, T value) noexcept
+    {
+      value = juce::ByteOrder::swapIfBigEndian(value);
+      std::memcpy(dest, &value, sizeof(T));
+    }
+
+  } // namespace BinaryPreset
+
+
+  // zero-copy reader over an encoded preset
+  // (validates every offset up front, the memory must outlive the view)
+  class BinaryPresetView
+  {
+  public:
+    BinaryPresetView(const void* data, size_t size);
+    explicit BinaryPresetView(const juce::MemoryBlock& block) : BinaryPresetView(block.getData(), block.getSize()) {}
+
+    [[nodiscard]] bool IsValid() const noexcept { return bIsValid_; }
+    [[nodiscard]] int GetNumEntries() const noexcept { return numEntries_; }
+
+    [[nodiscard]] juce::Identifier GetName(int index) const; // pooled lookup straight from the blob's bytes
+    [[nodiscard]] BinaryPreset::TypeTag GetType(int index) const;
+    [[nodiscard]] juce::var GetValue(int index) const;
+
+    // applies every entry whose name exists in list, returns the number of entries applied
+    int ApplyTo(ParameterList& list) const;
+
+  private:
+    struct Entry
+    {
+      juce::uint32 nameOffset;
+      juce::uint16 nameLength;
+      BinaryPreset::TypeTag type;
+      juce::uint64 payload;
+    };
+
+    Entry ReadEntry(int index) const noexcept;
+    bool Validate() noexcept;
+
+    const juce::uint8* data_;
+    size_t size_;
+    int numEntries_ = 0;
+    const char* strings_ = nullptr;
+    size_t stringTableSize_ = 0;
+    bool bIsValid_ = false;
+  }; // class BinaryPresetView
+
+} // namespace Haze
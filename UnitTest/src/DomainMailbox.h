@@ -0,0 +1,87 @@
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace Haze
+{
+  // single writer / single reader mailbox for frames of samples crossing thread domains
+  // triple buffered like TripleBuffer<T>, but the writer fills its slot in place:
+  // no copies on the reader side, no allocation after construction, neither side ever waits
+  class FrameMailbox
+  {
+  public:
+    struct Frame
+    {
+      const float* data;
+      int numSamples;
+      juce::uint32 sequence; // 0: nothing published yet
+    };
+
+    // ctor
+    explicit FrameMailbox(int maxFrameSize)
+    : maxFrameSize_(juce::jmax(maxFrameSize, 1))
+    {
+      for (auto& slot : slots_)
+      {
+        slot.samples.resize(static_cast<size_t>(maxFrameSize_), 0.f);
+      }
+    }
+
+    [[nodiscard]] int GetMaxFrameSize() const noexcept { return maxFrameSize_; }
+
+    // writer side: fill BeginWrite()'s GetMaxFrameSize() samples, then publish w/ EndWrite()
+    [[nodiscard]] float* BeginWrite() noexcept { return slots_[static_cast<size_t>(writeIndex_)].samples.data(); }
+
+    void EndWrite(int numSamples) noexcept
+    {
+      Slot& slot = slots_[static_cast<size_t>(writeIndex_)];
+      slot.numSamples = juce::jlimit(0, maxFrameSize_, numSamples);
+      slot.sequence = ++sequence_;
+      writeIndex_ = middle_.exchange(writeIndex_ | DirtyBit, std::memory_order_acq_rel) & IndexMask;
+    }
+
+    void Write(const float* samples, int numSamples) noexcept
+    {
+      numSamples = juce::jlimit(0, maxFrameSize_, numSamples);
+      std::copy(samples, samples + numSamples, BeginWrite());
+      EndWrite(numSamples);
+    }
+
+    // reader side: latest published frame (valid until the next Read())
+    Frame Read() const noexcept
+    {
+      if (middle_.load(std::memory_order_relaxed) & DirtyBit)
+      {
+        readIndex_ = middle_.exchange(readIndex_, std::memory_order_acq_rel) & IndexMask;
+      }
+
+      const Slot& slot = slots_[static_cast<size_t>(readIndex_)];
+      return { slot.samples.data(), slot.numSamples, slot.sequence };
+    }
+
+  private:
+    static constexpr int IndexMask = 0x3;
+    static constexpr int DirtyBit = 0x4;
+
+    struct Slot
+    {
+      std::vector<float> samples;
+      int numSamples = 0;
+      juce::uint32 sequence = 0;
+    };
+
+    const int maxFrameSize_;
+    std::array<Slot, 3> slots_;
+    int writeIndex_ = 0;                    // writer owned
+    juce::uint32 sequence_ = 0;             // writer owned
+    mutable std::atomic<int> middle_ { 1 }; // shared
+    mutable int readIndex_ = 2;             // reader owned
+
+  }; // class FrameMailbox
+
+} // namespace Haze
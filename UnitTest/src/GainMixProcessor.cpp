@@ -0,0 +1,139 @@
+
+#include "GainMixProcessor.h"
+
+namespace Haze
+{
+  GainMixProcessor::GainMixProcessor()
+  {
+    params_
+      .add(Gain, 1.f, GainRange, {"Gain", "linear gain of the wet signal", "x"})
+      .add(Mix, 1.f, MixRange, {"Mix", "dry/wet mix", "", /*bPreferSliderOverKnob*/true})
+    ;
+
+    jassert(params_.IndexOf(Gain) == GainIndex && params_.IndexOf(Mix) == MixIndex);
+
+    gain_ = SmoothedParam(params_, Gain);
+    mix_ = SmoothedParam(params_, Mix);
+  }
+
+  void GainMixProcessor::prepare(const ProcessSpec& spec)
+  {
+    gain_.Prepare(spec.sampleRate, RampSeconds);
+    mix_.Prepare(spec.sampleRate, RampSeconds);
+
+    maxBlockSize_ = spec.maxBlockSize;
+    factor_.assign(static_cast<size_t>(maxBlockSize_), 0.f);
+    mixRamp_.assign(static_cast<size_t>(maxBlockSize_), 0.f);
+  }
+
+  void GainMixProcessor::processBlock(AudioBlockView<float> block, const BlockContext& context)
+  {
+    juce::ignoreUnused(context);
+    Process(block);
+  }
+
+  void GainMixProcessor::processBlock(AudioBlockView<double> block, const BlockContext& context)
+  {
+    juce::ignoreUnused(context);
+    Process(block);
+  }
+
+  void GainMixProcessor::exec()
+  {
+    if (maxBlockSize_ > 0)
+    {
+      events_.Dispatch(maxBlockSize_,
+                       [this](const ParameterEvent& event) { ApplyEvent(event); },
+                       [this](int, int numSamples) { RenderFactor(numSamples); });
+    }
+  }
+
+  void GainMixProcessor::ApplyEvent(const ParameterEvent& event) noexcept
+  {
+    switch (event.parameterIndex)
+    {
+      case GainIndex: gain_.SetTarget(GainRange.Clamp(event.value)); break;
+      case MixIndex: mix_.SetTarget(MixRange.Clamp(event.value)); break;
+      default: jassertfalse; break; // not one of ours
+    }
+  }
+
+  bool GainMixProcessor::RenderFactor(int numSamples) noexcept
+  {
+    float* factor = factor_.data();
+    const bool bGainMoving = gain_.RenderBlock(factor, numSamples);
+    const bool bMixMoving = mix_.RenderBlock(mixRamp_.data(), numSamples);
+
+    // factor = 1 + mix * (gain - 1), w/ the fewest passes for whatever is actually moving
+    if (bGainMoving && bMixMoving)
+    {
+      juce::FloatVectorOperations::add(factor, -1.f, numSamples);
+      juce::FloatVectorOperations::multiply(factor, mixRamp_.data(), numSamples);
+      juce::FloatVectorOperations::add(factor, 1.f, numSamples);
+    }
+    else if (bGainMoving)
+    {
+      const float mix = mix_.GetCurrent();
+      juce::FloatVectorOperations::multiply(factor, mix, numSamples);
+      juce::FloatVectorOperations::add(factor, 1.f - mix, numSamples);
+    }
+    else if (bMixMoving)
+    {
+      juce::FloatVectorOperations::multiply(factor, mixRamp_.data(), gain_.GetCurrent() - 1.f, numSamples);
+      juce::FloatVectorOperations::add(factor, 1.f, numSamples);
+    }
+
+    return bGainMoving || bMixMoving;
+  }
+
+  template <typename T>
+  void GainMixProcessor::Process(AudioBlockView<T> block) noexcept
+  {
+    jassert(maxBlockSize_ > 0); // prepare() first
+    if (maxBlockSize_ <= 0)
+    {
+      return;
+    }
+
+    events_.Dispatch(block.GetNumSamples(),
+                     [this](const ParameterEvent& event) { ApplyEvent(event); },
+                     [this, block](int startSample, int numSamples) { ProcessSubBlock(block.GetSubBlock(startSample, numSamples)); });
+  }
+
+  template <typename T>
+  void GainMixProcessor::ProcessSubBlock(AudioBlockView<T> block) noexcept
+  {
+    // blocks larger than prepared for are processed in chunks (the scratch is never resized here)
+    for (int offset = 0; offset < block.GetNumSamples(); offset += maxBlockSize_)
+    {
+      const int numSamples = juce::jmin(maxBlockSize_, block.GetNumSamples() - offset);
+      const AudioBlockView<T> chunk = block.GetSubBlock(offset, numSamples);
+
+      if (RenderFactor(numSamples))
+      {
+        for (int ch = 0; ch < chunk.GetNumChannels(); ++ch)
+        {
+          T* samples = chunk.GetChannel(ch);
+          if constexpr (std::is_same<T, float>::value)
+          {
+            juce::FloatVectorOperations::multiply(samples, factor_.data(), numSamples);
+          }
+          else
+          {
+            // (the ramp stays float, widening on the fly vectorizes just as well)
+            const float* factor = factor_.data();
+            for (int i = 0; i < numSamples; ++i)
+            {
+              samples[i] *= static_cast<double>(factor[i]);
+            }
+          }
+        }
+      }
+      else if (const float factor = GetSettledFactor(); factor != 1.f)
+      {
+        chunk.Multiply(static_cast<T>(factor));
+      }
+    }
+  }
+
+} // namespace Haze
@@ -0,0 +1,71 @@
+
+#pragma once
+
+#include "ProcessorBase.h"
+#include "ParameterSmoothing.h"
+
+namespace Haze
+{
+  // gain stage w/ a dry/wet mix: out = in * (1 - mix) + in * gain * mix
+  // both parameters are smoothed, and each block costs a handful of vectorized passes:
+  // one multiply per channel when settled, plus ~4 passes over a shared factor ramp while smoothing.
+  // queued parameter events split the block, each one starts a new ramp right at its offset
+  class GainMixProcessor : public ProcessorInterface
+  {
+  public:
+    static inline const juce::Identifier Gain { "gain" }; // linear, 0..4
+    static inline const juce::Identifier Mix { "mix" };   // 0 (dry) .. 1 (wet)
+
+    // their ParameterList positions (ParameterEvent::parameterIndex)
+    static constexpr int GainIndex = 0;
+    static constexpr int MixIndex = 1;
+
+    static constexpr ParamRange<float> GainRange { 0.f, 4.f };
+    static constexpr ParamRange<float> MixRange { 0.f, 1.f };
+
+    static constexpr double RampSeconds = 0.02;
+
+    GainMixProcessor();
+
+    const ParameterList& getUiParameterList() const override { return params_; }
+    ParameterList& GetParameterList() noexcept { return params_; }
+
+    void prepare(const ProcessSpec& spec) override;
+
+    void processBlock(AudioBlockView<float> block, const BlockContext& context) override;
+    void processBlock(AudioBlockView<double> block, const BlockContext& context) override;
+
+    // no audio to work on, only advances the smoothers (and events) by one prepared block
+    void exec() override;
+
+    ParameterEventQueue* getParameterEvents() override { return &events_; }
+
+  private:
+    template <typename T>
+    void Process(AudioBlockView<T> block) noexcept;
+
+    // one stretch w/o events, in chunks of up to maxBlockSize_
+    template <typename T>
+    void ProcessSubBlock(AudioBlockView<T> block) noexcept;
+
+    void ApplyEvent(const ParameterEvent& event) noexcept;
+
+    // fills factor_ for the next numSamples, returns false (and writes nothing) when settled
+    bool RenderFactor(int numSamples) noexcept;
+
+    [[nodiscard]] float GetSettledFactor() const noexcept { return 1.f + mix_.GetCurrent() * (gain_.GetCurrent() - 1.f); }
+
+    ParameterList params_ { ParameterList::TransportMode::Realtime };
+    SmoothedParam gain_;
+    SmoothedParam mix_;
+
+    // per-sample scratch, sized in prepare()
+    std::vector<float> factor_;
+    std::vector<float> mixRamp_;
+    int maxBlockSize_ = 0;
+
+    ParameterEventQueue events_;
+
+  }; // class GainMixProcessor
+
+} // namespace Haze
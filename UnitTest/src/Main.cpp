@@ -24,6 +24,7 @@ public:
     void initialise (const juce::String& commandLine) override
     {
         // run unit tests before launching the window
+        // (benchmarks are built into their own console app, HazeBenchmarks)
         juce::UnitTestRunner testRunner;
         testRunner.runAllTests();
 
@@ -2,12 +2,21 @@
 
 //==============================================================================
 MainComponent::MainComponent()
+    : parameterTree (processor.GetParameterList().GetStateAsTree()),
+      parameterView (processor.GetParameterList())
 {
+    processor.GetParameterList().SyncToTree (parameterTree);
+    parameterView.WatchTree (parameterTree);
+    parameterView.StartFrameUpdates();
+    addAndMakeVisible (parameterView);
+
     setSize (600, 400);
 }
 
 MainComponent::~MainComponent()
 {
+    parameterView.StopFrameUpdates();
+    processor.GetParameterList().DesyncFromTree (parameterTree);
 }
 
 //==============================================================================
@@ -18,7 +27,7 @@ void MainComponent::paint (juce::Graphics& g)
 
     g.setFont (juce::Font (16.0f));
     g.setColour (juce::Colours::white);
-    g.drawText ("Haze GUI Sandbox", getLocalBounds(), juce::Justification::centred, true);
+    g.drawText ("Haze GUI Sandbox", getLocalBounds().removeFromTop (40), juce::Justification::centred, true);
 }
 
 void MainComponent::resized()
@@ -26,4 +35,5 @@ void MainComponent::resized()
     // This is called when the MainComponent is resized.
     // If you add any child components, this is where you should
     // update their positions.
+    parameterView.setBounds (getLocalBounds().withTrimmedTop (40));
 }
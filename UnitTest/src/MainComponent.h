@@ -1,6 +1,8 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "GainMixProcessor.h"
+#include "ParameterControls.h"
 
 //==============================================================================
 /*
@@ -20,8 +22,11 @@ public:
 
 private:
     //==============================================================================
-    // Your private member variables go here...
-
+    // generated controls for a processor's parameters: tree changes (i.e. from a ParameterFeedback)
+    // only mark their entry, the view refreshes what changed once per display frame
+    Haze::GainMixProcessor processor;
+    juce::ValueTree parameterTree;
+    Haze::ParameterListView parameterView;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MainComponent)
 };
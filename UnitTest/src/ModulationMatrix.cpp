@@ -0,0 +1,113 @@
+
+#include "ModulationMatrix.h"
+#include <algorithm>
+
+namespace Haze
+{
+// ModulationMatrix impl:
+  ModulationMatrix::ModulationMatrix(ParameterList& list, int numSources)
+  : list_(list)
+  , numSources_(juce::jmax(numSources, 0))
+  {
+  }
+
+  int ModulationMatrix::AddTarget(const juce::Identifier& Name)
+  {
+    const int index = list_.IndexOf(Name);
+    jassert(index != IdentifierIndex::NotFound);
+
+    Target target { list_.GetHandle<float>(Name), 0.f, 0.f, 1.f, false };
+    if (const auto range = list_.GetParameter(index).GetUiRange())
+    {
+      target.min = static_cast<float>(range->start);
+      target.max = static_cast<float>(range->end);
+      target.span = target.max - target.min;
+      target.bClamps = true;
+    }
+
+    targets_.push_back(target);
+    depths_.resize(depths_.size() + static_cast<size_t>(numSources_), 0.f);
+    routeStart_.push_back(routeStart_.back());
+
+    // (its block comes w/ the next Prepare)
+    return GetNumTargets() - 1;
+  }
+
+  void ModulationMatrix::SetDepth(int source, int target, float depth)
+  {
+    jassert(juce::isPositiveAndBelow(source, numSources_) && juce::isPositiveAndBelow(target, GetNumTargets()));
+
+    depths_[static_cast<size_t>(target * numSources_ + source)] = depth;
+
+    // find the route among the target's (sorted by source)
+    const auto first = routeSources_.begin() + routeStart_[static_cast<size_t>(target)];
+    const auto last = routeSources_.begin() + routeStart_[static_cast<size_t>(target) + 1];
+    const auto it = std::lower_bound(first, last, source);
+    const auto position = it - routeSources_.begin();
+    const bool bExists = it != last && *it == source;
+
+    if (bExists && depth != 0.f)
+    {
+      routeDepths_[static_cast<size_t>(position)] = depth * targets_[static_cast<size_t>(target)].span;
+      return;
+    }
+
+    int shift = 0;
+    if (bExists)
+    {
+      routeSources_.erase(it);
+      routeDepths_.erase(routeDepths_.begin() + position);
+      shift = -1;
+    }
+    else if (depth != 0.f)
+    {
+      routeSources_.insert(it, source);
+      routeDepths_.insert(routeDepths_.begin() + position, depth * targets_[static_cast<size_t>(target)].span);
+      shift = 1;
+    }
+
+    for (size_t t = static_cast<size_t>(target) + 1; t < routeStart_.size(); ++t)
+    {
+      routeStart_[t] += shift;
+    }
+  }
+
+  float ModulationMatrix::GetDepth(int source, int target) const
+  {
+    jassert(juce::isPositiveAndBelow(source, numSources_) && juce::isPositiveAndBelow(target, GetNumTargets()));
+    return depths_[static_cast<size_t>(target * numSources_ + source)];
+  }
+
+  void ModulationMatrix::Prepare(int maxBlockSize)
+  {
+    maxBlockSize_ = maxBlockSize;
+    sources_.SetSize(numSources_, maxBlockSize);
+    values_.SetSize(GetNumTargets(), maxBlockSize);
+  }
+
+  void ModulationMatrix::RenderBlock(int numSamples) noexcept
+  {
+    jassert(numSamples <= maxBlockSize_ && values_.GetNumChannels() == GetNumTargets());
+
+    for (size_t t = 0; t < targets_.size(); ++t)
+    {
+      const Target& target = targets_[t];
+      float* values = values_.GetChannel(static_cast<int>(t));
+
+      juce::FloatVectorOperations::fill(values, static_cast<float>(target.param.Load()), numSamples);
+
+      const int routeEnd = routeStart_[t + 1];
+      for (int route = routeStart_[t]; route < routeEnd; ++route)
+      {
+        juce::FloatVectorOperations::addWithMultiply(values, sources_.GetChannel(routeSources_[static_cast<size_t>(route)]),
+                                                     routeDepths_[static_cast<size_t>(route)], numSamples);
+      }
+
+      if (target.bClamps && routeEnd > routeStart_[t])
+      {
+        juce::FloatVectorOperations::clip(values, values, target.min, target.max, numSamples);
+      }
+    }
+  }
+
+} // namespace Haze
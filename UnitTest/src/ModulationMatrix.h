@@ -0,0 +1,75 @@
+
+#pragma once
+
+#include "ParameterTypes.h"
+#include "AudioBlock.h"
+#include <vector>
+
+namespace Haze
+{
+  // block-rate modulation of many ParamType<float> targets by many sources (LFOs, envelopes, ...):
+  //   value[t][i] = clamp(base[t] + sum over s of depth[s][t] * range[t] * source[s][i])
+  // the base is the parameter's own value (ParamHandle::Load) and is never written: modulated blocks live here.
+  //
+  // routes are kept grouped by target in flat arrays (source index + depth pre-scaled by the target's range),
+  // so a block costs one fill, one multiply-add per route and one clip per target, each a juce::FloatVectorOperations
+  // pass over the block, instead of a Get<float>() / operator= per target and sample
+  class ModulationMatrix
+  {
+  public:
+    // ctor
+    ModulationMatrix(ParameterList& list, int numSources);
+
+    // setup (message thread, allocates, not while RenderBlock runs)
+    // returns the target's index. ranged targets are modulated across and clamped into their ParamRange
+    int AddTarget(const juce::Identifier& Name);
+
+    // depth: fraction of the target's range per unit of source (source values are usually -1..1 or 0..1).
+    // a depth of 0 removes the route
+    void SetDepth(int source, int target, float depth);
+    [[nodiscard]] float GetDepth(int source, int target) const;
+
+    // sizes the source and target blocks
+    void Prepare(int maxBlockSize);
+
+    [[nodiscard]] int GetNumSources() const noexcept { return numSources_; }
+    [[nodiscard]] int GetNumTargets() const noexcept { return static_cast<int>(targets_.size()); }
+    [[nodiscard]] int GetNumRoutes() const noexcept { return static_cast<int>(routeSources_.size()); }
+
+    // audio thread (never allocates): every source writes its next numSamples into its buffer, then RenderBlock
+    [[nodiscard]] float* GetSourceBuffer(int source) const noexcept { return sources_.GetChannel(source); }
+
+    void RenderBlock(int numSamples) noexcept;
+
+    // modulated values of the last RenderBlock
+    [[nodiscard]] const float* GetTargetValues(int target) const noexcept { return values_.GetChannel(target); }
+
+  private:
+    struct Target
+    {
+      ParamHandle<float> param;
+      float min;
+      float max;
+      float span;   // (1 w/o a range)
+      bool bClamps; // (has a range)
+    };
+
+    ParameterList& list_;
+    const int numSources_;
+    int maxBlockSize_ = 0;
+
+    std::vector<Target> targets_;
+    std::vector<float> depths_; // as set, [target * numSources_ + source]
+
+    // routes, grouped by target and sorted by source: target t's are [routeStart_[t], routeStart_[t + 1])
+    std::vector<int> routeStart_ { 0 };
+    std::vector<int> routeSources_;
+    std::vector<float> routeDepths_; // (depth * span)
+
+    AlignedAudioBuffer<float> sources_; // one channel per source
+    AlignedAudioBuffer<float> values_;  // one channel per target
+
+    JUCE_DECLARE_NON_COPYABLE(ModulationMatrix)
+  }; // class ModulationMatrix
+
+} // namespace Haze
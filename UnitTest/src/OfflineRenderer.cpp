@@ -0,0 +1,198 @@
+
+#include "OfflineRenderer.h"
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <thread>
+
+namespace Haze
+{
+  namespace
+  {
+    double SecondsSince(juce::int64 startTicks) noexcept
+    {
+      return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+    }
+  } // namespace
+
+// OfflineRenderer::Summary impl:
+  int OfflineRenderer::Summary::GetNumFailed() const noexcept
+  {
+    return static_cast<int>(std::count_if(jobs.begin(), jobs.end(), [](const JobResult& job) { return !job.WasSuccessful(); }));
+  }
+
+  double OfflineRenderer::Summary::GetAudioSeconds() const noexcept
+  {
+    double total = 0.0;
+    for (const JobResult& job : jobs)
+    {
+      total += job.GetAudioSeconds();
+    }
+    return total;
+  }
+
+  double OfflineRenderer::Summary::GetRealtimeFactor(int worker) const noexcept
+  {
+    double audioSeconds = 0.0;
+    double busySeconds = 0.0;
+    for (const JobResult& job : jobs)
+    {
+      if (job.worker == worker)
+      {
+        audioSeconds += job.GetAudioSeconds();
+        busySeconds += job.seconds;
+      }
+    }
+    return busySeconds > 0.0 ? audioSeconds / busySeconds : 0.0;
+  }
+
+// OfflineRenderer impl:
+  OfflineRenderer::OfflineRenderer(GraphBuilder builder, RenderSettings settings)
+  : builder_(std::move(builder))
+  , settings_(settings)
+  {
+    jassert(builder_ != nullptr);
+    jassert(settings_.blockSize > 0);
+  }
+
+  OfflineRenderer::Summary OfflineRenderer::Render(const std::vector<Job>& jobs) const
+  {
+    Summary summary;
+    summary.jobs.resize(jobs.size());
+
+    // two jobs writing one file would delete and write it concurrently: the later ones fail up front
+    std::vector<bool> bIsRunnable(jobs.size(), true);
+    std::map<juce::File, size_t> firstWriter;
+    for (size_t job = 0; job < jobs.size(); ++job)
+    {
+      if (const auto [existing, bIsNew] = firstWriter.emplace(jobs[job].output, job); !bIsNew)
+      {
+        summary.jobs[job].error = jobs[job].output.getFullPathName() + " is already written by " + jobs[existing->second].input.getFullPathName();
+        bIsRunnable[job] = false;
+      }
+    }
+
+    const int numCpus = settings_.numThreads > 0 ? settings_.numThreads : juce::SystemStats::getNumCpus();
+    summary.numThreads = juce::jlimit(1, juce::jmax(1, static_cast<int>(jobs.size())), numCpus);
+
+    // workers pull the next file off a shared counter (the calling thread is worker 0)
+    std::atomic<size_t> nextJob { 0 };
+    const auto work = [&](int worker)
+    {
+      for (size_t job = nextJob.fetch_add(1); job < jobs.size(); job = nextJob.fetch_add(1))
+      {
+        if (!bIsRunnable[job])
+        {
+          continue;
+        }
+
+        summary.jobs[job] = RenderFile(jobs[job]);
+        summary.jobs[job].worker = worker;
+      }
+    };
+
+    const juce::int64 start = juce::Time::getHighResolutionTicks();
+
+    std::vector<std::thread> workers;
+    for (int worker = 1; worker < summary.numThreads; ++worker)
+    {
+      workers.emplace_back(work, worker);
+    }
+    work(0);
+
+    for (std::thread& worker : workers)
+    {
+      worker.join();
+    }
+
+    summary.wallSeconds = SecondsSince(start);
+    return summary;
+  }
+
+  OfflineRenderer::JobResult OfflineRenderer::RenderFile(const Job& job) const
+  {
+    const juce::int64 start = juce::Time::getHighResolutionTicks();
+    JobResult result;
+
+    // (one manager per job, so workers share nothing)
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(job.input));
+    if (reader == nullptr)
+    {
+      result.error = "can't read " + job.input.getFullPathName();
+      return result;
+    }
+
+    // (FileOutputStream appends to an existing file)
+    job.output.deleteFile();
+    std::unique_ptr<juce::FileOutputStream> stream(job.output.createOutputStream());
+
+    const int bitsPerSample = settings_.bitsPerSample > 0 ? settings_.bitsPerSample : static_cast<int>(reader->bitsPerSample);
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer(stream != nullptr
+      ? wav.createWriterFor(stream.get(), reader->sampleRate, reader->numChannels, bitsPerSample, {}, 0)
+      : nullptr);
+
+    if (writer == nullptr)
+    {
+      result.error = "can't write " + job.output.getFullPathName();
+      return result;
+    }
+    stream.release(); // (the writer owns it now)
+
+    result = RenderStream(*reader, *writer);
+    writer.reset(); // (flushes)
+
+    result.seconds = SecondsSince(start);
+    return result;
+  }
+
+  OfflineRenderer::JobResult OfflineRenderer::RenderStream(juce::AudioFormatReader& reader, juce::AudioFormatWriter& writer) const
+  {
+    const juce::int64 start = juce::Time::getHighResolutionTicks();
+
+    JobResult result;
+    result.sampleRate = reader.sampleRate;
+
+    const int numChannels = static_cast<int>(reader.numChannels);
+    if (numChannels <= 0 || reader.sampleRate <= 0.0)
+    {
+      result.error = "no audio";
+      return result;
+    }
+
+    ProcessorGraph graph;
+    builder_(graph);
+    graph.Prepare({ reader.sampleRate, settings_.blockSize, numChannels });
+
+    juce::AudioBuffer<float> buffer(numChannels, settings_.blockSize);
+    for (juce::int64 position = 0; position < reader.lengthInSamples; position += settings_.blockSize)
+    {
+      const int numSamples = static_cast<int>(juce::jmin(static_cast<juce::int64>(settings_.blockSize), reader.lengthInSamples - position));
+
+      if (!reader.read(&buffer, 0, numSamples, position, true, true))
+      {
+        result.error = "read failed at sample " + juce::String(position);
+        return result;
+      }
+
+      const juce::int64 processStart = juce::Time::getHighResolutionTicks();
+      graph.ProcessBlock({ buffer.getArrayOfWritePointers(), numChannels, numSamples }, { reader.sampleRate, position });
+      result.processSeconds += SecondsSince(processStart);
+
+      if (!writer.writeFromAudioSampleBuffer(buffer, 0, numSamples))
+      {
+        result.error = "write failed at sample " + juce::String(position);
+        return result;
+      }
+
+      result.numSamples += numSamples;
+    }
+
+    result.seconds = SecondsSince(start);
+    return result;
+  }
+
+} // namespace Haze
@@ -0,0 +1,83 @@
+
+#pragma once
+
+#include "ProcessorGraph.h"
+#include <functional>
+
+namespace Haze
+{
+  // OfflineRenderer options
+  struct RenderSettings
+  {
+    int blockSize = 512;
+    int numThreads = 0;    // 0: one per cpu
+    int bitsPerSample = 0; // of the written wav files, 0: same as the input
+  };
+
+
+  // renders audio files through a ProcessorGraph as fast as the cpu allows (no realtime pacing)
+  //
+  // every file gets its own graph, built by the GraphBuilder on the thread that renders it
+  // (processors are never shared between threads), and files are spread over numThreads workers.
+  // each worker streams its file block by block: read -> ProcessBlock() -> write
+  class OfflineRenderer
+  {
+  public:
+    // adds processors/edges to an empty graph (called concurrently from the worker threads)
+    using GraphBuilder = std::function<void(ProcessorGraph&)>;
+
+    struct Job
+    {
+      juce::File input;
+      juce::File output; // (always written as wav)
+    };
+
+    struct JobResult
+    {
+      juce::String error; // empty on success
+      juce::int64 numSamples = 0;
+      double sampleRate = 0.0;
+      double seconds = 0.0;        // wall time for the whole job, file i/o included
+      double processSeconds = 0.0; // ProcessBlock() only
+      int worker = -1;
+
+      [[nodiscard]] bool WasSuccessful() const noexcept { return error.isEmpty(); }
+      [[nodiscard]] double GetAudioSeconds() const noexcept { return sampleRate > 0.0 ? static_cast<double>(numSamples) / sampleRate : 0.0; }
+      [[nodiscard]] double GetRealtimeFactor() const noexcept { return seconds > 0.0 ? GetAudioSeconds() / seconds : 0.0; }
+    };
+
+    struct Summary
+    {
+      std::vector<JobResult> jobs; // (same order as the jobs passed in)
+      double wallSeconds = 0.0;
+      int numThreads = 0;
+
+      [[nodiscard]] int GetNumFailed() const noexcept;
+      [[nodiscard]] double GetAudioSeconds() const noexcept;
+
+      // audio seconds per wall second across all workers
+      [[nodiscard]] double GetThroughput() const noexcept { return wallSeconds > 0.0 ? GetAudioSeconds() / wallSeconds : 0.0; }
+
+      // audio seconds per busy second of one worker (0 for a worker that got no jobs)
+      [[nodiscard]] double GetRealtimeFactor(int worker) const noexcept;
+    };
+
+    explicit OfflineRenderer(GraphBuilder builder, RenderSettings settings = {});
+
+    // blocks until every job is done
+    // (a job whose output an earlier job already writes fails w/o touching the file)
+    [[nodiscard]] Summary Render(const std::vector<Job>& jobs) const;
+
+    // one file on the calling thread
+    [[nodiscard]] JobResult RenderFile(const Job& job) const;
+
+    // what Render() does per file, for any reader/writer pair (reader and writer channel counts must match)
+    [[nodiscard]] JobResult RenderStream(juce::AudioFormatReader& reader, juce::AudioFormatWriter& writer) const;
+
+  private:
+    const GraphBuilder builder_;
+    const RenderSettings settings_;
+
+  }; // class OfflineRenderer
+
+} // namespace Haze
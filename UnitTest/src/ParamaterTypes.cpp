@@ -12,60 +12,283 @@
 
 namespace Haze
 {
-// UiParameter impl:
-    void UiParameter::SetInPlaceClamper(std::function<void(juce::var&)>&& lambda)
+// ParameterSchema impl:
+    int ParameterSchema::FindGroup(const juce::Identifier& Name) const
     {
-        InPlaceClamper = lambda;
+      for (size_t group = 1; group < groups_.size(); ++group)
+      {
+        if (groups_[group].id == Name)
+        {
+          return static_cast<int>(group);
+        }
+      }
+      return -1;
     }
 
-    std::function<void(juce::var&)>& UiParameter::GetInPlaceClamper()
+    ParameterSchema::Ptr ParameterSchema::Clone() const
     {
-        return InPlaceClamper;
+      Ptr copy = new ParameterSchema();
+      copy->entries_.reserve(entries_.size());
+      for (const Entry& entry : entries_)
+      {
+        copy->entries_.push_back(Entry { entry.id, entry.defaultValue->Clone(), entry.group, entry.metadata });
+      }
+      copy->groups_ = groups_;
+      copy->index_ = index_;
+
+      return copy;
     }
 
 // ParameterList impl:
+    ParameterList::ParameterList(TransportMode transport)
+    : schema_(new ParameterSchema())
+    , transport_(transport)
+    {
+    }
+
+    ParameterList::ParameterList(ParameterSchema::Ptr schema, TransportMode transport)
+    : schema_(std::move(schema))
+    , transport_(transport)
+    {
+      jassert(schema_ != nullptr);
+
+      values_.reserve(static_cast<size_t>(schema_->GetNumParameters()));
+      for (int index = 0; index < schema_->GetNumParameters(); ++index)
+      {
+        values_.push_back(MakeValue(index));
+      }
+    }
+
+    ParameterSchema& ParameterList::EditSchema()
+    {
+      // (other lists hold on to the schema as it is)
+      if (schema_->getReferenceCount() > 1)
+      {
+        schema_ = schema_->Clone();
+      }
+      return *schema_;
+    }
+
+    void ParameterList::AddEntry(const juce::Identifier& Name, std::unique_ptr<UiParameter>&& defaultValue, UiMetadata&& MetaData)
+    {
+      ParameterSchema& schema = EditSchema();
+      const int index = schema.GetNumParameters();
+
+      // check for name collision (previous entry will be stomped!)
+      const bool bIsNewName = schema.index_.Insert(Name, index);
+      jassert(bIsNewName);
+      juce::ignoreUnused(bIsNewName);
+
+      // (no ui is built here: controls are generated on demand, see CreateComponent)
+      schema.groups_[static_cast<size_t>(currentGroup_)].parameters.push_back(index);
+      schema.entries_.push_back(ParameterSchema::Entry { Name, std::move(defaultValue), currentGroup_, std::move(MetaData) });
+
+      values_.push_back(MakeValue(index));
+    }
+
+    std::unique_ptr<UiParameter> ParameterList::MakeValue(int index) const
+    {
+      auto value = schema_->GetDefault(index).Clone();
+      if (transport_ == TransportMode::Realtime)
+      {
+        value->EnableRealtimeTransport();
+      }
+      return value;
+    }
+
     // index operator for juce::Identifier
-    std::unique_ptr<UiParameter>& ParameterList::operator[](const juce::Identifier Name)
+    std::unique_ptr<UiParameter>& ParameterList::operator[](const juce::Identifier& Name)
+    {
+      return *FindValueByName(Name);
+    }
+
+    // groups
+    ParameterList& ParameterList::BeginGroup(const juce::Identifier& Name)
+    {
+      // group names double as tree types, and are looked up by name
+      jassert(FindGroup(Name) < 0);
+
+      ParameterSchema& schema = EditSchema();
+      const int group = schema.GetNumGroups();
+      schema.groups_.push_back(ParameterSchema::Group { Name, currentGroup_, {}, {} });
+      schema.groups_[static_cast<size_t>(currentGroup_)].children.push_back(group);
+      currentGroup_ = group;
+
+      return *this;
+    }
+
+    ParameterList& ParameterList::EndGroup()
     {
-      return FindEntryByName(Name, parameters_)->paramPtr;
+      jassert(currentGroup_ != RootGroup); // EndGroup w/o BeginGroup
+      currentGroup_ = juce::jmax(RootGroup, GetParentGroup(currentGroup_));
+
+      return *this;
     }
-    
+
     // juce::ValueTree sync
     juce::ValueTree ParameterList::GetStateAsTree() const
     {
-      static juce::Identifier ParamList("Parameter_List");
-      juce::ValueTree listTree(ParamList);
-      
-      for(const auto& entry : parameters_)
+      return GetGroupStateAsTree(RootGroup);
+    }
+
+    juce::ValueTree ParameterList::GetGroupStateAsTree(int group) const
+    {
+      const ParameterSchema::Group& node = schema_->GetGroup(group);
+      juce::ValueTree groupTree(node.id);
+
+      for (const int index : node.parameters)
+      {
+        groupTree.setProperty(GetName(index), juce::var(GetParameter(index).GetAsVar()), nullptr);
+      }
+
+      for (const int child : node.children)
+      {
+        groupTree.appendChild(GetGroupStateAsTree(child), nullptr);
+      }
+
+      return groupTree;
+    }
+
+    juce::ValueTree ParameterList::GetGroupTree(const juce::ValueTree& root, int group) const
+    {
+      if (group == RootGroup)
       {
-        listTree.setProperty(entry.id, juce::var(entry.paramPtr->GetAsVar()), nullptr);
+        return root;
       }
 
-      return listTree;
+      const juce::ValueTree parentTree = GetGroupTree(root, GetParentGroup(group));
+      return parentTree.isValid() ? parentTree.getChildWithName(GetGroupName(group)) : juce::ValueTree();
     }
 
     void ParameterList::SyncToTree(juce::ValueTree& inTree)
     {
       // take on the current state of inTree
-      const int numProperties = inTree.getNumProperties();
+      RestoreFromTree(inTree);
+
+      AttachGroup(RootGroup, inTree, inTree);
+    }
+
+    void ParameterList::AttachGroup(int group, juce::ValueTree& tree, const juce::ValueTree& root)
+    {
+      groupSyncs_.push_back(std::make_unique<GroupSync>(*this, group, tree, root));
+
+      for (const int child : schema_->GetGroup(group).children)
+      {
+        juce::ValueTree childTree = tree.getChildWithName(GetGroupName(child));
+        if (!childTree.isValid())
+        {
+          childTree = GetGroupStateAsTree(child);
+          tree.appendChild(childTree, nullptr);
+        }
+
+        AttachGroup(child, childTree, root);
+      }
+    }
+
+    void ParameterList::RestoreFromTree(const juce::ValueTree& inTree)
+    {
+      RestoreGroup(RootGroup, inTree);
+    }
+
+    void ParameterList::RestoreGroup(int group, const juce::ValueTree& groupTree)
+    {
+      ForEachTreeValue(group, groupTree, [this](int index, const juce::var& value)
+      {
+        values_[static_cast<size_t>(index)]->SetAsVar(value);
+      });
+    }
+
+    template <typename Fn>
+    void ParameterList::ForEachTreeValue(int group, const juce::ValueTree& tree, Fn&& fn) const
+    {
+      const int numProperties = tree.getNumProperties();
       for (int i = 0; i < numProperties; ++i)
       {
-        juce::Identifier name (inTree.getPropertyName(i));
-        FindEntryByName(name, parameters_)->paramPtr->SetAsVar(inTree.getProperty(name));
+        const juce::Identifier name (tree.getPropertyName(i));
+        if (const int index = IndexAtPosition(group, i, name); index != IdentifierIndex::NotFound)
+        {
+          fn(index, tree.getProperty(name));
+        }
+      }
+
+      // child group i is usually child tree i
+      const std::vector<int>& children = schema_->GetGroup(group).children;
+      for (size_t i = 0; i < children.size(); ++i)
+      {
+        const juce::Identifier& childName = GetGroupName(children[i]);
+        juce::ValueTree childTree = tree.getChild(static_cast<int>(i));
+        if (!childTree.hasType(childName))
+        {
+          childTree = tree.getChildWithName(childName);
+        }
+
+        if (childTree.isValid())
+        {
+          ForEachTreeValue(children[i], childTree, fn);
+        }
+      }
+    }
+
+    // bulk state capture/restore
+    void ParameterList::CaptureSnapshot(ParameterSnapshot& snapshot) const
+    {
+      snapshot.values.resize(values_.size());
+
+      for (size_t i = 0; i < values_.size(); ++i)
+      {
+        snapshot.values[i] = values_[i]->GetAsVar();
+      }
+    }
+
+    void ParameterList::CaptureSnapshot(const juce::ValueTree& inTree, ParameterSnapshot& snapshot) const
+    {
+      // start from the current values, so a partial tree still gives a complete snapshot
+      CaptureSnapshot(snapshot);
+
+      ForEachTreeValue(RootGroup, inTree, [&snapshot](int index, const juce::var& value)
+      {
+        snapshot.values[static_cast<size_t>(index)] = value;
+      });
+    }
+
+    void ParameterList::RestoreSnapshot(const ParameterSnapshot& snapshot)
+    {
+      // a snapshot only fits the list (layout) it was captured from
+      jassert(snapshot.values.size() == values_.size());
+
+      for (size_t i = 0; i < values_.size(); ++i)
+      {
+        values_[i]->SetAsVar(snapshot.values[i]);
       }
-      
-      inTree.addListener(this);
     }
 
     void ParameterList::DesyncFromTree(juce::ValueTree& inTree)
     {
-      inTree.removeListener(this);
+      groupSyncs_.erase(std::remove_if(groupSyncs_.begin(), groupSyncs_.end(),
+                                       [&inTree](const auto& sync) { return sync->GetRoot() == inTree; }),
+                        groupSyncs_.end());
+    }
+
+    void ParameterList::SetFromTree(int group, const juce::ValueTree& tree, const juce::Identifier& property)
+    {
+      auto* value = FindValueByName(property);
+      jassert(value == nullptr || GetGroupOf(IndexOf(property)) == group); // (a parameter written into another group's tree)
+      juce::ignoreUnused(group);
+
+      if (value != nullptr)
+      {
+        (*value)->SetAsVar(tree.getProperty(property));
+      }
     }
 
-    // value tree listener callback
-    void ParameterList::valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property)
+// ParameterList::GroupSync impl:
+    void ParameterList::GroupSync::valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property)
     {
-      FindEntryByName(property, parameters_)->paramPtr->SetAsVar(tree.getProperty(property));
+      // (changes in child groups' trees bubble up to here, they have their own GroupSync)
+      if (tree == tree_)
+      {
+        list_.SetFromTree(group_, tree, property);
+      }
     }
 
 } // namespace Haze
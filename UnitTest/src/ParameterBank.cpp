@@ -0,0 +1,169 @@
+
+#include "ParameterBank.h"
+
+namespace Haze
+{
+  template <typename T>
+  ParameterBank& ParameterBank::AddEntry(const juce::Identifier& Name, T DefaultValue, UiMetadata&& MetaData)
+  {
+    // check for name collision (previous entry will be stomped!)
+    const bool bIsNewName = index_.Insert(Name, GetNumParameters());
+    jassert(bIsNewName);
+    juce::ignoreUnused(bIsNewName);
+
+    auto& column = GetColumn<T>();
+    slots_.push_back({ TypeOf<T>(), column.size() });
+    column.push_back(DefaultValue);
+
+    ids_.push_back(Name);
+    metadata_.push_back(std::move(MetaData));
+    return *this;
+  }
+
+  ParameterBank& ParameterBank::add(const juce::Identifier& Name, float DefaultValue, UiMetadata&& MetaData)
+  {
+    return AddEntry(Name, DefaultValue, std::move(MetaData));
+  }
+
+  ParameterBank& ParameterBank::add(const juce::Identifier& Name, int DefaultValue, UiMetadata&& MetaData)
+  {
+    return AddEntry(Name, DefaultValue, std::move(MetaData));
+  }
+
+  ParameterBank& ParameterBank::add(const juce::Identifier& Name, bool DefaultValue, UiMetadata&& MetaData)
+  {
+    return AddEntry(Name, DefaultValue, std::move(MetaData));
+  }
+
+  ParameterBank ParameterBank::FromList(const ParameterList& list)
+  {
+    ParameterBank bank;
+    for (int i = 0; i < list.GetNumParameters(); ++i)
+    {
+      const UiParameter& param = list.GetParameter(i);
+      const std::type_info& type = param.Type();
+      UiMetadata metadata = list.GetMetadata(i);
+
+      if (type == typeid(float))
+      {
+        bank.add(list.GetName(i), static_cast<float>(param.GetAsVar()), std::move(metadata));
+      }
+      else if (type == typeid(int))
+      {
+        bank.add(list.GetName(i), static_cast<int>(param.GetAsVar()), std::move(metadata));
+      }
+      else if (type == typeid(bool))
+      {
+        bank.add(list.GetName(i), static_cast<bool>(param.GetAsVar()), std::move(metadata));
+      }
+    }
+
+    return bank;
+  }
+
+  void ParameterBank::CaptureFrom(const ParameterList& list)
+  {
+    for (int i = 0; i < GetNumParameters(); ++i)
+    {
+      const int listIndex = list.IndexOf(ids_[static_cast<size_t>(i)]);
+      jassert(listIndex != IdentifierIndex::NotFound);
+
+      const UiParameter& param = list.GetParameter(listIndex);
+      const Slot slot = slots_[static_cast<size_t>(i)];
+      switch (slot.type)
+      {
+        case ValueType::Float: floats_[slot.column] = param.Get<float>(); break;
+        case ValueType::Int:   ints_[slot.column] = param.Get<int>(); break;
+        case ValueType::Bool:  bools_[slot.column] = param.Get<bool>(); break;
+      }
+    }
+  }
+
+  void ParameterBank::ApplyTo(ParameterList& list) const
+  {
+    for (int i = 0; i < GetNumParameters(); ++i)
+    {
+      const int listIndex = list.IndexOf(ids_[static_cast<size_t>(i)]);
+      jassert(listIndex != IdentifierIndex::NotFound);
+
+      UiParameter& param = list.GetParameter(listIndex);
+      const Slot slot = slots_[static_cast<size_t>(i)];
+      switch (slot.type)
+      {
+        case ValueType::Float: param = floats_[slot.column]; break;
+        case ValueType::Int:   param = ints_[slot.column]; break;
+        case ValueType::Bool:  param = bools_[slot.column]; break;
+      }
+    }
+  }
+
+  juce::var ParameterBank::GetAsVar(int index) const
+  {
+    const Slot slot = GetSlot(index);
+    switch (slot.type)
+    {
+      case ValueType::Float: return juce::var(floats_[slot.column]);
+      case ValueType::Int:   return juce::var(ints_[slot.column]);
+      case ValueType::Bool:  return juce::var(bools_[slot.column]);
+    }
+
+    return {};
+  }
+
+  void ParameterBank::SetAsVar(int index, const juce::var& inVar)
+  {
+    const Slot slot = GetSlot(index);
+    switch (slot.type)
+    {
+      case ValueType::Float: floats_[slot.column] = inVar; break;
+      case ValueType::Int:   ints_[slot.column] = inVar; break;
+      case ValueType::Bool:  bools_[slot.column] = inVar; break;
+    }
+  }
+
+  // juce::ValueTree sync
+  juce::ValueTree ParameterBank::GetStateAsTree() const
+  {
+    static juce::Identifier ParamList("Parameter_List");
+    juce::ValueTree listTree(ParamList);
+
+    for (int i = 0; i < GetNumParameters(); ++i)
+    {
+      listTree.setProperty(ids_[static_cast<size_t>(i)], GetAsVar(i), nullptr);
+    }
+
+    return listTree;
+  }
+
+  void ParameterBank::SyncToTree(juce::ValueTree& inTree)
+  {
+    // take on the current state of inTree
+    const int numProperties = inTree.getNumProperties();
+    for (int i = 0; i < numProperties; ++i)
+    {
+      const juce::Identifier name (inTree.getPropertyName(i));
+      if (const int index = IndexOf(name); index != IdentifierIndex::NotFound)
+      {
+        SetAsVar(index, inTree.getProperty(name));
+      }
+    }
+
+    inTree.addListener(this);
+  }
+
+  void ParameterBank::DesyncFromTree(juce::ValueTree& inTree)
+  {
+    inTree.removeListener(this);
+  }
+
+  // value tree listener callback
+  void ParameterBank::valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property)
+  {
+    // (properties the bank doesn't know are someone else's)
+    if (const int index = IndexOf(property); index != IdentifierIndex::NotFound)
+    {
+      SetAsVar(index, tree.getProperty(property));
+    }
+  }
+
+} // namespace Haze
@@ -0,0 +1,197 @@
+
+#pragma once
+
+#include "ParameterTypes.h"
+#include <new>
+
+namespace Haze
+{
+  // growable array of trivially copyable T, cache-line aligned so columns can be swept w/ SIMD
+  template <typename T>
+  class AlignedColumn
+  {
+  public:
+    static_assert(std::is_trivially_copyable<T>::value);
+    static constexpr size_t Alignment = 64;
+
+    AlignedColumn() = default;
+    AlignedColumn(const AlignedColumn& other) { *this = other; }
+    AlignedColumn(AlignedColumn&& other) noexcept { swap(other); }
+    ~AlignedColumn() { Free(data_); }
+
+    AlignedColumn& operator=(const AlignedColumn& other)
+    {
+      if (this != &other)
+      {
+        AlignedColumn copy;
+        copy.reserve(other.size_);
+        std::copy(other.begin(), other.end(), copy.data_);
+        copy.size_ = other.size_;
+        swap(copy);
+      }
+      return *this;
+    }
+
+    AlignedColumn& operator=(AlignedColumn&& other) noexcept { swap(other); return *this; }
+
+    void swap(AlignedColumn& other) noexcept
+    {
+      std::swap(data_, other.data_);
+      std::swap(size_, other.size_);
+      std::swap(capacity_, other.capacity_);
+    }
+
+    void reserve(int newCapacity)
+    {
+      if (newCapacity > capacity_)
+      {
+        T* newData = Allocate(newCapacity);
+        std::copy(begin(), end(), newData);
+        Free(data_);
+        data_ = newData;
+        capacity_ = newCapacity;
+      }
+    }
+
+    void push_back(const T& value)
+    {
+      if (size_ == capacity_)
+      {
+        reserve(juce::jmax(16, capacity_ * 2));
+      }
+      data_[size_++] = value;
+    }
+
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+    int size() const noexcept { return size_; }
+
+    T& operator[](int i) noexcept { return data_[i]; }
+    const T& operator[](int i) const noexcept { return data_[i]; }
+
+    T* begin() noexcept { return data_; }
+    T* end() noexcept { return data_ + size_; }
+    const T* begin() const noexcept { return data_; }
+    const T* end() const noexcept { return data_ + size_; }
+
+  private:
+    static T* Allocate(int count)
+    {
+      return static_cast<T*>(::operator new(sizeof(T) * static_cast<size_t>(count), std::align_val_t(Alignment)));
+    }
+
+    static void Free(T* ptr) noexcept
+    {
+      if (ptr != nullptr)
+      {
+        ::operator delete(ptr, std::align_val_t(Alignment));
+      }
+    }
+
+    T* data_ = nullptr;
+    int size_ = 0;
+    int capacity_ = 0;
+  }; // AlignedColumn<T>
+
+
+  // structure-of-arrays alternative to ParameterList storage
+  //
+  // values of each type live contiguously in their own aligned column (all floats together, all ints
+  // together, ...), so a processor can snapshot or sweep every float parameter in one pass.
+  // ids + UiMetadata are kept apart (cold), and never touched by value access.
+  // like ParameterList in TransportMode::Direct, the columns are plain memory (single threaded use)
+  class ParameterBank : public juce::ValueTree::Listener
+  {
+  public:
+    enum class ValueType : juce::uint8
+    {
+      Float,
+      Int,
+      Bool
+    };
+
+    // where an entry's value lives
+    struct Slot
+    {
+      ValueType type;
+      int column; // position within that type's column
+    };
+
+    // builder methods (same shape as ParameterList::add, limited to float/int/bool)
+    ParameterBank& add(const juce::Identifier& Name, float DefaultValue, UiMetadata&& MetaData = {});
+    ParameterBank& add(const juce::Identifier& Name, int DefaultValue, UiMetadata&& MetaData = {});
+    ParameterBank& add(const juce::Identifier& Name, bool DefaultValue, UiMetadata&& MetaData = {});
+
+    // mirror every float/int/bool entry of a ParameterList (other types are skipped)
+    static ParameterBank FromList(const ParameterList& list);
+
+    // copy values between a ParameterList and a bank made from it w/ FromList()
+    void CaptureFrom(const ParameterList& list);
+    void ApplyTo(ParameterList& list) const;
+
+    // entries
+    [[nodiscard]] int GetNumParameters() const { return static_cast<int>(ids_.size()); }
+    [[nodiscard]] int IndexOf(const juce::Identifier& Name) const { return index_.Find(Name); }
+    [[nodiscard]] const juce::Identifier& GetName(int index) const { return ids_[static_cast<size_t>(index)]; }
+    [[nodiscard]] const UiMetadata& GetMetadata(int index) const { return metadata_[static_cast<size_t>(index)]; }
+    [[nodiscard]] Slot GetSlot(int index) const { return slots_[static_cast<size_t>(index)]; }
+
+    // typed value access
+    template <typename T>
+    T& Get(const juce::Identifier& Name)
+    {
+      const Slot slot = GetSlot(IndexOf(Name));
+      jassert(slot.type == TypeOf<T>()); // T != underlying type
+      return GetColumn<T>()[slot.column];
+    }
+
+    // whole columns, for sweeps/snapshots
+    template <typename T>
+    AlignedColumn<T>& GetColumn()
+    {
+      if constexpr (std::is_same<T, float>::value) { return floats_; }
+      else if constexpr (std::is_same<T, int>::value) { return ints_; }
+      else { static_assert(std::is_same<T, bool>::value, "ParameterBank only stores float, int and bool"); return bools_; }
+    }
+
+    template <typename T>
+    const AlignedColumn<T>& GetColumn() const { return const_cast<ParameterBank*>(this)->GetColumn<T>(); }
+
+    // juce::var access by entry index
+    [[nodiscard]] juce::var GetAsVar(int index) const;
+    void SetAsVar(int index, const juce::var& inVar);
+
+    // juce::ValueTree sync (same contract as ParameterList)
+    juce::ValueTree GetStateAsTree() const;
+    void SyncToTree(juce::ValueTree& inTree);
+    void DesyncFromTree(juce::ValueTree& inTree);
+
+  private:
+    // value tree listener callback
+    virtual void valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property) override;
+
+    template <typename T>
+    static constexpr ValueType TypeOf()
+    {
+      if constexpr (std::is_same<T, float>::value) { return ValueType::Float; }
+      else if constexpr (std::is_same<T, int>::value) { return ValueType::Int; }
+      else { static_assert(std::is_same<T, bool>::value, "ParameterBank only stores float, int and bool"); return ValueType::Bool; }
+    }
+
+    template <typename T>
+    ParameterBank& AddEntry(const juce::Identifier& Name, T DefaultValue, UiMetadata&& MetaData);
+
+    // hot: values, one column per type
+    AlignedColumn<float> floats_;
+    AlignedColumn<int> ints_;
+    AlignedColumn<bool> bools_;
+
+    // cold: naming + ui
+    std::vector<Slot> slots_;
+    std::vector<juce::Identifier> ids_;
+    std::vector<UiMetadata> metadata_;
+    IdentifierIndex index_;
+
+  }; // class ParameterBank
+
+} // namespace Haze
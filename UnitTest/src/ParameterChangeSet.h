@@ -0,0 +1,106 @@
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <memory>
+
+#if defined(_MSC_VER)
+ #include <intrin.h>
+#endif
+
+namespace Haze
+{
+  // "which parameters changed since I last looked": one bit per ParameterList entry
+  // any number of writers (audio thread, automation, tree listeners) mark bits w/ a single fetch_or,
+  // one reader takes them a 64 bit word at a time. marking an already dirty entry costs nothing more,
+  // so a parameter changed 1000 times between two reads is seen once. never allocates after construction
+  class ParameterChangeSet
+  {
+  public:
+    // ctor
+    explicit ParameterChangeSet(int numParameters)
+    : numParameters_(juce::jmax(numParameters, 0))
+    , numWords_((numParameters_ + 63) / 64)
+    , words_(std::make_unique<std::atomic<juce::uint64>[]>(static_cast<size_t>(numWords_)))
+    {
+      for (int word = 0; word < numWords_; ++word)
+      {
+        words_[static_cast<size_t>(word)].store(0, std::memory_order_relaxed);
+      }
+    }
+
+    [[nodiscard]] int GetNumParameters() const noexcept { return numParameters_; }
+
+    // writers (any thread)
+    void Mark(int index) noexcept
+    {
+      jassert(juce::isPositiveAndBelow(index, numParameters_));
+      words_[static_cast<size_t>(index >> 6)].fetch_or(juce::uint64 { 1 } << (index & 63), std::memory_order_release);
+    }
+
+    void MarkAll() noexcept
+    {
+      for (int word = 0; word < numWords_; ++word)
+      {
+        const int numBits = juce::jmin(64, numParameters_ - word * 64);
+        words_[static_cast<size_t>(word)].fetch_or(numBits == 64 ? ~juce::uint64 { 0 } : (juce::uint64 { 1 } << numBits) - 1, std::memory_order_release);
+      }
+    }
+
+    // reader: clears and visits every marked index, in ascending order. returns the number visited
+    // (an index marked while this runs is either visited now or on the next call, never lost)
+    template <typename Fn>
+    int TakeChanges(Fn&& fn)
+    {
+      int numChanged = 0;
+      for (int word = 0; word < numWords_; ++word)
+      {
+        auto& bits = words_[static_cast<size_t>(word)];
+        if (bits.load(std::memory_order_relaxed) == 0)
+        {
+          continue;
+        }
+
+        for (juce::uint64 changed = bits.exchange(0, std::memory_order_acquire); changed != 0; changed &= changed - 1)
+        {
+          fn(word * 64 + CountTrailingZeros(changed));
+          ++numChanged;
+        }
+      }
+      return numChanged;
+    }
+
+    [[nodiscard]] bool IsEmpty() const noexcept
+    {
+      for (int word = 0; word < numWords_; ++word)
+      {
+        if (words_[static_cast<size_t>(word)].load(std::memory_order_relaxed) != 0)
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+  private:
+    static int CountTrailingZeros(juce::uint64 bits) noexcept
+    {
+      jassert(bits != 0);
+     #if defined(_MSC_VER)
+      unsigned long index;
+      _BitScanForward64(&index, bits);
+      return static_cast<int>(index);
+     #else
+      return __builtin_ctzll(bits);
+     #endif
+    }
+
+    const int numParameters_;
+    const int numWords_;
+    std::unique_ptr<std::atomic<juce::uint64>[]> words_;
+
+    JUCE_DECLARE_NON_COPYABLE(ParameterChangeSet)
+  }; // class ParameterChangeSet
+
+} // namespace Haze
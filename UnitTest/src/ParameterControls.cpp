@@ -0,0 +1,312 @@
+
+#include "ParameterControls.h"
+#include <cmath>
+
+namespace Haze
+{
+// ParameterList ui generation (lives w/ the controls, so ParameterTypes.h needs no gui types)
+  ControlKind ParameterList::GetControlKind(int index) const
+  {
+    const UiParameter& param = GetParameter(index);
+
+    if (param.Type() == typeid(bool))
+    {
+      return ControlKind::Toggle;
+    }
+
+    if (param.Type() == typeid(juce::String))
+    {
+      return ControlKind::Text;
+    }
+
+    if (!param.IsNumeric())
+    {
+      return ControlKind::None;
+    }
+
+    if (!param.GetUiRange())
+    {
+      return ControlKind::NumberBox;
+    }
+
+    return GetMetadata(index).bPreferSliderOverKnob_ ? ControlKind::Slider : ControlKind::Knob;
+  }
+
+  std::unique_ptr<ParameterControl> ParameterList::CreateComponent(int index)
+  {
+    const ControlKind kind = GetControlKind(index);
+    if (kind == ControlKind::None)
+    {
+      return {};
+    }
+
+    auto control = std::make_unique<ParameterControl>(kind);
+    control->Bind(*this, index);
+    return control;
+  }
+
+// ParameterControl impl:
+  ParameterControl::ParameterControl(ControlKind kind)
+  : kind_(kind)
+  {
+    jassert(kind != ControlKind::None);
+
+    switch (kind_)
+    {
+      case ControlKind::Toggle:
+      {
+        auto toggle = std::make_unique<juce::ToggleButton>();
+        toggle->onClick = [this, button = toggle.get()] { Push(button->getToggleState()); };
+        editor_ = std::move(toggle);
+        break;
+      }
+
+      case ControlKind::Text:
+      {
+        auto text = std::make_unique<juce::Label>();
+        text->setEditable(true);
+        text->onTextChange = [this, label = text.get()] { Push(label->getText()); };
+        editor_ = std::move(text);
+        break;
+      }
+
+      default:
+      {
+        const auto style = kind_ == ControlKind::Slider ? juce::Slider::LinearHorizontal
+                         : kind_ == ControlKind::Knob ? juce::Slider::RotaryHorizontalVerticalDrag
+                         : juce::Slider::IncDecButtons;
+
+        auto slider = std::make_unique<juce::Slider>(style, juce::Slider::TextBoxRight);
+        slider->onValueChange = [this, knob = slider.get()] { Push(knob->getValue()); };
+        editor_ = std::move(slider);
+        break;
+      }
+    }
+
+    addAndMakeVisible(name_);
+    addAndMakeVisible(*editor_);
+  }
+
+  void ParameterControl::Bind(ParameterList& list, int index)
+  {
+    jassert(list.GetControlKind(index) == kind_); // re-bind to the same kind only
+
+    param_ = &list.GetParameter(index);
+    index_ = index;
+
+    const UiMetadata& metadata = list.GetMetadata(index);
+    name_.setText(metadata.DisplayName_.isNotEmpty() ? metadata.DisplayName_ : list.GetName(index).toString(), juce::dontSendNotification);
+
+    if (auto* tooltipClient = dynamic_cast<juce::SettableTooltipClient*>(editor_.get()))
+    {
+      tooltipClient->setTooltip(metadata.ToolTip_);
+    }
+
+    if (kind_ != ControlKind::Toggle && kind_ != ControlKind::Text)
+    {
+      ConfigureSlider(list, index);
+    }
+
+    Refresh();
+  }
+
+  void ParameterControl::ConfigureSlider(const ParameterList& list, int index)
+  {
+    const UiMetadata& metadata = list.GetMetadata(index);
+    const bool bIsIntegral = param_->Type() != typeid(float) && param_->Type() != typeid(double);
+
+    juce::NormalisableRange<double> range(-1.0e9, 1.0e9); // (NumberBox)
+    if (const auto uiRange = param_->GetUiRange())
+    {
+      range = *uiRange;
+
+      if (metadata.bIsLogarithmic_ && range.start > 0.0)
+      {
+        range.setSkewForCentre(std::sqrt(range.start * range.end));
+      }
+    }
+
+    if (bIsIntegral && range.interval == 0.0)
+    {
+      range.interval = 1.0;
+    }
+
+    auto& slider = static_cast<juce::Slider&>(*editor_);
+    slider.setNormalisableRange(range);
+    slider.setNumDecimalPlacesToDisplay(bIsIntegral ? 0 : 3);
+    slider.setTextValueSuffix(metadata.Units_.isNotEmpty() ? " " + metadata.Units_ : juce::String());
+  }
+
+  bool ParameterControl::Refresh()
+  {
+    if (param_ == nullptr)
+    {
+      return false;
+    }
+
+    // (the juce editors repaint on every set, even to the value they already show)
+    const juce::var value = param_->GetAsVar();
+    switch (kind_)
+    {
+      case ControlKind::Toggle:
+      {
+        auto& toggle = static_cast<juce::ToggleButton&>(*editor_);
+        if (toggle.getToggleState() == static_cast<bool>(value))
+        {
+          return false;
+        }
+        toggle.setToggleState(static_cast<bool>(value), juce::dontSendNotification);
+        return true;
+      }
+
+      case ControlKind::Text:
+      {
+        auto& text = static_cast<juce::Label&>(*editor_);
+        if (text.getText() == value.toString())
+        {
+          return false;
+        }
+        text.setText(value.toString(), juce::dontSendNotification);
+        return true;
+      }
+
+      default:
+      {
+        auto& slider = static_cast<juce::Slider&>(*editor_);
+        if (slider.getValue() == static_cast<double>(value))
+        {
+          return false;
+        }
+        slider.setValue(static_cast<double>(value), juce::dontSendNotification);
+        return true;
+      }
+    }
+  }
+
+  void ParameterControl::Push(const juce::var& value)
+  {
+    if (param_ != nullptr)
+    {
+      param_->SetAsVar(value);
+      Refresh();
+    }
+  }
+
+  void ParameterControl::resized()
+  {
+    auto bounds = getLocalBounds().reduced(2);
+    name_.setBounds(bounds.removeFromLeft(bounds.getWidth() / 3));
+    editor_->setBounds(bounds);
+  }
+
+// ParameterListView impl:
+  ParameterListView::ParameterListView(ParameterList& list, int rowHeight)
+  : list_(list)
+  , changes_(list.GetNumParameters())
+  {
+    listBox_.setModel(this);
+    listBox_.setRowHeight(rowHeight);
+    addAndMakeVisible(listBox_);
+  }
+
+  ParameterListView::~ParameterListView()
+  {
+    stopTimer();
+    watchedTree_.removeListener(this);
+    listBox_.setModel(nullptr);
+  }
+
+  void ParameterListView::resized()
+  {
+    listBox_.setBounds(getLocalBounds());
+  }
+
+  void ParameterListView::RefreshVisibleControls()
+  {
+    for (int row = 0; row < getNumRows(); ++row)
+    {
+      if (auto* control = dynamic_cast<ParameterControl*>(listBox_.getComponentForRowNumber(row)))
+      {
+        control->Refresh();
+      }
+    }
+  }
+
+  void ParameterListView::WatchTree(juce::ValueTree tree)
+  {
+    watchedTree_.removeListener(this);
+    watchedTree_ = tree;
+    watchedTree_.addListener(this);
+  }
+
+  int ParameterListView::FlushChanges()
+  {
+    // entries scrolled off screen have no control: they're refreshed by refreshComponentForRow when they come back
+    int numRepainted = 0;
+    changes_.TakeChanges([this, &numRepainted](int row)
+    {
+      if (auto* control = dynamic_cast<ParameterControl*>(listBox_.getComponentForRowNumber(row)))
+      {
+        if (control->Refresh())
+        {
+          ++numRepainted;
+        }
+      }
+    });
+
+    return numRepainted;
+  }
+
+  void ParameterListView::valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property)
+  {
+    juce::ignoreUnused(tree);
+
+    if (const int index = list_.IndexOf(property); index != IdentifierIndex::NotFound)
+    {
+      changes_.Mark(index);
+    }
+  }
+
+  int ParameterListView::GetNumLiveControls() const
+  {
+    int numLive = 0;
+    for (int row = 0; row < list_.GetNumParameters(); ++row)
+    {
+      numLive += listBox_.getComponentForRowNumber(row) != nullptr ? 1 : 0;
+    }
+    return numLive;
+  }
+
+  juce::Component* ParameterListView::refreshComponentForRow(int row, bool isRowSelected, juce::Component* existingComponentToUpdate)
+  {
+    juce::ignoreUnused(isRowSelected);
+
+    const ControlKind kind = juce::isPositiveAndBelow(row, getNumRows()) ? list_.GetControlKind(row) : ControlKind::None;
+
+    // recycle the row's control when it's the right kind
+    auto* existing = dynamic_cast<ParameterControl*>(existingComponentToUpdate);
+    if (existing != nullptr && kind != ControlKind::None && existing->GetKind() == kind)
+    {
+      if (existing->GetParameterIndex() != row)
+      {
+        existing->Bind(list_, row);
+      }
+      else
+      {
+        existing->Refresh();
+      }
+      return existing;
+    }
+
+    delete existingComponentToUpdate;
+
+    if (kind == ControlKind::None)
+    {
+      return nullptr;
+    }
+
+    ++numCreated_;
+    return list_.CreateComponent(row).release();
+  }
+
+} // namespace Haze
@@ -0,0 +1,121 @@
+
+#pragma once
+
+#include "ParameterTypes.h"
+#include "ParameterChangeSet.h"
+
+namespace Haze
+{
+  // generated ui for one ParameterList entry: its display name + an editor picked by ControlKind
+  //   Toggle:            juce::ToggleButton
+  //   Slider/Knob:       juce::Slider, linear or rotary, range (and skew) from the parameter's ParamRange,
+  //                      skewed around the geometric centre when UiMetadata::bIsLogarithmic_
+  //   NumberBox:         juce::Slider w/ inc/dec buttons, unbounded
+  //   Text:              editable juce::Label
+  // edits are written straight into the parameter (SetAsVar). a control is bound to one entry at a time,
+  // Bind() re-targets it to another entry of the same kind (no components are rebuilt)
+  class ParameterControl : public juce::Component
+  {
+  public:
+    // ctor
+    explicit ParameterControl(ControlKind kind);
+
+    [[nodiscard]] ControlKind GetKind() const noexcept { return kind_; }
+    [[nodiscard]] int GetParameterIndex() const noexcept { return index_; }
+
+    // the juce::ToggleButton, juce::Slider or juce::Label
+    [[nodiscard]] juce::Component& GetEditor() const noexcept { return *editor_; }
+
+    // (entry index must be of this control's kind)
+    void Bind(ParameterList& list, int index);
+
+    // pulls the bound parameter's current value, returns false (and repaints nothing) if the editor already shows it
+    bool Refresh();
+
+    void resized() override;
+
+  private:
+    // editor -> parameter (then back, so clamping shows)
+    void Push(const juce::var& value);
+
+    void ConfigureSlider(const ParameterList& list, int index);
+
+    const ControlKind kind_;
+    UiParameter* param_ = nullptr;
+    int index_ = -1;
+
+    juce::Label name_;
+    std::unique_ptr<juce::Component> editor_;
+
+    JUCE_DECLARE_NON_COPYABLE(ParameterControl)
+  }; // class ParameterControl
+
+
+  // scrolling editor for a whole ParameterList, virtualized:
+  // only the rows on screen have a ParameterControl, built on demand, and a row scrolling off is
+  // re-bound to the entry scrolling on when the kinds match (juce::ListBox row recycling).
+  // open cost and memory follow the view's height, not the number of parameters.
+  //
+  // value changes (automation, ParameterFeedback, a watched tree) only mark the entry in a ParameterChangeSet;
+  // once per display frame the visible controls of the marked entries are refreshed, so a control repaints
+  // at most once a frame however often its parameter moves
+  class ParameterListView : public juce::Component,
+                            private juce::ListBoxModel,
+                            private juce::ValueTree::Listener,
+                            private juce::Timer
+  {
+  public:
+    static constexpr int DefaultRowHeight = 32;
+    static constexpr int DefaultFrameHz = 60;
+
+    // ctor
+    explicit ParameterListView(ParameterList& list, int rowHeight = DefaultRowHeight);
+    ~ParameterListView() override;
+
+    void resized() override;
+
+    // pulls every visible control's value (i.e. after a preset was loaded)
+    void RefreshVisibleControls();
+
+    // (any thread, never blocks or allocates) entry index changed, show it w/ the next frame
+    void MarkChanged(int index) noexcept { changes_.Mark(index); }
+
+    // marks the entries whose tree properties change (i.e. the tree a ParameterFeedback writes to)
+    void WatchTree(juce::ValueTree tree);
+
+    // refreshes the changed entries once per frame (message thread)
+    void StartFrameUpdates(int frameHz = DefaultFrameHz) { startTimerHz(frameHz); }
+    void StopFrameUpdates() { stopTimer(); }
+
+    // one frame: refreshes the visible controls of everything marked since the last call,
+    // returns the number of controls that repainted
+    int FlushChanges();
+
+    [[nodiscard]] juce::ListBox& GetListBox() noexcept { return listBox_; }
+
+    // controls that exist right now, and all that were ever built
+    [[nodiscard]] int GetNumLiveControls() const;
+    [[nodiscard]] int GetNumControlsCreated() const noexcept { return numCreated_; }
+
+  private:
+    // juce::ListBoxModel
+    int getNumRows() override { return list_.GetNumParameters(); }
+    void paintListBoxItem(int, juce::Graphics&, int, int, bool) override {}
+    juce::Component* refreshComponentForRow(int row, bool isRowSelected, juce::Component* existingComponentToUpdate) override;
+
+    // juce::ValueTree::Listener
+    void valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property) override;
+
+    void timerCallback() override { FlushChanges(); }
+
+    ParameterList& list_;
+    juce::ListBox listBox_;
+    int numCreated_ = 0;
+
+    ParameterChangeSet changes_;
+    juce::ValueTree watchedTree_;
+
+    JUCE_DECLARE_NON_COPYABLE(ParameterListView)
+  }; // class ParameterListView
+
+} // namespace Haze
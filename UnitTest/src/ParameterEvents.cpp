@@ -0,0 +1,55 @@
+
+#include "ParameterEvents.h"
+
+namespace Haze
+{
+  ParameterEventQueue::ParameterEventQueue(int capacity)
+  : events_(static_cast<size_t>(juce::jmax(0, capacity)))
+  {
+  }
+
+  bool ParameterEventQueue::Add(int sampleOffset, int parameterIndex, float value) noexcept
+  {
+    jassert(sampleOffset >= 0 && parameterIndex >= 0);
+    sampleOffset = juce::jmax(0, sampleOffset);
+
+    if (numEvents_ >= GetCapacity())
+    {
+      return false;
+    }
+
+    // insertion from the back: events mostly arrive in order, so this is usually no move at all
+    int position = numEvents_;
+    for (; position > 0 && events_[static_cast<size_t>(position - 1)].sampleOffset > sampleOffset; --position)
+    {
+      events_[static_cast<size_t>(position)] = events_[static_cast<size_t>(position - 1)];
+    }
+
+    events_[static_cast<size_t>(position)] = { sampleOffset, parameterIndex, value };
+    ++numEvents_;
+    return true;
+  }
+
+  void ParameterEventQueue::MoveInto(ParameterEventQueue& destination) noexcept
+  {
+    for (const ParameterEvent& event : *this)
+    {
+      destination.Add(event);
+    }
+
+    Clear();
+  }
+
+  void ParameterEventQueue::CarryOver(int numConsumed, int numSamples) noexcept
+  {
+    for (int i = numConsumed; i < numEvents_; ++i)
+    {
+      ParameterEvent event = events_[static_cast<size_t>(i)];
+      event.sampleOffset -= numSamples;
+      events_[static_cast<size_t>(i - numConsumed)] = event;
+    }
+
+    numEvents_ -= numConsumed;
+  }
+
+} // namespace Haze
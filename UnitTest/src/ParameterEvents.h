@@ -0,0 +1,87 @@
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+namespace Haze
+{
+  // one parameter change, timestamped within the block it is queued for
+  struct ParameterEvent
+  {
+    int sampleOffset;   // from the start of the next block (>= 0, may lie beyond it)
+    int parameterIndex; // ParameterList position
+    float value;
+  };
+
+
+  // per-processor queue of sample-accurate parameter events (audio thread)
+  //
+  // preallocated to a fixed capacity: Add() never allocates, keeps the events sorted by offset
+  // (events at the same offset keep the order they were added in) and drops events once full.
+  // the processor drains it in processBlock()/exec() via Dispatch(), which splits the block into
+  // sub-blocks at every event offset. events beyond the block carry over to the next one
+  class ParameterEventQueue
+  {
+  public:
+    static constexpr int DefaultCapacity = 1024;
+
+    // ctor
+    explicit ParameterEventQueue(int capacity = DefaultCapacity);
+
+    // false when full (the event is dropped)
+    bool Add(int sampleOffset, int parameterIndex, float value) noexcept;
+    bool Add(const ParameterEvent& event) noexcept { return Add(event.sampleOffset, event.parameterIndex, event.value); }
+
+    void Clear() noexcept { numEvents_ = 0; }
+
+    [[nodiscard]] int GetNumEvents() const noexcept { return numEvents_; }
+    [[nodiscard]] int GetCapacity() const noexcept { return static_cast<int>(events_.size()); }
+    [[nodiscard]] bool IsEmpty() const noexcept { return numEvents_ == 0; }
+
+    [[nodiscard]] const ParameterEvent* begin() const noexcept { return events_.data(); }
+    [[nodiscard]] const ParameterEvent* end() const noexcept { return events_.data() + numEvents_; }
+
+    // consumes the next numSamples worth of events, in order:
+    //   processSubBlock(int startSample, int numSamples) for every stretch between event offsets
+    //   applyEvent(const ParameterEvent&) for every event, before the stretch starting at its offset
+    // w/o events that is a single processSubBlock(0, numSamples). events at or beyond numSamples stay
+    // queued, moved numSamples closer to the start
+    template <typename ApplyEvent, typename ProcessSubBlock>
+    void Dispatch(int numSamples, ApplyEvent&& applyEvent, ProcessSubBlock&& processSubBlock)
+    {
+      int position = 0;
+      int numConsumed = 0;
+
+      for (; numConsumed < numEvents_ && events_[static_cast<size_t>(numConsumed)].sampleOffset < numSamples; ++numConsumed)
+      {
+        const ParameterEvent& event = events_[static_cast<size_t>(numConsumed)];
+        if (event.sampleOffset > position)
+        {
+          processSubBlock(position, event.sampleOffset - position);
+          position = event.sampleOffset;
+        }
+
+        applyEvent(event);
+      }
+
+      if (position < numSamples)
+      {
+        processSubBlock(position, numSamples - position);
+      }
+
+      CarryOver(numConsumed, numSamples);
+    }
+
+    // moves every event into another queue (offsets unchanged), as many as fit
+    void MoveInto(ParameterEventQueue& destination) noexcept;
+
+  private:
+    // drops the first numConsumed events, the rest move numSamples closer to the start
+    void CarryOver(int numConsumed, int numSamples) noexcept;
+
+    std::vector<ParameterEvent> events_;
+    int numEvents_ = 0;
+  }; // class ParameterEventQueue
+
+} // namespace Haze
@@ -0,0 +1,119 @@
+
+#include "ParameterFeedback.h"
+
+namespace Haze
+{
+  ParameterFeedback::ParameterFeedback(const ParameterList& list, juce::ValueTree tree, int capacity)
+  : list_(list)
+  , tree_(std::move(tree))
+  , fifo_(capacity)
+  , updates_(static_cast<size_t>(capacity))
+  , latest_(static_cast<size_t>(list.GetNumParameters()))
+  , isDirty_(static_cast<size_t>(list.GetNumParameters()), 0)
+  , groupTrees_(static_cast<size_t>(list.GetNumGroups()))
+  {
+    dirty_.reserve(static_cast<size_t>(list.GetNumParameters()));
+  }
+
+  ParameterFeedback::~ParameterFeedback()
+  {
+    stopTimer();
+  }
+
+  bool ParameterFeedback::Push(int parameterIndex, double value) noexcept
+  {
+    jassert(juce::isPositiveAndBelow(parameterIndex, static_cast<int>(latest_.size())));
+
+    int start1, size1, start2, size2;
+    fifo_.prepareToWrite(1, start1, size1, start2, size2);
+
+    if (size1 + size2 == 0)
+    {
+      numDropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    updates_[static_cast<size_t>(size1 > 0 ? start1 : start2)] = { parameterIndex, value };
+    fifo_.finishedWrite(1);
+    return true;
+  }
+
+  int ParameterFeedback::Drain()
+  {
+    // coalesce: last write wins per parameter
+    const auto collect = [this](int start, int size)
+    {
+      for (int i = start; i < start + size; ++i)
+      {
+        const Update& update = updates_[static_cast<size_t>(i)];
+        const auto index = static_cast<size_t>(update.parameterIndex);
+        if (!isDirty_[index])
+        {
+          isDirty_[index] = 1;
+          dirty_.push_back(update.parameterIndex);
+        }
+        latest_[index] = update.value;
+      }
+    };
+
+    int start1, size1, start2, size2;
+    fifo_.prepareToRead(fifo_.getNumReady(), start1, size1, start2, size2);
+    collect(start1, size1);
+    collect(start2, size2);
+    fifo_.finishedRead(size1 + size2);
+
+    // apply (values whose group has no subtree yet stay dirty for the next drain)
+    int numWritten = 0;
+    size_t numPending = 0;
+    for (const int index : dirty_)
+    {
+      juce::ValueTree& groupTree = GetGroupTree(list_.GetGroupOf(index));
+      if (!groupTree.isValid())
+      {
+        dirty_[numPending++] = index;
+        continue;
+      }
+
+      groupTree.setProperty(list_.GetName(index), MakeVar(index, latest_[static_cast<size_t>(index)]), nullptr);
+      isDirty_[static_cast<size_t>(index)] = 0;
+      ++numWritten;
+    }
+
+    dirty_.resize(numPending);
+    return numWritten;
+  }
+
+  juce::ValueTree& ParameterFeedback::GetGroupTree(int group)
+  {
+    // (looked up until found rather than in the ctor: SyncToTree may add the subtrees after this was built)
+    juce::ValueTree& groupTree = groupTrees_[static_cast<size_t>(group)];
+    if (!groupTree.isValid())
+    {
+      groupTree = list_.GetGroupTree(tree_, group);
+    }
+    return groupTree;
+  }
+
+  juce::var ParameterFeedback::MakeVar(int parameterIndex, double value) const
+  {
+    const std::type_info& type = list_.GetParameter(parameterIndex).Type();
+
+    if (type == typeid(bool))
+    {
+      return juce::var(value != 0.0);
+    }
+
+    if (type == typeid(int))
+    {
+      return juce::var(juce::roundToInt(value));
+    }
+
+    if (type == typeid(juce::int64))
+    {
+      return juce::var(static_cast<juce::int64>(value));
+    }
+
+    return juce::var(value);
+  }
+
+} // namespace Haze
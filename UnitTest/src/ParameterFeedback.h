@@ -0,0 +1,69 @@
+
+#pragma once
+
+#include "ParameterTypes.h"
+
+namespace Haze
+{
+  // audio thread -> message thread channel for parameter values (meters, adaptive parameters, ...)
+  //
+  // the audio side pushes (index, value) pairs into a preallocated lock-free fifo.
+  // the message side drains it on a timer, keeps only the last write per parameter,
+  // and applies the survivors to the bound juce::ValueTree (which in turn updates any
+  // ParameterList synced to that tree, and any UI listening to it).
+  // values of grouped parameters go to their group's subtree (see ParameterList::BeginGroup);
+  // until the tree has that subtree (e.g. SyncToTree hasn't added it yet) they are held back
+  class ParameterFeedback : private juce::Timer
+  {
+  public:
+    // ctor
+    ParameterFeedback(const ParameterList& list, juce::ValueTree tree, int capacity = 4096);
+    ~ParameterFeedback() override;
+
+    // audio thread (single producer): never blocks or allocates
+    // returns false if the fifo is full and the update was dropped
+    bool Push(int parameterIndex, double value) noexcept;
+
+    // message thread
+    void StartDraining(int timerHz = 30) { startTimerHz(timerHz); }
+    void StopDraining() { stopTimer(); }
+
+    // drains everything queued so far, returns the number of tree properties written
+    // (values held back for a missing group subtree are not counted)
+    int Drain();
+
+    [[nodiscard]] int GetNumDropped() const noexcept { return numDropped_.load(std::memory_order_relaxed); }
+
+  private:
+    void timerCallback() override { Drain(); }
+
+    // builds a juce::var of the parameter's own type so the tree property keeps its type
+    juce::var MakeVar(int parameterIndex, double value) const;
+
+    // group's subtree within tree_, cached once found (invalid while tree_ has none)
+    juce::ValueTree& GetGroupTree(int group);
+
+    struct Update
+    {
+      int parameterIndex;
+      double value;
+    };
+
+    const ParameterList& list_;
+    juce::ValueTree tree_;
+
+    // audio -> message fifo
+    juce::AbstractFifo fifo_;
+    std::vector<Update> updates_;
+    std::atomic<int> numDropped_ { 0 };
+
+    // message thread coalescing scratch (sized once, per parameter)
+    std::vector<double> latest_;
+    std::vector<char> isDirty_;
+    std::vector<int> dirty_;
+    std::vector<juce::ValueTree> groupTrees_; // (per group, see GetGroupTree)
+
+    JUCE_DECLARE_NON_COPYABLE(ParameterFeedback)
+  }; // class ParameterFeedback
+
+} // namespace Haze
@@ -0,0 +1,207 @@
+
+#include "ParameterHistory.h"
+
+namespace Haze
+{
+  ParameterHistory::ParameterHistory(ParameterList& list, size_t maxBytes, juce::uint32 coalesceMs)
+  : list_(list)
+  , maxBytes_(maxBytes)
+  , coalesceMs_(coalesceMs)
+  , openDeltas_(static_cast<size_t>(list.GetNumParameters()), -1)
+  {
+  }
+
+  void ParameterHistory::Set(int parameterIndex, const juce::var& value)
+  {
+    jassert(juce::isPositiveAndBelow(parameterIndex, list_.GetNumParameters()));
+    if (!juce::isPositiveAndBelow(parameterIndex, static_cast<int>(openDeltas_.size())))
+    {
+      return;
+    }
+
+    const juce::uint32 now = juce::Time::getMillisecondCounter();
+    if (bIsOpen_ && gestureDepth_ == 0)
+    {
+      // w/o a gesture, only a run of edits to one parameter coalesces
+      const std::vector<Delta>& deltas = transactions_.back().deltas;
+      const bool bCoalesce = coalesceMs_ > 0 && now - lastEditMs_ <= coalesceMs_
+                          && deltas.size() == 1 && deltas.front().parameterIndex == parameterIndex;
+      if (!bCoalesce)
+      {
+        CloseTransaction();
+      }
+    }
+
+    if (!bIsOpen_)
+    {
+      Open();
+    }
+    lastEditMs_ = now;
+
+    UiParameter& param = list_.GetParameter(parameterIndex);
+    std::vector<Delta>& deltas = transactions_.back().deltas;
+
+    // first edit of this parameter in the transaction: remember where it started
+    int& position = openDeltas_[static_cast<size_t>(parameterIndex)];
+    if (position < 0)
+    {
+      position = static_cast<int>(deltas.size());
+      deltas.push_back({ parameterIndex, param.GetAsVar(), {} });
+    }
+
+    param.SetAsVar(value);
+    deltas[static_cast<size_t>(position)].after = param.GetAsVar(); // (as clamped)
+  }
+
+  void ParameterHistory::BeginGesture()
+  {
+    if (gestureDepth_++ == 0)
+    {
+      CloseTransaction();
+    }
+  }
+
+  void ParameterHistory::EndGesture()
+  {
+    jassert(gestureDepth_ > 0); // unbalanced
+    if (gestureDepth_ > 0 && --gestureDepth_ == 0)
+    {
+      CloseTransaction();
+    }
+  }
+
+  void ParameterHistory::CloseTransaction()
+  {
+    if (!bIsOpen_)
+    {
+      return;
+    }
+
+    bIsOpen_ = false;
+    Transaction& transaction = transactions_.back();
+
+    for (const Delta& delta : transaction.deltas)
+    {
+      openDeltas_[static_cast<size_t>(delta.parameterIndex)] = -1;
+    }
+
+    // edits that ended where they started (a knob dragged back) are nothing to undo
+    auto& deltas = transaction.deltas;
+    deltas.erase(std::remove_if(deltas.begin(), deltas.end(), [](const Delta& delta) { return delta.before == delta.after; }), deltas.end());
+
+    if (deltas.empty())
+    {
+      transactions_.pop_back();
+      --numApplied_;
+      return;
+    }
+
+    deltas.shrink_to_fit();
+    transaction.numBytes = sizeof(Transaction);
+    for (const Delta& delta : deltas)
+    {
+      transaction.numBytes += GetNumBytes(delta);
+    }
+
+    numBytes_ += transaction.numBytes;
+    Trim();
+  }
+
+  bool ParameterHistory::Undo()
+  {
+    CloseTransaction();
+
+    if (numApplied_ == 0)
+    {
+      return false;
+    }
+
+    const Transaction& transaction = transactions_[static_cast<size_t>(--numApplied_)];
+    for (auto delta = transaction.deltas.rbegin(); delta != transaction.deltas.rend(); ++delta)
+    {
+      list_.GetParameter(delta->parameterIndex).SetAsVar(delta->before);
+    }
+
+    return true;
+  }
+
+  bool ParameterHistory::Redo()
+  {
+    CloseTransaction();
+
+    if (!CanRedo())
+    {
+      return false;
+    }
+
+    const Transaction& transaction = transactions_[static_cast<size_t>(numApplied_++)];
+    for (const Delta& delta : transaction.deltas)
+    {
+      list_.GetParameter(delta.parameterIndex).SetAsVar(delta.after);
+    }
+
+    return true;
+  }
+
+  void ParameterHistory::SetMaxBytes(size_t maxBytes)
+  {
+    maxBytes_ = maxBytes;
+
+    if (!bIsOpen_)
+    {
+      Trim();
+    }
+  }
+
+  void ParameterHistory::Clear()
+  {
+    transactions_.clear();
+    std::fill(openDeltas_.begin(), openDeltas_.end(), -1);
+    numApplied_ = 0;
+    numBytes_ = 0;
+    bIsOpen_ = false;
+    gestureDepth_ = 0;
+  }
+
+  size_t ParameterHistory::GetNumBytes(const Delta& delta)
+  {
+    const auto payload = [](const juce::var& value) -> size_t
+    {
+      return value.isString() ? value.toString().getNumBytesAsUTF8() + 1 : 0;
+    };
+
+    return sizeof(Delta) + payload(delta.before) + payload(delta.after);
+  }
+
+  void ParameterHistory::Open()
+  {
+    // a new edit makes everything after it unreachable
+    while (numApplied_ < static_cast<int>(transactions_.size()))
+    {
+      numBytes_ -= transactions_.back().numBytes;
+      transactions_.pop_back();
+    }
+
+    transactions_.emplace_back();
+    ++numApplied_;
+    bIsOpen_ = true;
+  }
+
+  void ParameterHistory::Trim()
+  {
+    // oldest undo steps first, then the furthest redo steps
+    while (numBytes_ > maxBytes_ && transactions_.size() > 1 && numApplied_ > 0)
+    {
+      numBytes_ -= transactions_.front().numBytes;
+      transactions_.pop_front();
+      --numApplied_;
+    }
+
+    while (numBytes_ > maxBytes_ && transactions_.size() > 1)
+    {
+      numBytes_ -= transactions_.back().numBytes;
+      transactions_.pop_back();
+    }
+  }
+
+} // namespace Haze
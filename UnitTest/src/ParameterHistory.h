@@ -0,0 +1,89 @@
+
+#pragma once
+
+#include "ParameterTypes.h"
+#include <deque>
+
+namespace Haze
+{
+  // undo/redo for edits to a ParameterList (message thread)
+  //
+  // edits go through Set(), which records a (parameter, before, after) delta instead of a tree copy.
+  // deltas are grouped into transactions: everything between BeginGesture()/EndGesture() is one,
+  // and w/o a gesture, back to back edits of the same parameter within coalesceMs merge into one
+  // (a knob drag is a single undo step either way). each parameter appears at most once per
+  // transaction, so Undo()/Redo() cost O(parameters changed), whatever the number of edits.
+  // the oldest transactions are dropped once the history outgrows maxBytes
+  class ParameterHistory
+  {
+  public:
+    static constexpr size_t DefaultMaxBytes = 1 << 20;
+    static constexpr juce::uint32 DefaultCoalesceMs = 500;
+
+    // ctor (coalesceMs = 0: only gestures coalesce)
+    explicit ParameterHistory(ParameterList& list, size_t maxBytes = DefaultMaxBytes, juce::uint32 coalesceMs = DefaultCoalesceMs);
+
+    // edits
+    void Set(int parameterIndex, const juce::var& value);
+    void Set(const juce::Identifier& Name, const juce::var& value) { Set(list_.IndexOf(Name), value); }
+
+    // (nestable, the outermost pair makes the transaction)
+    void BeginGesture();
+    void EndGesture();
+
+    // the next edit starts a new transaction
+    void CloseTransaction();
+
+    // false when there's nothing to undo/redo
+    bool Undo();
+    bool Redo();
+
+    [[nodiscard]] bool CanUndo() const noexcept { return numApplied_ > 0; }
+    [[nodiscard]] bool CanRedo() const noexcept { return numApplied_ < static_cast<int>(transactions_.size()); }
+    [[nodiscard]] int GetNumTransactions() const noexcept { return static_cast<int>(transactions_.size()); }
+
+    // memory held by the history (deltas, their string payloads and the per-transaction overhead)
+    [[nodiscard]] size_t GetNumBytes() const noexcept { return numBytes_; }
+    [[nodiscard]] size_t GetMaxBytes() const noexcept { return maxBytes_; }
+    void SetMaxBytes(size_t maxBytes);
+
+    void Clear();
+
+  private:
+    struct Delta
+    {
+      int parameterIndex;
+      juce::var before;
+      juce::var after;
+    };
+
+    struct Transaction
+    {
+      std::vector<Delta> deltas;
+      size_t numBytes = 0;
+    };
+
+    static size_t GetNumBytes(const Delta& delta);
+
+    void Open();
+
+    // drops the oldest transactions until the history fits maxBytes_ (the newest always stays)
+    void Trim();
+
+    ParameterList& list_;
+    size_t maxBytes_;
+    const juce::uint32 coalesceMs_;
+
+    std::deque<Transaction> transactions_;
+    int numApplied_ = 0; // transactions before this are undoable, the rest redoable
+    size_t numBytes_ = 0;
+
+    // the open transaction (always transactions_.back() while open)
+    bool bIsOpen_ = false;
+    int gestureDepth_ = 0;
+    juce::uint32 lastEditMs_ = 0;
+    std::vector<int> openDeltas_; // per parameter: position in the open transaction, -1 if untouched
+
+  }; // class ParameterHistory
+
+} // namespace Haze
@@ -0,0 +1,74 @@
+
+#include "ParameterIndex.h"
+
+namespace Haze
+{
+  bool IdentifierIndex::Insert(const juce::Identifier& Name, int index)
+  {
+    jassert(Name.isValid());
+    jassert(index >= 0);
+
+    // keep the load factor <= 0.5 so probe chains stay short
+    if (static_cast<size_t>(numEntries_ + 1) * 2 > slots_.size())
+    {
+      Rehash(slots_.empty() ? 16 : slots_.size() * 2);
+    }
+
+    const void* key = KeyOf(Name);
+    for (size_t i = Hash(key);; i = (i + 1) & mask_)
+    {
+      Slot& slot = slots_[i];
+      if (slot.key == key)
+      {
+        return false;
+      }
+
+      if (slot.key == nullptr)
+      {
+        slot.key = key;
+        slot.index = index;
+        ++numEntries_;
+        return true;
+      }
+    }
+  }
+
+  void IdentifierIndex::Clear()
+  {
+    slots_.clear();
+    mask_ = 0;
+    shift_ = 64;
+    numEntries_ = 0;
+  }
+
+  void IdentifierIndex::Rehash(size_t newCapacity)
+  {
+    jassert(juce::isPowerOfTwo(newCapacity));
+
+    std::vector<Slot> oldSlots(newCapacity);
+    oldSlots.swap(slots_);
+
+    mask_ = newCapacity - 1;
+    shift_ = 64;
+    for (size_t n = newCapacity; n > 1; n >>= 1)
+    {
+      --shift_;
+    }
+
+    for (const Slot& slot : oldSlots)
+    {
+      if (slot.key != nullptr)
+      {
+        for (size_t i = Hash(slot.key);; i = (i + 1) & mask_)
+        {
+          if (slots_[i].key == nullptr)
+          {
+            slots_[i] = slot;
+            break;
+          }
+        }
+      }
+    }
+  }
+
+} // namespace Haze
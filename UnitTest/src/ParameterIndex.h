@@ -0,0 +1,74 @@
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+#include <cstdint>
+
+namespace Haze
+{
+  // open-addressing hash map: juce::Identifier -> entry index
+  // juce::Identifiers are pooled, so the interned string pointer *is* the identity.
+  // we hash that pointer directly (no string hashing, no string compares)
+  class IdentifierIndex
+  {
+  public:
+    static constexpr int NotFound = -1;
+
+    // returns false if Name was already present (existing index is kept)
+    bool Insert(const juce::Identifier& Name, int index);
+
+    [[nodiscard]] int Find(const juce::Identifier& Name) const noexcept
+    {
+      if (slots_.empty())
+      {
+        return NotFound;
+      }
+
+      const void* key = KeyOf(Name);
+      for (size_t i = Hash(key);; i = (i + 1) & mask_)
+      {
+        const Slot& slot = slots_[i];
+        if (slot.key == key)
+        {
+          return slot.index;
+        }
+
+        if (slot.key == nullptr)
+        {
+          return NotFound;
+        }
+      }
+    }
+
+    [[nodiscard]] int size() const noexcept { return numEntries_; }
+    void Clear();
+
+  private:
+    struct Slot
+    {
+      const void* key = nullptr;
+      int index = NotFound;
+    };
+
+    static const void* KeyOf(const juce::Identifier& Name) noexcept
+    {
+      return Name.getCharPointer().getAddress();
+    }
+
+    // fibonacci hashing of the pointer (low bits are alignment, so take the high bits)
+    size_t Hash(const void* key) const noexcept
+    {
+      return static_cast<size_t>((reinterpret_cast<std::uintptr_t>(key) * UINT64_C(0x9E3779B97F4A7C15)) >> shift_);
+    }
+
+    void Rehash(size_t newCapacity);
+
+    std::vector<Slot> slots_; // power-of-two sized, kept at most half full
+    size_t mask_ = 0;
+    unsigned shift_ = 64;
+    int numEntries_ = 0;
+
+  }; // class IdentifierIndex
+
+} // namespace Haze
@@ -0,0 +1,104 @@
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <cmath>
+#include <type_traits>
+
+namespace Haze
+{
+  // numeric types that can carry a ParamRange (bool is a toggle, not a range)
+  template <typename T>
+  constexpr bool IsRangeable = std::is_arithmetic<T>::value && !std::is_same<T, bool>::value;
+
+
+  // typed range + clamp policy for a ParamType<T>
+  // min/max/step/skew are fixed at construction, Clamp() is constexpr and never allocates.
+  // step > 0 snaps values to min + n * step, skew only shapes the 0..1 mapping (as juce::NormalisableRange)
+  template <typename T>
+  struct ParamRange
+  {
+    static_assert(IsRangeable<T>, "ParamRange<T> needs a numeric (non-bool) T");
+
+    T min;
+    T max;
+    T step;
+    double skew;
+
+    // ctor
+    constexpr ParamRange(T inMin, T inMax, T inStep = T {}, double inSkew = 1.0)
+    : min(inMin)
+    , max(inMax)
+    , step(inStep)
+    , skew(inSkew)
+    {}
+
+    [[nodiscard]] constexpr T Clamp(T value) const noexcept
+    {
+      if (step > T {})
+      {
+        value = Snap(value);
+      }
+
+      return value < min ? min : (max < value ? max : value); // (NaN -> NaN, as juce::jlimit)
+    }
+
+    [[nodiscard]] constexpr bool Contains(T value) const noexcept { return !(value < min) && !(max < value); }
+
+    // normalized (0..1) mapping, skewed
+    [[nodiscard]] double ConvertTo0to1(T value) const noexcept
+    {
+      const double proportion = static_cast<double>(Clamp(value) - min) / static_cast<double>(max - min);
+      return skew == 1.0 ? proportion : std::pow(proportion, skew);
+    }
+
+    [[nodiscard]] T ConvertFrom0to1(double proportion) const noexcept
+    {
+      proportion = juce::jlimit(0.0, 1.0, proportion);
+      if (skew != 1.0 && proportion > 0.0)
+      {
+        proportion = std::exp(std::log(proportion) / skew);
+      }
+
+      return Clamp(FromDouble(static_cast<double>(min) + (static_cast<double>(max) - static_cast<double>(min)) * proportion));
+    }
+
+  private:
+    constexpr T Snap(T value) const noexcept
+    {
+      if constexpr (std::is_integral<T>::value)
+      {
+        // round half up, in the wider type so min + n * step can't overflow
+        const auto wideStep = static_cast<long long>(step);
+        const auto offset = static_cast<long long>(value) - static_cast<long long>(min);
+        const auto numSteps = (offset >= 0 ? offset + wideStep / 2 : offset - wideStep / 2 + 1) / wideStep;
+        const auto snapped = static_cast<long long>(min) + numSteps * wideStep;
+        return snapped > static_cast<long long>(max) ? max : static_cast<T>(snapped);
+      }
+      else
+      {
+        const T numSteps = (value - min) / step;
+        if (!(numSteps > T { -1.0e15 } && numSteps < T { 1.0e15 }))
+        {
+          return value; // NaN/inf or too far out to round, Clamp() sorts it out
+        }
+
+        const T rounded = static_cast<T>(static_cast<long long>(numSteps + (numSteps < T {} ? T { -0.5 } : T { 0.5 })));
+        return min + rounded * step;
+      }
+    }
+
+    static T FromDouble(double value) noexcept
+    {
+      if constexpr (std::is_integral<T>::value)
+      {
+        return static_cast<T>(std::llround(value));
+      }
+      else
+      {
+        return static_cast<T>(value);
+      }
+    }
+  }; // ParamRange<T>
+
+} // namespace Haze
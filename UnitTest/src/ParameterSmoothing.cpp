@@ -0,0 +1,163 @@
+
+#include "ParameterSmoothing.h"
+#include <cmath>
+
+namespace Haze
+{
+  void FillLinearRamp(float* dst, float start, float step, int numSamples) noexcept
+  {
+    if (numSamples <= 0)
+    {
+      return;
+    }
+
+    // dst[len + i] = dst[i] + step * len
+    dst[0] = start + step;
+    for (int len = 1; len < numSamples; len *= 2)
+    {
+      juce::FloatVectorOperations::add(dst + len, dst, step * static_cast<float>(len), juce::jmin(len, numSamples - len));
+    }
+  }
+
+  void FillMultiplicativeRamp(float* dst, float start, float ratio, int numSamples) noexcept
+  {
+    if (numSamples <= 0)
+    {
+      return;
+    }
+
+    // dst[len + i] = dst[i] * ratio^len
+    dst[0] = start * ratio;
+    double ratioToTheLen = ratio;
+    for (int len = 1; len < numSamples; len *= 2)
+    {
+      juce::FloatVectorOperations::multiply(dst + len, dst, static_cast<float>(ratioToTheLen), juce::jmin(len, numSamples - len));
+      ratioToTheLen *= ratioToTheLen;
+    }
+  }
+
+// ParamSmoother impl:
+  ParamSmoother::ParamSmoother(Ramp ramp, float initialValue)
+  : ramp_(ramp)
+  , current_(initialValue)
+  , target_(initialValue)
+  {
+  }
+
+  void ParamSmoother::Prepare(double sampleRate, double rampSeconds)
+  {
+    jassert(sampleRate > 0.0 && rampSeconds >= 0.0);
+    rampLength_ = static_cast<int>(std::floor(sampleRate * rampSeconds));
+    SetCurrentAndTarget(target_);
+  }
+
+  void ParamSmoother::SetTarget(float target) noexcept
+  {
+    if (target == target_)
+    {
+      return;
+    }
+
+    if (rampLength_ <= 0)
+    {
+      SetCurrentAndTarget(target);
+      return;
+    }
+
+    target_ = target;
+    countdown_ = rampLength_;
+
+    // log ramps can't cross (or reach) zero: a range that does gets a linear ramp for this move
+    activeRamp_ = ramp_ == Ramp::Multiplicative && current_ > 0.f && target_ > 0.f ? Ramp::Multiplicative : Ramp::Linear;
+
+    if (activeRamp_ == Ramp::Multiplicative)
+    {
+      step_ = static_cast<float>(std::exp((std::log(static_cast<double>(target_)) - std::log(static_cast<double>(current_))) / rampLength_));
+    }
+    else
+    {
+      step_ = (target_ - current_) / static_cast<float>(rampLength_);
+    }
+  }
+
+  void ParamSmoother::SetCurrentAndTarget(float value) noexcept
+  {
+    current_ = target_ = value;
+    countdown_ = 0;
+  }
+
+  bool ParamSmoother::RenderBlock(float* dst, int numSamples) noexcept
+  {
+    if (countdown_ <= 0)
+    {
+      return false;
+    }
+
+    const int numRamped = juce::jmin(countdown_, numSamples);
+
+    if (activeRamp_ == Ramp::Multiplicative)
+    {
+      FillMultiplicativeRamp(dst, current_, step_, numRamped);
+    }
+    else
+    {
+      FillLinearRamp(dst, current_, step_, numRamped);
+    }
+
+    countdown_ -= numRamped;
+    if (countdown_ == 0)
+    {
+      // land exactly on the target, then hold it
+      dst[numRamped - 1] = target_;
+      juce::FloatVectorOperations::fill(dst + numRamped, target_, numSamples - numRamped);
+      current_ = target_;
+    }
+    else
+    {
+      current_ = dst[numRamped - 1];
+    }
+
+    return true;
+  }
+
+  float ParamSmoother::GetNextValue() noexcept
+  {
+    if (countdown_ <= 0)
+    {
+      return current_;
+    }
+
+    --countdown_;
+    current_ = countdown_ == 0 ? target_
+                               : (activeRamp_ == Ramp::Multiplicative ? current_ * step_ : current_ + step_);
+    return current_;
+  }
+
+// SmoothedParam impl:
+  SmoothedParam::SmoothedParam(ParameterList& list, const juce::Identifier& Name)
+  : param_(list.GetHandle<float>(Name))
+  , smoother_(list.GetMetadata(list.IndexOf(Name)).bIsLogarithmic_ ? ParamSmoother::Ramp::Multiplicative : ParamSmoother::Ramp::Linear,
+              param_.Load())
+  , lastLoaded_(param_.Load())
+  {
+  }
+
+  void SmoothedParam::Prepare(double sampleRate, double rampSeconds)
+  {
+    smoother_.Prepare(sampleRate, rampSeconds);
+    lastLoaded_ = param_.Load();
+    smoother_.SetCurrentAndTarget(lastLoaded_);
+  }
+
+  bool SmoothedParam::RenderBlock(float* dst, int numSamples) noexcept
+  {
+    if (const float latest = param_.Load(); latest != lastLoaded_)
+    {
+      lastLoaded_ = latest;
+      smoother_.SetTarget(latest);
+    }
+
+    return smoother_.RenderBlock(dst, numSamples);
+  }
+
+} // namespace Haze
@@ -0,0 +1,84 @@
+
+#pragma once
+
+#include "ParameterTypes.h"
+
+namespace Haze
+{
+  // vectorized ramp kernels, writing values *after* start:
+  //   linear:          dst[i] = start + step * (i + 1)
+  //   multiplicative:  dst[i] = start * ratio^(i + 1)
+  // the ramp is built by doubling, so a block costs log2(numSamples) juce::FloatVectorOperations passes
+  void FillLinearRamp(float* dst, float start, float step, int numSamples) noexcept;
+  void FillMultiplicativeRamp(float* dst, float start, float ratio, int numSamples) noexcept;
+
+
+  // ramps a float from its current value to a target over a fixed number of samples
+  class ParamSmoother
+  {
+  public:
+    enum class Ramp
+    {
+      Linear,
+      Multiplicative // constant ratio per sample, for logarithmic parameters (moves to or from values <= 0 ramp linearly)
+    };
+
+    // ctor
+    explicit ParamSmoother(Ramp ramp = Ramp::Linear, float initialValue = 0.f);
+
+    void Prepare(double sampleRate, double rampSeconds);
+
+    void SetTarget(float target) noexcept;
+    void SetCurrentAndTarget(float value) noexcept;
+
+    [[nodiscard]] bool IsSmoothing() const noexcept { return countdown_ > 0; }
+    [[nodiscard]] float GetCurrent() const noexcept { return current_; }
+    [[nodiscard]] float GetTarget() const noexcept { return target_; }
+    [[nodiscard]] Ramp GetRamp() const noexcept { return ramp_; }
+
+    // renders the next numSamples values into dst and returns true.
+    // when settled nothing is written and it returns false: the value is simply GetCurrent()
+    bool RenderBlock(float* dst, int numSamples) noexcept;
+
+    // per-sample path
+    float GetNextValue() noexcept;
+
+  private:
+    Ramp ramp_;
+    Ramp activeRamp_ = Ramp::Linear; // the ramp in progress
+    float current_;
+    float target_;
+    float step_ = 0.f; // increment (Linear) or ratio (Multiplicative) per sample
+    int rampLength_ = 0;
+    int countdown_ = 0;
+  }; // class ParamSmoother
+
+
+  // smoothed view of a ParamType<float> in a ParameterList
+  // picks a multiplicative ramp when the parameter's UiMetadata says it is logarithmic
+  class SmoothedParam
+  {
+  public:
+    SmoothedParam() = default;
+    SmoothedParam(ParameterList& list, const juce::Identifier& Name);
+
+    // (also jumps straight to the parameter's latest value, no ramp)
+    void Prepare(double sampleRate, double rampSeconds);
+
+    // once per block: takes the parameter's latest value (ParamHandle::Load) as the target whenever it
+    // changed since the last block, then behaves like ParamSmoother::RenderBlock
+    bool RenderBlock(float* dst, int numSamples) noexcept;
+
+    // sample-accurate retarget (see ParameterEventQueue), held until the parameter itself changes again
+    void SetTarget(float target) noexcept { smoother_.SetTarget(target); }
+
+    [[nodiscard]] float GetCurrent() const noexcept { return smoother_.GetCurrent(); }
+    [[nodiscard]] const ParamSmoother& GetSmoother() const noexcept { return smoother_; }
+
+  private:
+    ParamHandle<float> param_;
+    ParamSmoother smoother_;
+    float lastLoaded_ = 0.f;
+  }; // class SmoothedParam
+
+} // namespace Haze
@@ -11,6 +11,9 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "ParameterIndex.h"
+#include "RealtimeTransport.h"
+#include "ParameterRange.h"
 #include <type_traits>
 #include <algorithm>
 #include <optional>
@@ -37,6 +40,16 @@ namespace Haze
     [[nodiscard]] virtual juce::var GetAsVar() const = 0;
     virtual void SetAsVar(const juce::var& inVar) = 0;
 
+    // ui reflection (see ParameterList::GetControlKind)
+    [[nodiscard]] virtual bool IsNumeric() const = 0;
+    [[nodiscard]] virtual std::optional<juce::NormalisableRange<double>> GetUiRange() const = 0; // (numeric w/ a range only)
+
+    // a new parameter of the same type w/ the same value and range (a ParameterSchema default -> an instance's value)
+    [[nodiscard]] virtual std::unique_ptr<UiParameter> Clone() const = 0;
+
+    // see ParameterList::TransportMode::Realtime
+    virtual void EnableRealtimeTransport() = 0;
+
     // assignment
     template <typename T>
     UiParameter& operator=(const T& inValue)
@@ -69,15 +82,26 @@ namespace Haze
     }
 
     template <typename T>
-    T& GetRef()
+    const T& Get() const
     {
       return **DowncastChecked<T>();
     }
 
-    void SetInPlaceClamper(std::function<void(juce::var&)>&& lambda);
+    template <typename T>
+    T& GetRef()
+    {
+      return **DowncastChecked<T>();
+    }
 
-    std::function<void(juce::var&)>& GetInPlaceClamper();
-  
+    // range/clamp policy (applies to every later write, see ParamType<T>::SetRange)
+    template <typename T>
+    void SetRange(const ParamRange<T>& range)
+    {
+      if(auto* downPtr = DowncastChecked<T>())
+      {
+        downPtr->SetRange(range);
+      }
+    }
 
   private:
     
@@ -98,8 +122,6 @@ namespace Haze
       return downPtr;
     }  
 
-    std::function<void(juce::var&)> InPlaceClamper = [](juce::var& x){juce::ignoreUnused(x);};
-
   }; // class Parameter
     
   // todo: special-case T types for ui reflection (i.e. an Action type that reflects as a juce::TextButton)
@@ -129,20 +151,143 @@ namespace Haze
       return {};
     }
     
-    virtual void SetAsVar(const juce::var& inVar) override { data_ = inVar; } 
+    virtual void SetAsVar(const juce::var& inVar) override { data_ = inVar; ApplyRange(); Publish(); } 
 
+    [[nodiscard]] bool IsNumeric() const override final { return IsRangeable<T>; }
 
-    ParamType& operator=(const T& inValue) { data_ = inValue; return *this; }
+    [[nodiscard]] std::optional<juce::NormalisableRange<double>> GetUiRange() const override final
+    {
+      if constexpr (IsRangeable<T>)
+      {
+        if (range_)
+        {
+          return juce::NormalisableRange<double>(static_cast<double>(range_->min), static_cast<double>(range_->max),
+                                                 static_cast<double>(range_->step), range_->skew);
+        }
+      }
+
+      return std::nullopt;
+    }
 
+
+    ParamType& operator=(const T& inValue) { data_ = inValue; ApplyRange(); Publish(); return *this; }
+
+    // note: writes through these references are neither clamped nor seen by Load() until the next Publish()
     const T& operator*() const { return data_; }
 
     T& operator*() { return data_; }
 
+    // (w/o the realtime mailbox: that's per instance)
+    [[nodiscard]] std::unique_ptr<UiParameter> Clone() const override final
+    {
+      auto copy = std::make_unique<ParamType<T>>(T(data_));
+      copy->range_ = range_;
+      return copy;
+    }
+
+    // realtime transport: writes are mirrored into a wait-free mailbox the audio thread reads via Load()
+    void EnableRealtimeTransport() override final
+    {
+      if (!realtime_)
+      {
+        realtime_ = std::make_unique<RealtimeValue<T>>(data_);
+      }
+    }
+
+    void Publish()
+    {
+      if (realtime_)
+      {
+        realtime_->Store(data_);
+      }
+    }
+
+    // audio thread read (never blocks or allocates)
+    // by value for atomic types, otherwise a reference that stays valid until the next Load()
+    decltype(auto) Load() const
+    {
+      return realtime_ ? realtime_->Load() : data_;
+    }
+
+    // range/clamp policy, numeric T only (the current value is clamped right away)
+    template <typename U = T, std::enable_if_t<IsRangeable<U>, int> = 0>
+    void SetRange(const ParamRange<T>& range)
+    {
+      range_ = range;
+      ApplyRange();
+      Publish();
+    }
+
+    template <typename U = T, std::enable_if_t<IsRangeable<U>, int> = 0>
+    [[nodiscard]] const std::optional<ParamRange<T>>& GetRange() const { return range_; }
+
   private:
+    // empty stand-in for types that can't have a range
+    struct NoRange {};
+
+    void ApplyRange() noexcept
+    {
+      if constexpr (IsRangeable<T>)
+      {
+        if (range_)
+        {
+          data_ = range_->Clamp(data_);
+        }
+      }
+    }
+
     T data_;    
+    std::unique_ptr<RealtimeValue<T>> realtime_;
+    std::conditional_t<IsRangeable<T>, std::optional<ParamRange<T>>, NoRange> range_;
   }; // ParamType<T>
 
 
+  // strongly typed, non-owning handle to a ParamType<T>'s storage
+  // resolve it once (ParameterList::GetHandle<T>) and read/write w/o lookups or dynamic_cast.
+  // valid for the lifetime of the ParameterList that produced it
+  template <typename T>
+  class ParamHandle
+  {
+  public:
+    ParamHandle() = default;
+    explicit ParamHandle(ParamType<T>* param) : param_(param) {}
+
+    [[nodiscard]] bool IsValid() const { return param_ != nullptr; }
+    explicit operator bool() const { return IsValid(); }
+
+    // Get underlying data
+    const T& Get() const { return **param_; }
+    T& GetRef() const { return **param_; }
+    const T& operator*() const { return **param_; }
+
+    // assignment
+    void Set(const T& inValue) const { *param_ = inValue; }
+
+    // comparison
+    bool IsEqualTo(const T& other) const { return **param_ == other; }
+
+    // audio thread read (see ParameterList::TransportMode::Realtime)
+    decltype(auto) Load() const { return param_->Load(); }
+
+  private:
+    ParamType<T>* param_ = nullptr;
+  }; // ParamHandle<T>
+
+
+
+  // the control CreateComponent() generates for a parameter
+  enum class ControlKind
+  {
+    None,      // (no ui reflection for this type)
+    Toggle,    // bool
+    Slider,    // numeric w/ a range, UiMetadata::bPreferSliderOverKnob_
+    Knob,      // numeric w/ a range
+    NumberBox, // numeric w/o a range
+    Text       // juce::String
+  };
+
+  class ParameterControl; // (ParameterControls.h)
+
 
   struct UiMetadata
   {
@@ -163,85 +308,234 @@ namespace Haze
   };
   
 
-  // todo: allow the DSP thread to update the UI
-  class ParameterList : public juce::ValueTree::Listener
+  // flat copy of every value in a ParameterList, in list order
+  // (reused across captures: sized once, then filled w/o allocating for numeric parameters)
+  struct ParameterSnapshot
   {
-      struct ParameterEntry
-      {
-        juce::Identifier id;
-        std::unique_ptr<UiParameter> paramPtr;
+    std::vector<juce::var> values;
+  };
 
-        bool operator==(const juce::Identifier& Name) { return Name == id; } // std::find_if
 
-        // ctor
-        ParameterEntry(const juce::Identifier& inId, std::unique_ptr<UiParameter>&& inParamPtr)
-        : id(inId)
-        , paramPtr(std::forward<std::unique_ptr<UiParameter>>(inParamPtr))
-        {}
-      };
+  // the layout of a ParameterList: ids, types w/ default values (+ ranges), UiMetadata and groups
+  //
+  // every instance of a plugin has the same layout: it's built once and shared (reference counted) by every
+  // ParameterList made from it, each of which keeps nothing but its own values.
+  // immutable once shared: the builder methods of a list whose schema is shared give that list its own copy first
+  class ParameterSchema : public juce::ReferenceCountedObject
+  {
+  public:
+    using Ptr = juce::ReferenceCountedObjectPtr<ParameterSchema>;
 
-      struct UiMetadataEntry
-      {
-        juce::Identifier id;
-        UiMetadata Metadata;
+    // the type of GetStateAsTree()'s root, group 0
+    static inline const juce::Identifier ListTreeType { "Parameter_List" };
 
-        bool operator==(const juce::Identifier& Name) { return Name == id; } // std::find_if
+    // a node of the group hierarchy, i.e. one eq band (group 0 is the list itself)
+    struct Group
+    {
+      juce::Identifier id;         // (its juce::ValueTree's type)
+      int parent;                  // (-1 for the list itself)
+      std::vector<int> parameters; // direct members, in add() order
+      std::vector<int> children;   // child groups, in BeginGroup() order
+    };
 
-        // ctor
-        UiMetadataEntry(const juce::Identifier& inId, UiMetadata&& inMetadata)
-        : id(inId)
-        , Metadata(inMetadata)
-        {}
-      };
+    [[nodiscard]] int GetNumParameters() const { return static_cast<int>(entries_.size()); }
+    [[nodiscard]] int IndexOf(const juce::Identifier& Name) const { return index_.Find(Name); }
+    [[nodiscard]] const juce::Identifier& GetName(int index) const { return entries_[static_cast<size_t>(index)].id; }
+    [[nodiscard]] const UiMetadata& GetMetadata(int index) const { return entries_[static_cast<size_t>(index)].metadata; }
+    [[nodiscard]] int GetGroupOf(int index) const { return entries_[static_cast<size_t>(index)].group; }
+
+    // type, default value and range of an entry
+    [[nodiscard]] const UiParameter& GetDefault(int index) const { return *entries_[static_cast<size_t>(index)].defaultValue; }
+
+    [[nodiscard]] int GetNumGroups() const { return static_cast<int>(groups_.size()); }
+    [[nodiscard]] const Group& GetGroup(int group) const { return groups_[static_cast<size_t>(group)]; }
+    [[nodiscard]] int FindGroup(const juce::Identifier& Name) const; // (-1 if there's none)
+
+  private:
+    friend class ParameterList; // (built through ParameterList's builder methods)
+
+    struct Entry
+    {
+      juce::Identifier id;
+      std::unique_ptr<UiParameter> defaultValue;
+      int group;
+      UiMetadata metadata;
+    };
+
+    ParameterSchema() = default;
+
+    // deep copy (copy on write, see ParameterList::EditSchema)
+    [[nodiscard]] Ptr Clone() const;
+
+    std::vector<Entry> entries_;
+    std::vector<Group> groups_ { Group { ListTreeType, -1, {}, {} } };
+
+    // name -> position in entries_
+    IdentifierIndex index_;
 
-      struct UiComponentEntry
+    JUCE_DECLARE_NON_COPYABLE(ParameterSchema)
+  }; // class ParameterSchema
+
+
+  // (the DSP thread updates the UI through a ParameterFeedback, see ParameterFeedback.h)
+  class ParameterList
+  {
+      // keeps one group in sync w/ its (sub)tree
+      // juce::ValueTree tells a tree's listeners about changes anywhere below it too: those belong to the child
+      // groups' own GroupSync and are ignored here w/ a single compare
+      class GroupSync : public juce::ValueTree::Listener
       {
-        juce::Identifier id;
-        std::unique_ptr<juce::Component> componentPtr;
+      public:
+        // ctor
+        GroupSync(ParameterList& list, int group, const juce::ValueTree& tree, const juce::ValueTree& root)
+        : list_(list), group_(group), tree_(tree), root_(root)
+        {
+          tree_.addListener(this);
+        }
 
-        UiComponentEntry(const juce::Identifier& inId,  std::unique_ptr<juce::Component> inComponentPtr)
-        : id(inId)
-        , componentPtr(std::move(inComponentPtr))
-        {}
+        ~GroupSync() override { tree_.removeListener(this); }
+
+        [[nodiscard]] const juce::ValueTree& GetRoot() const noexcept { return root_; }
+
+      private:
+        void valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property) override;
+
+        ParameterList& list_;
+        const int group_;
+        juce::ValueTree tree_;
+        juce::ValueTree root_; // (the tree SyncToTree was given)
+
+        JUCE_DECLARE_NON_COPYABLE(GroupSync)
       };
 
 
   public:
+    enum class TransportMode
+    {
+      Direct,   // audio thread reads the same storage the message thread writes (single threaded use only)
+      Realtime  // every write is also published to a wait-free mailbox per parameter, read via Load()
+    };
+
+    static inline const juce::Identifier& ListTreeType = ParameterSchema::ListTreeType;
+    static constexpr int RootGroup = 0;
+
+    // ctor: empty, w/ a schema of its own for the builder methods to fill
+    explicit ParameterList(TransportMode transport = TransportMode::Direct);
+
+    // ctor: one more instance of a (shared) layout, w/ its own values starting at the schema's defaults
+    explicit ParameterList(ParameterSchema::Ptr schema, TransportMode transport = TransportMode::Direct);
+
+    [[nodiscard]] TransportMode GetTransportMode() const { return transport_; }
+
+    // this list's layout, i.e. for building more instances (from then on it's shared, see ParameterSchema)
+    [[nodiscard]] ParameterSchema::Ptr GetSchema() const { return schema_; }
+
     // builder method
     template <typename T>
     ParameterList& add(const juce::Identifier& Name, T&& DefaultValue = {}, UiMetadata&& MetaData = {})
     {
-      // check for name collision (previous entry will be stomped!)
-      jassert(parameters_.end() == std::find(parameters_.begin(), parameters_.end(), Name));
-      jassert(uiMetadata_.end() == std::find(uiMetadata_.begin(), uiMetadata_.end(), Name));
+      AddEntry(Name, std::make_unique<ParamType<T>>(std::forward<T>(DefaultValue)), std::forward<UiMetadata>(MetaData));
 
-      auto paramIt = parameters_.emplace(parameters_.end(), ParameterEntry(Name, std::make_unique<ParamType<T>>(std::forward<T>(DefaultValue))));
-      auto metadataIt = uiMetadata_.emplace(uiMetadata_.end(), UiMetadataEntry(Name, std::forward<UiMetadata>(MetaData)));
-      uiComponents_.emplace_back(UiComponentEntry(Name, CreateComponent<T>(*paramIt, *metadataIt)));
-      
+      return *this;
+    }
+
+    // builder method w/ a range/clamp policy (the default value is clamped into it)
+    template <typename T>
+    ParameterList& add(const juce::Identifier& Name, T&& DefaultValue, const ParamRange<std::decay_t<T>>& Range, UiMetadata&& MetaData = {})
+    {
+      auto defaultValue = std::make_unique<ParamType<T>>(std::forward<T>(DefaultValue));
+      defaultValue->SetRange(Range);
+      AddEntry(Name, std::move(defaultValue), std::forward<UiMetadata>(MetaData));
 
       return *this;
     }
 
+    // nested groups (i.e. one per eq band): the add() calls between BeginGroup and its EndGroup land in the group.
+    // in GetStateAsTree() a group is a child tree of its parent group's tree, holding its own parameters
+    // (a list w/o groups keeps the flat layout: every parameter a property of the root)
+    ParameterList& BeginGroup(const juce::Identifier& Name);
+    ParameterList& EndGroup();
+
+    [[nodiscard]] int GetNumGroups() const { return schema_->GetNumGroups(); }
+    [[nodiscard]] int FindGroup(const juce::Identifier& Name) const { return schema_->FindGroup(Name); } // (-1 if there's none)
+    [[nodiscard]] const juce::Identifier& GetGroupName(int group) const { return schema_->GetGroup(group).id; }
+    [[nodiscard]] int GetParentGroup(int group) const { return schema_->GetGroup(group).parent; }
+    [[nodiscard]] const std::vector<int>& GetGroupParameters(int group) const { return schema_->GetGroup(group).parameters; }
+    [[nodiscard]] int GetGroupOf(int index) const { return schema_->GetGroupOf(index); }
+
     // index operator for juce::Identifier
-    std::unique_ptr<UiParameter>& operator[](const juce::Identifier Name);
+    std::unique_ptr<UiParameter>& operator[](const juce::Identifier& Name);
+
+    // positional access (index == order of add() calls, stable for the list's lifetime)
+    [[nodiscard]] int IndexOf(const juce::Identifier& Name) const { return schema_->IndexOf(Name); }
+    [[nodiscard]] int GetNumParameters() const { return static_cast<int>(values_.size()); }
+    [[nodiscard]] const juce::Identifier& GetName(int index) const { return schema_->GetName(index); }
+    [[nodiscard]] UiParameter& GetParameter(int index) { return *values_[static_cast<size_t>(index)]; }
+    [[nodiscard]] const UiParameter& GetParameter(int index) const { return *values_[static_cast<size_t>(index)]; }
+    [[nodiscard]] const UiMetadata& GetMetadata(int index) const { return schema_->GetMetadata(index); }
+
+    // typed handle to an entry (does the lookup + dynamic_cast once, keep it for the hot path)
+    template <typename T>
+    ParamHandle<T> GetHandle(const juce::Identifier& Name)
+    {
+      auto* value = FindValueByName(Name);
+      auto* downPtr = value ? dynamic_cast<ParamType<T>*>(value->get()) : nullptr;
+      jassert(downPtr); // dynamic_cast failed! T != underlying type
+      return ParamHandle<T>(downPtr);
+    }
+
+    // ui generation, on demand (i.e. as a ParameterListView scrolls): the control for entry index, bound to it.
+    // a control can be re-bound to any entry of the same kind (ParameterControl::Bind) instead of building a new one
+    [[nodiscard]] ControlKind GetControlKind(int index) const;
+    [[nodiscard]] std::unique_ptr<ParameterControl> CreateComponent(int index);
     
     // juce::ValueTree sync
+    // SyncToTree listens to every group's subtree on its own (missing subtrees are added w/ the current values),
+    // so a write to one group's tree only reaches that group
     juce::ValueTree GetStateAsTree() const;
     void SyncToTree(juce::ValueTree& inTree);
     void DesyncFromTree(juce::ValueTree& inTree);
 
+    // take on the state of inTree w/o listening to it
+    // (properties and child groups are matched by position first, so trees from GetStateAsTree() need no lookups)
+    void RestoreFromTree(const juce::ValueTree& inTree);
+
+    // one group (and its children) alone, i.e. a per-band preset: only that group's parameters are touched
+    juce::ValueTree GetGroupStateAsTree(int group) const;
+    void RestoreGroup(int group, const juce::ValueTree& groupTree);
+
+    // group's subtree within a tree laid out like GetStateAsTree() (invalid if it has none)
+    juce::ValueTree GetGroupTree(const juce::ValueTree& root, int group) const;
+
+    // bulk state capture/restore, one pass in list order
+    void CaptureSnapshot(ParameterSnapshot& snapshot) const;
+    void CaptureSnapshot(const juce::ValueTree& inTree, ParameterSnapshot& snapshot) const; // tree -> snapshot w/o touching the list
+    void RestoreSnapshot(const ParameterSnapshot& snapshot);
+
   private:
-    // value tree listener callback
-    virtual void valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property) override;
+    // (GroupSync callback)
+    void SetFromTree(int group, const juce::ValueTree& tree, const juce::Identifier& property);
 
-    // helper functions for finding an element by name
-    template <typename T>
-    T* FindEntryByName(juce::Identifier Name, std::vector<T>& vec)
+    // calls fn(index, value) for every property of tree and its child group trees, group's layout
+    // (properties that aren't parameters are skipped)
+    template <typename Fn>
+    void ForEachTreeValue(int group, const juce::ValueTree& tree, Fn&& fn) const;
+
+    void AttachGroup(int group, juce::ValueTree& tree, const juce::ValueTree& root);
+
+    // builder helpers: the schema, made this list's own first if it's shared (copy on write)
+    ParameterSchema& EditSchema();
+    void AddEntry(const juce::Identifier& Name, std::unique_ptr<UiParameter>&& defaultValue, UiMetadata&& MetaData);
+
+    // an instance's value for entry index, starting at its default
+    std::unique_ptr<UiParameter> MakeValue(int index) const;
+
+    // helper function for finding a value by name
+    std::unique_ptr<UiParameter>* FindValueByName(const juce::Identifier& Name)
     {
-      if(auto it = std::find(vec.begin(), vec.end(), Name); it != vec.end())
+      if(const int index = schema_->IndexOf(Name); index != IdentifierIndex::NotFound)
       {
-        return &(*it);
+        return &values_[static_cast<size_t>(index)];
       }
       
       // we should never be asking about an entry that doesn't exist!
@@ -249,28 +543,30 @@ namespace Haze
       return nullptr;
     }
 
-    // underlying "lists"
-    std::vector<ParameterEntry> parameters_;
-    std::vector<UiMetadataEntry> uiMetadata_;
-    std::vector<UiComponentEntry> uiComponents_;
-    
-    // helper function that generates a juce::Component from the data presented
-    template <typename T>
-    std::unique_ptr<juce::Component> CreateComponent(const ParameterEntry& param, const UiMetadataEntry& metadata) const
+    // cheap path for trees laid out like GetStateAsTree(): property i of a group's tree is usually its parameter i
+    // (IdentifierIndex::NotFound for a property that isn't a parameter, i.e. from an older preset)
+    int IndexAtPosition(int group, int position, const juce::Identifier& Name) const
     {
-      juce::ignoreUnused(param, metadata);
+      const std::vector<int>& members = schema_->GetGroup(group).parameters;
+      if (position < static_cast<int>(members.size()) && schema_->GetName(members[static_cast<size_t>(position)]) == Name)
+      {
+        return members[static_cast<size_t>(position)];
+      }
 
-      // bool?
-//      constexpr if(std::is_same<bool, T>)
+      return schema_->IndexOf(Name);
+    }
 
-      // enum?
+    // shared layout + this instance's values (in schema order)
+    ParameterSchema::Ptr schema_;
+    std::vector<std::unique_ptr<UiParameter>> values_;
 
-      // knob/slider?
+    // the group add() currently adds to
+    int currentGroup_ = RootGroup;
 
-      return {}; // not in use yet
-    }
+    // one per synced (sub)tree
+    std::vector<std::unique_ptr<GroupSync>> groupSyncs_;
 
-    // component generatior sub-helpers
+    TransportMode transport_;
 
   }; // class ParameterList
   
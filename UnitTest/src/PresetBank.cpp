@@ -0,0 +1,254 @@
+
+#include "PresetBank.h"
+#include <limits>
+
+namespace Haze
+{
+  namespace
+  {
+    using BinaryPreset::ReadLE;
+    using BinaryPreset::WriteLE;
+
+    constexpr char Magic[4] = { 'H', 'Z', 'P', 'K' };
+    constexpr size_t PresetAlignment = 8;
+
+    size_t AlignUp(size_t offset) noexcept
+    {
+      return (offset + PresetAlignment - 1) & ~(PresetAlignment - 1);
+    }
+  } // namespace
+
+// PresetBankWriter impl:
+  bool PresetBankWriter::AddPreset(const juce::String& name, const ParameterList& list)
+  {
+    jassert(name.isNotEmpty() && name.getNumBytesAsUTF8() <= 0xffff);
+
+    std::string key(name.toRawUTF8(), name.getNumBytesAsUTF8());
+    if (presets_.count(key) != 0)
+    {
+      return false;
+    }
+
+    BinaryPreset::Encode(list, presets_[std::move(key)]);
+    return true;
+  }
+
+  bool PresetBankWriter::WriteTo(const juce::File& file) const
+  {
+    using namespace PresetBankFormat;
+
+    const size_t numPresets = presets_.size();
+
+    size_t namesSize = 0;
+    for (const auto& preset : presets_)
+    {
+      namesSize += preset.first.size();
+    }
+
+    // header + index + names, then the presets
+    std::vector<juce::uint8> head(HeaderSize + numPresets * IndexEntrySize + namesSize);
+    juce::uint8* out = head.data();
+
+    std::memcpy(out, Magic, sizeof(Magic));
+    WriteLE<juce::uint16>(out + 4, Version);
+    WriteLE<juce::uint16>(out + 6, 0);
+    WriteLE<juce::uint32>(out + 8, static_cast<juce::uint32>(numPresets));
+    WriteLE<juce::uint32>(out + 12, static_cast<juce::uint32>(namesSize));
+
+    juce::uint8* entry = out + HeaderSize;
+    juce::uint8* names = entry + numPresets * IndexEntrySize;
+    size_t nameOffset = 0;
+    size_t presetOffset = AlignUp(head.size());
+
+    for (const auto& preset : presets_)
+    {
+      const std::string& name = preset.first;
+      const juce::MemoryBlock& data = preset.second;
+
+      WriteLE<juce::uint32>(entry, static_cast<juce::uint32>(nameOffset));
+      WriteLE<juce::uint16>(entry + 4, static_cast<juce::uint16>(name.size()));
+      WriteLE<juce::uint16>(entry + 6, 0);
+      WriteLE<juce::uint64>(entry + 8, static_cast<juce::uint64>(presetOffset));
+      WriteLE<juce::uint32>(entry + 16, static_cast<juce::uint32>(data.getSize()));
+      WriteLE<juce::uint32>(entry + 20, 0);
+      entry += IndexEntrySize;
+
+      std::memcpy(names + nameOffset, name.data(), name.size());
+      nameOffset += name.size();
+      presetOffset = AlignUp(presetOffset + data.getSize());
+    }
+
+    juce::FileOutputStream stream(file);
+    if (!stream.openedOk())
+    {
+      return false;
+    }
+
+    stream.setPosition(0);
+    stream.truncate();
+
+    const char padding[PresetAlignment] = {};
+    const auto writePadded = [&stream, &padding](const void* data, size_t size)
+    {
+      return stream.write(data, size) && stream.write(padding, AlignUp(size) - size);
+    };
+
+    bool bOk = writePadded(head.data(), head.size());
+    for (const auto& preset : presets_)
+    {
+      bOk = bOk && writePadded(preset.second.getData(), preset.second.getSize());
+    }
+
+    stream.flush();
+    return bOk;
+  }
+
+// PresetBank impl:
+  PresetBank::PresetBank(const juce::File& file)
+  : file_(std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly))
+  {
+    data_ = static_cast<const juce::uint8*>(file_->getData());
+    size_ = file_->getSize();
+
+    if (!Validate())
+    {
+      numPresets_ = -1;
+    }
+  }
+
+  bool PresetBank::Validate() noexcept
+  {
+    using namespace PresetBankFormat;
+
+    if (data_ == nullptr || size_ < HeaderSize || std::memcmp(data_, Magic, sizeof(Magic)) != 0)
+    {
+      return false;
+    }
+
+    if (ReadLE<juce::uint16>(data_ + 4) != Version)
+    {
+      return false;
+    }
+
+    const auto numPresets = static_cast<size_t>(ReadLE<juce::uint32>(data_ + 8));
+    const auto namesSize = static_cast<size_t>(ReadLE<juce::uint32>(data_ + 12));
+    if (numPresets > static_cast<size_t>(std::numeric_limits<int>::max())
+        || numPresets > (size_ - HeaderSize) / IndexEntrySize
+        || namesSize > size_ - HeaderSize - numPresets * IndexEntrySize)
+    {
+      return false;
+    }
+
+    numPresets_ = static_cast<int>(numPresets);
+    names_ = reinterpret_cast<const char*>(data_ + HeaderSize + numPresets * IndexEntrySize);
+
+    // only the index is checked here, each preset validates itself when it is viewed
+    const char* previousName = nullptr;
+    size_t previousLength = 0;
+    for (int i = 0; i < numPresets_; ++i)
+    {
+      const IndexEntry entry = ReadIndexEntry(i);
+
+      if (entry.nameLength == 0
+          || entry.nameOffset > namesSize || entry.nameLength > namesSize - entry.nameOffset
+          || entry.presetOffset > size_ || entry.presetSize > size_ - entry.presetOffset)
+      {
+        return false;
+      }
+
+      // strictly ascending names, or the binary search can't be trusted
+      const char* name = names_ + entry.nameOffset;
+      if (previousName != nullptr)
+      {
+        const int order = std::memcmp(previousName, name, juce::jmin(previousLength, static_cast<size_t>(entry.nameLength)));
+        if (order > 0 || (order == 0 && previousLength >= entry.nameLength))
+        {
+          return false;
+        }
+      }
+
+      previousName = name;
+      previousLength = entry.nameLength;
+    }
+
+    return true;
+  }
+
+  PresetBank::IndexEntry PresetBank::ReadIndexEntry(int index) const noexcept
+  {
+    const juce::uint8* entry = data_ + PresetBankFormat::HeaderSize + PresetBankFormat::IndexEntrySize * static_cast<size_t>(index);
+    return { ReadLE<juce::uint32>(entry),
+             ReadLE<juce::uint16>(entry + 4),
+             ReadLE<juce::uint64>(entry + 8),
+             ReadLE<juce::uint32>(entry + 16) };
+  }
+
+  juce::String PresetBank::GetPresetName(int index) const
+  {
+    jassert(juce::isPositiveAndBelow(index, numPresets_));
+    const IndexEntry entry = ReadIndexEntry(index);
+    return juce::String::fromUTF8(names_ + entry.nameOffset, entry.nameLength);
+  }
+
+  int PresetBank::IndexOf(const juce::String& name) const noexcept
+  {
+    const char* key = name.toRawUTF8();
+    const size_t keyLength = name.getNumBytesAsUTF8();
+
+    int low = 0;
+    int high = GetNumPresets() - 1;
+    while (low <= high)
+    {
+      const int mid = low + (high - low) / 2;
+      const IndexEntry entry = ReadIndexEntry(mid);
+
+      int order = std::memcmp(names_ + entry.nameOffset, key, juce::jmin(keyLength, static_cast<size_t>(entry.nameLength)));
+      if (order == 0)
+      {
+        order = (entry.nameLength < keyLength) ? -1 : (entry.nameLength > keyLength) ? 1 : 0;
+      }
+
+      if (order == 0)
+      {
+        return mid;
+      }
+
+      if (order < 0)
+      {
+        low = mid + 1;
+      }
+      else
+      {
+        high = mid - 1;
+      }
+    }
+
+    return -1;
+  }
+
+  BinaryPresetView PresetBank::GetPreset(int index) const
+  {
+    jassert(juce::isPositiveAndBelow(index, numPresets_));
+    const IndexEntry entry = ReadIndexEntry(index);
+    return BinaryPresetView(data_ + entry.presetOffset, entry.presetSize);
+  }
+
+  bool PresetBank::LoadPreset(const juce::String& name, ParameterList& list) const
+  {
+    const int index = IndexOf(name);
+    if (index < 0)
+    {
+      return false;
+    }
+
+    const BinaryPresetView preset = GetPreset(index);
+    if (!preset.IsValid())
+    {
+      return false;
+    }
+
+    preset.ApplyTo(list);
+    return true;
+  }
+
+} // namespace Haze
@@ -0,0 +1,85 @@
+
+#pragma once
+
+#include "BinaryPreset.h"
+#include <map>
+#include <memory>
+#include <string>
+
+namespace Haze
+{
+  // many BinaryPreset blobs in one file, indexed by preset name
+  //
+  // layout (all integers little-endian):
+  //   header   "HZPK" | u16 version | u16 reserved | u32 numPresets | u32 namesSize
+  //   index    numPresets x { u32 nameOffset | u16 nameLength | u16 reserved | u64 presetOffset | u32 presetSize | u32 reserved }
+  //   names    utf-8 bytes of every preset name (offsets are relative to the names area)
+  //   presets  BinaryPreset blobs, 8 byte aligned (offsets are relative to the file)
+  //
+  // the index is sorted by name bytes, so the header, index and names are all a lookup ever touches;
+  // the preset blobs stay on disk until one is actually selected
+  namespace PresetBankFormat
+  {
+    constexpr juce::uint16 Version = 1;
+    constexpr size_t HeaderSize = 16;
+    constexpr size_t IndexEntrySize = 24;
+  } // namespace PresetBankFormat
+
+
+  // collects encoded presets and writes them out as a bank file
+  class PresetBankWriter
+  {
+  public:
+    // returns false (and keeps the existing preset) if name is already taken
+    bool AddPreset(const juce::String& name, const ParameterList& list);
+
+    [[nodiscard]] int GetNumPresets() const noexcept { return static_cast<int>(presets_.size()); }
+
+    bool WriteTo(const juce::File& file) const;
+
+  private:
+    std::map<std::string, juce::MemoryBlock> presets_; // keyed by utf-8 bytes == the on-disk sort order
+
+  }; // class PresetBankWriter
+
+
+  // read-only, memory-mapped bank
+  // opening maps the file and validates the index only; presets are decoded when loaded
+  class PresetBank
+  {
+  public:
+    explicit PresetBank(const juce::File& file);
+
+    [[nodiscard]] bool IsValid() const noexcept { return numPresets_ >= 0; }
+    [[nodiscard]] int GetNumPresets() const noexcept { return juce::jmax(numPresets_, 0); }
+
+    [[nodiscard]] juce::String GetPresetName(int index) const;
+    [[nodiscard]] int IndexOf(const juce::String& name) const noexcept; // binary search, -1 if not found
+
+    // zero-copy view of one preset (validated on construction, valid as long as the bank)
+    [[nodiscard]] BinaryPresetView GetPreset(int index) const;
+
+    // decodes the named preset into list, returns false if it is missing or damaged
+    bool LoadPreset(const juce::String& name, ParameterList& list) const;
+
+  private:
+    struct IndexEntry
+    {
+      juce::uint32 nameOffset;
+      juce::uint16 nameLength;
+      juce::uint64 presetOffset;
+      juce::uint32 presetSize;
+    };
+
+    IndexEntry ReadIndexEntry(int index) const noexcept;
+    bool Validate() noexcept;
+
+    std::unique_ptr<juce::MemoryMappedFile> file_;
+    const juce::uint8* data_ = nullptr;
+    size_t size_ = 0;
+    const char* names_ = nullptr;
+    int numPresets_ = -1; // -1: not a valid bank
+
+  }; // class PresetBank
+
+} // namespace Haze
@@ -1,7 +1,211 @@
 
 #include "ProcessorBase.h"
+#include <algorithm>
+#include <utility>
 
 namespace Haze
 {
+// ProcessorReclaimer impl:
+    ProcessorReclaimer::ProcessorReclaimer(int intervalMs)
+    : juce::Thread("Haze Processor Reclaimer")
+    , intervalMs_(intervalMs)
+    {
+        startThread();
+    }
 
-} // namespace Haze
\ No newline at end of file
+    ProcessorReclaimer::~ProcessorReclaimer()
+    {
+        // every proxy must be gone before its reclaimer
+        jassert(proxies_.empty());
+
+        stopThread(1000);
+    }
+
+    void ProcessorReclaimer::ReclaimNow()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (ProcessorProxy* proxy : proxies_)
+        {
+            proxy->Reclaim();
+        }
+    }
+
+    void ProcessorReclaimer::Register(ProcessorProxy& proxy)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        proxies_.push_back(&proxy);
+    }
+
+    void ProcessorReclaimer::Unregister(ProcessorProxy& proxy)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        proxies_.erase(std::remove(proxies_.begin(), proxies_.end(), &proxy), proxies_.end());
+    }
+
+    void ProcessorReclaimer::run()
+    {
+        while (!threadShouldExit())
+        {
+            wait(intervalMs_);
+            ReclaimNow();
+        }
+    }
+
+// ProcessorProxy impl:
+    ProcessorProxy::ProcessorProxy(ProcessorReclaimer& reclaimer, std::unique_ptr<ProcessorInterface> processor)
+    : reclaimer_(reclaimer)
+    , current_(processor.release())
+    , latest_(current_)
+    {
+        reclaimer_.Register(*this);
+    }
+
+    ProcessorProxy::~ProcessorProxy()
+    {
+        reclaimer_.Unregister(*this);
+
+        Reclaim();
+        DeletePending(pending_.exchange(nullptr));
+        delete current_;
+    }
+
+    void ProcessorProxy::SetProcessor(std::unique_ptr<ProcessorInterface> processor)
+    {
+        // (allocates, so it happens here and never on the audio thread)
+        if (processor != nullptr && spec_.has_value())
+        {
+            processor->prepare(*spec_);
+        }
+
+        latest_ = processor.get();
+
+        // whatever was still waiting never reached the audio thread, so it can go right away
+        ProcessorInterface* const next = processor != nullptr ? processor.release() : ClearRequest();
+        DeletePending(pending_.exchange(next, std::memory_order_acq_rel));
+    }
+
+    ProcessorInterface* ProcessorProxy::ClearRequest() noexcept
+    {
+        static char request;
+        return reinterpret_cast<ProcessorInterface*>(&request);
+    }
+
+    void ProcessorProxy::DeletePending(ProcessorInterface* pending) noexcept
+    {
+        if (pending != ClearRequest())
+        {
+            delete pending;
+        }
+    }
+
+    const ParameterList& ProcessorProxy::getUiParameterList() const
+    {
+        static const ParameterList empty;
+        return latest_ != nullptr ? latest_->getUiParameterList() : empty;
+    }
+
+    void ProcessorProxy::prepare(const ProcessSpec& spec)
+    {
+        spec_ = spec;
+
+        if (current_ != nullptr)
+        {
+            current_->prepare(spec);
+        }
+
+        if (ProcessorInterface* pending = pending_.load(std::memory_order_acquire); pending != nullptr && pending != ClearRequest())
+        {
+            pending->prepare(spec);
+        }
+    }
+
+    void ProcessorProxy::exec()
+    {
+        PickUpPending();
+        ForwardEvents();
+
+        if (current_ != nullptr)
+        {
+            current_->exec();
+        }
+    }
+
+    void ProcessorProxy::processBlock(AudioBlockView<float> block, const BlockContext& context)
+    {
+        PickUpPending();
+        ForwardEvents();
+
+        if (current_ != nullptr)
+        {
+            current_->processBlock(block, context);
+        }
+    }
+
+    void ProcessorProxy::processBlock(AudioBlockView<double> block, const BlockContext& context)
+    {
+        PickUpPending();
+        ForwardEvents();
+
+        if (current_ != nullptr)
+        {
+            current_->processBlock(block, context);
+        }
+    }
+
+    void ProcessorProxy::PickUpPending() noexcept
+    {
+        // (a full retire fifo just postpones the swap to a later block)
+        if (pending_.load(std::memory_order_relaxed) != nullptr && retireFifo_.getFreeSpace() > 0)
+        {
+            if (ProcessorInterface* next = pending_.exchange(nullptr, std::memory_order_acq_rel))
+            {
+                if (current_ != nullptr)
+                {
+                    int start1, size1, start2, size2;
+                    retireFifo_.prepareToWrite(1, start1, size1, start2, size2);
+                    retired_[static_cast<size_t>(size1 > 0 ? start1 : start2)] = current_;
+                    retireFifo_.finishedWrite(1);
+                }
+
+                current_ = next != ClearRequest() ? next : nullptr;
+                numSwaps_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void ProcessorProxy::ForwardEvents() noexcept
+    {
+        if (events_.IsEmpty())
+        {
+            return;
+        }
+
+        if (ParameterEventQueue* destination = current_ != nullptr ? current_->getParameterEvents() : nullptr)
+        {
+            events_.MoveInto(*destination);
+        }
+        else
+        {
+            events_.Clear();
+        }
+    }
+
+    void ProcessorProxy::Reclaim()
+    {
+        int start1, size1, start2, size2;
+        retireFifo_.prepareToRead(retireFifo_.getNumReady(), start1, size1, start2, size2);
+
+        for (int i = 0; i < size1; ++i)
+        {
+            delete std::exchange(retired_[static_cast<size_t>(start1 + i)], nullptr);
+        }
+
+        for (int i = 0; i < size2; ++i)
+        {
+            delete std::exchange(retired_[static_cast<size_t>(start2 + i)], nullptr);
+        }
+
+        retireFifo_.finishedRead(size1 + size2);
+    }
+
+} // namespace Haze
@@ -2,6 +2,12 @@
 #pragma once
 
 #include "ParameterTypes.h"
+#include "AudioBlock.h"
+#include "ParameterEvents.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <optional>
 
 namespace Haze
 {
@@ -16,21 +22,130 @@ namespace Haze
 
         virtual void exec() = 0;
 
+        // block api (message thread: prepare(), audio thread: processBlock())
+        // buffers arrive as non-owning planar views of any size up to spec.maxBlockSize, processed in place.
+        // the defaults ignore the audio and fall back on exec(), so control-only processors need not care
+        // (overriding one processBlock() hides the other, add `using ProcessorInterface::processBlock;`)
+        virtual void prepare(const ProcessSpec& spec) { juce::ignoreUnused(spec); }
+
+        virtual void processBlock(AudioBlockView<float> block, const BlockContext& context)
+        {
+            juce::ignoreUnused(block, context);
+            exec();
+        }
+
+        virtual void processBlock(AudioBlockView<double> block, const BlockContext& context)
+        {
+            juce::ignoreUnused(block, context);
+            exec();
+        }
+
+        // sample-accurate parameter changes (audio thread): processors that support them return their queue,
+        // the caller fills it before processBlock()/exec() and the processor applies each event at its offset
+        virtual ParameterEventQueue* getParameterEvents() { return nullptr; }
+
     }; // class ProcessorInterface
 
-    
 
-    class ProcessorProxy
+    class ProcessorProxy;
+
+    // frees processors retired by ProcessorProxy on a background thread
+    // (one reclaimer serves any number of proxies)
+    class ProcessorReclaimer : private juce::Thread
     {
     public:
-        void SetProcessor(const ProcessorInterface& processor)
-        {
-            juce::ignoreUnused(processor);
-            
-        }
+        explicit ProcessorReclaimer(int intervalMs = 50);
+        ~ProcessorReclaimer() override;
+
+        // frees everything retired so far (also called periodically from the background thread)
+        void ReclaimNow();
+
+    private:
+        friend class ProcessorProxy;
+
+        void Register(ProcessorProxy& proxy);
+        void Unregister(ProcessorProxy& proxy);
+
+        void run() override;
+
+        const int intervalMs_;
+        std::mutex mutex_; // (never taken on the audio thread)
+        std::vector<ProcessorProxy*> proxies_;
+
+    }; // class ProcessorReclaimer
+
+
+    // stands in for a processor that can be replaced while the audio thread runs it
+    //
+    // SetProcessor() (message thread) publishes the new instance through one atomic pointer.
+    // exec()/processBlock() (audio thread) pick it up at the start of the next block, run it, and push the
+    // old instance into a preallocated retire fifo: no locks, no allocation, no deallocation.
+    // the ProcessorReclaimer deletes retired instances on its own thread
+    class ProcessorProxy : public ProcessorInterface
+    {
+    public:
+        explicit ProcessorProxy(ProcessorReclaimer& reclaimer, std::unique_ptr<ProcessorInterface> processor = {});
+
+        // (the audio thread must be done w/ the proxy)
+        ~ProcessorProxy() override;
+
+        // message thread
+        // a processor published but not picked up yet is replaced (and freed right here).
+        // nullptr clears the proxy: the audio thread retires its processor on the next block and runs nothing
+        void SetProcessor(std::unique_ptr<ProcessorInterface> processor);
+
+        // the most recently set processor's parameters (message thread)
+        const ParameterList& getUiParameterList() const override;
+
+        // message thread, while the audio thread is stopped
+        // prepares the current processor, and every processor set from now on before it's published
+        void prepare(const ProcessSpec& spec) override;
+
+        // audio thread
+        void exec() override;
+        void processBlock(AudioBlockView<float> block, const BlockContext& context) override;
+        void processBlock(AudioBlockView<double> block, const BlockContext& context) override;
+
+        // (audio thread) events go to whichever processor runs the next block, even across a swap
+        ParameterEventQueue* getParameterEvents() override { return &events_; }
+
+        [[nodiscard]] int GetNumSwaps() const noexcept { return numSwaps_.load(std::memory_order_relaxed); }
 
     private:
-        
+        friend class ProcessorReclaimer;
+
+        // deletes everything in the retire fifo (reclaimer thread)
+        void Reclaim();
+
+        // swaps in the pending processor, if any (audio thread, start of every block)
+        void PickUpPending() noexcept;
+
+        // hands the queued events to the current processor (dropped if it takes none)
+        void ForwardEvents() noexcept;
+
+        // pending_ value for "clear": retire current_, run nothing (never dereferenced)
+        static ProcessorInterface* ClearRequest() noexcept;
+
+        // frees a pending_ value that never reached the audio thread
+        static void DeletePending(ProcessorInterface* pending) noexcept;
+
+        static constexpr int RetireCapacity = 64;
+
+        ProcessorReclaimer& reclaimer_;
+
+        std::atomic<ProcessorInterface*> pending_ { nullptr }; // message -> audio
+        ProcessorInterface* current_ = nullptr;                 // audio thread owned
+        ProcessorInterface* latest_ = nullptr;                  // message thread view
+        std::optional<ProcessSpec> spec_;                       // message thread, set once prepared
+
+        // audio -> reclaimer
+        juce::AbstractFifo retireFifo_ { RetireCapacity };
+        std::array<ProcessorInterface*, RetireCapacity> retired_ {};
+        std::atomic<int> numSwaps_ { 0 };
+
+        ParameterEventQueue events_; // (audio thread)
+
+        JUCE_DECLARE_NON_COPYABLE(ProcessorProxy)
     }; // class ProcessorProxy
 
-} // namespace Haze
\ No newline at end of file
+} // namespace Haze
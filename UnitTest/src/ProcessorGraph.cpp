@@ -0,0 +1,283 @@
+
+#include "ProcessorGraph.h"
+#include <algorithm>
+
+namespace Haze
+{
+  ProcessorGraph::NodeId ProcessorGraph::AddNode(std::unique_ptr<ProcessorInterface> processor, ThreadDomain domain)
+  {
+    jassert(processor != nullptr);
+    jassert(domain != ThreadDomain::NumDomains);
+
+    nodes_.push_back({ std::move(processor), domain, {}, {} });
+    bIsPrepared_ = false;
+    return GetNumNodes() - 1;
+  }
+
+  bool ProcessorGraph::Connect(NodeId source, NodeId destination, int maxFrameSize)
+  {
+    if (!juce::isPositiveAndBelow(source, GetNumNodes()) || !juce::isPositiveAndBelow(destination, GetNumNodes()))
+    {
+      return false;
+    }
+
+    if (GetDomain(source) != GetDomain(destination))
+    {
+      // data exchange only, no ordering (so no cycle to worry about either)
+      if (GetMailbox(source, destination) != nullptr)
+      {
+        return false;
+      }
+
+      crossDomainEdges_.push_back({ source, destination, std::make_unique<FrameMailbox>(maxFrameSize) });
+      return true;
+    }
+
+    std::vector<NodeId>& outputs = nodes_[static_cast<size_t>(source)].outputs;
+    if (source == destination || std::find(outputs.begin(), outputs.end(), destination) != outputs.end() || Reaches(destination, source))
+    {
+      return false;
+    }
+
+    outputs.push_back(destination);
+    nodes_[static_cast<size_t>(destination)].inputs.push_back(source);
+    bIsPrepared_ = false;
+    return true;
+  }
+
+  bool ProcessorGraph::Reaches(NodeId from, NodeId to) const
+  {
+    std::vector<bool> visited(nodes_.size(), false);
+    std::vector<NodeId> stack { from };
+
+    while (!stack.empty())
+    {
+      const NodeId node = stack.back();
+      stack.pop_back();
+
+      if (node == to)
+      {
+        return true;
+      }
+
+      if (!visited[static_cast<size_t>(node)])
+      {
+        visited[static_cast<size_t>(node)] = true;
+        const auto& outputs = nodes_[static_cast<size_t>(node)].outputs;
+        stack.insert(stack.end(), outputs.begin(), outputs.end());
+      }
+    }
+
+    return false;
+  }
+
+  FrameMailbox* ProcessorGraph::GetMailbox(NodeId source, NodeId destination) const
+  {
+    for (const CrossDomainEdge& edge : crossDomainEdges_)
+    {
+      if (edge.source == source && edge.destination == destination)
+      {
+        return edge.mailbox.get();
+      }
+    }
+
+    return nullptr;
+  }
+
+  void ProcessorGraph::Prepare()
+  {
+    // Kahn's algorithm per domain (outputs never leave their domain, Connect() already refused cycles)
+    std::vector<int> numInputs(nodes_.size());
+    for (Schedule& schedule : schedules_)
+    {
+      schedule.order.clear();
+      schedule.roots.clear();
+    }
+
+    for (size_t i = 0; i < nodes_.size(); ++i)
+    {
+      numInputs[i] = static_cast<int>(nodes_[i].inputs.size());
+      if (numInputs[i] == 0)
+      {
+        Schedule& schedule = schedules_[static_cast<size_t>(nodes_[i].domain)];
+        schedule.roots.push_back(static_cast<NodeId>(i));
+        schedule.order.push_back(static_cast<NodeId>(i));
+      }
+    }
+
+    for (Schedule& schedule : schedules_)
+    {
+      for (size_t i = 0; i < schedule.order.size(); ++i)
+      {
+        for (const NodeId output : nodes_[static_cast<size_t>(schedule.order[i])].outputs)
+        {
+          if (--numInputs[static_cast<size_t>(output)] == 0)
+          {
+            schedule.order.push_back(output);
+          }
+        }
+      }
+    }
+    jassert(std::all_of(numInputs.begin(), numInputs.end(), [](int n) { return n == 0; })); // every node scheduled
+
+    // flat successor lists
+    successorOffsets_.assign(1, 0);
+    successors_.clear();
+    for (const Node& node : nodes_)
+    {
+      successors_.insert(successors_.end(), node.outputs.begin(), node.outputs.end());
+      successorOffsets_.push_back(static_cast<int>(successors_.size()));
+    }
+
+    pendingInputs_ = std::make_unique<std::atomic<int>[]>(nodes_.size());
+
+    for (Schedule& schedule : schedules_)
+    {
+      schedule.tasks.numTasks = static_cast<int>(schedule.order.size());
+      schedule.tasks.roots = schedule.roots.data();
+      schedule.tasks.numRoots = static_cast<int>(schedule.roots.size());
+      schedule.tasks.successorOffsets = successorOffsets_.data();
+      schedule.tasks.successors = successors_.data();
+      schedule.tasks.pendingInputs = pendingInputs_.get();
+      schedule.tasks.run = &ProcessorGraph::RunNode;
+      schedule.tasks.context = this;
+
+      schedule.blockTasks = schedule.tasks;
+      schedule.blockTasks.run = &ProcessorGraph::RunNodeBlock;
+      schedule.blockTasks.context = &blockPass_;
+    }
+    blockPass_.graph = this;
+
+    sinks_.clear();
+    for (const NodeId node : schedules_[static_cast<size_t>(ThreadDomain::Audio)].order)
+    {
+      if (nodes_[static_cast<size_t>(node)].outputs.empty())
+      {
+        sinks_.push_back(node);
+      }
+    }
+
+    spec_.reset();
+    bIsPrepared_ = true;
+  }
+
+  void ProcessorGraph::Prepare(const ProcessSpec& spec)
+  {
+    Prepare();
+
+    buffers_.resize(nodes_.size());
+    for (size_t i = 0; i < nodes_.size(); ++i)
+    {
+      const bool bIsAudio = nodes_[i].domain == ThreadDomain::Audio;
+      buffers_[i].SetSize(bIsAudio ? spec.numChannels : 0, bIsAudio ? spec.maxBlockSize : 0);
+      nodes_[i].processor->prepare(spec);
+    }
+
+    spec_ = spec;
+  }
+
+  void ProcessorGraph::Process(ThreadDomain domain)
+  {
+    jassert(bIsPrepared_);
+
+    for (const NodeId node : schedules_[static_cast<size_t>(domain)].order)
+    {
+      RunNode(this, node);
+    }
+  }
+
+  void ProcessorGraph::Process(WorkerPool& pool, ThreadDomain domain)
+  {
+    RunTasks(pool, domain, schedules_[static_cast<size_t>(domain)].tasks);
+  }
+
+  void ProcessorGraph::RunTasks(WorkerPool& pool, ThreadDomain domain, const TaskSet& tasks)
+  {
+    jassert(bIsPrepared_);
+    jassert(GetNumNodes() <= pool.GetMaxTasks());
+
+    // (each domain only resets the counters of its own nodes)
+    for (const NodeId node : schedules_[static_cast<size_t>(domain)].order)
+    {
+      pendingInputs_[static_cast<size_t>(node)].store(static_cast<int>(nodes_[static_cast<size_t>(node)].inputs.size()), std::memory_order_relaxed);
+    }
+
+    pool.Run(tasks);
+  }
+
+  void ProcessorGraph::ProcessBlock(AudioBlockView<float> io, const BlockContext& context)
+  {
+    ProcessBlockChunks(io, context, [this]
+    {
+      for (const NodeId node : schedules_[static_cast<size_t>(ThreadDomain::Audio)].order)
+      {
+        RunNodeBlock(&blockPass_, node);
+      }
+    });
+  }
+
+  void ProcessorGraph::ProcessBlock(WorkerPool& pool, AudioBlockView<float> io, const BlockContext& context)
+  {
+    ProcessBlockChunks(io, context, [this, &pool]
+    {
+      RunTasks(pool, ThreadDomain::Audio, schedules_[static_cast<size_t>(ThreadDomain::Audio)].blockTasks);
+    });
+  }
+
+  template <typename RunPass>
+  void ProcessorGraph::ProcessBlockChunks(AudioBlockView<float> io, const BlockContext& context, RunPass&& runPass)
+  {
+    jassert(bIsPrepared_ && spec_.has_value()); // Prepare(spec) first
+    jassert(io.GetNumChannels() <= spec_->numChannels);
+
+    const int maxBlockSize = spec_->maxBlockSize;
+    for (int offset = 0; offset < io.GetNumSamples(); offset += maxBlockSize)
+    {
+      const AudioBlockView<float> chunk = io.GetSubBlock(offset, juce::jmin(maxBlockSize, io.GetNumSamples() - offset));
+      blockPass_.io = chunk;
+      blockPass_.context = context.Advanced(offset);
+
+      runPass();
+
+      for (size_t i = 0; i < sinks_.size(); ++i)
+      {
+        const AudioBlockView<float> sink = buffers_[static_cast<size_t>(sinks_[i])].GetView(chunk.GetNumChannels(), chunk.GetNumSamples());
+        i == 0 ? chunk.CopyFrom(sink) : chunk.AddFrom(sink);
+      }
+    }
+  }
+
+  void ProcessorGraph::RunNode(void* graph, int node)
+  {
+    static_cast<ProcessorGraph*>(graph)->nodes_[static_cast<size_t>(node)].processor->exec();
+  }
+
+  void ProcessorGraph::RunNodeBlock(void* pass, int node)
+  {
+    const BlockPass& blockPass = *static_cast<const BlockPass*>(pass);
+    const ProcessorGraph& graph = *blockPass.graph;
+    const Node& entry = graph.nodes_[static_cast<size_t>(node)];
+    jassert(entry.domain == ThreadDomain::Audio);
+
+    const int numChannels = blockPass.io.GetNumChannels();
+    const int numSamples = blockPass.io.GetNumSamples();
+    const AudioBlockView<float> buffer = graph.buffers_[static_cast<size_t>(node)].GetView(numChannels, numSamples);
+
+    // (inputs finished before this node was scheduled, so their buffers are complete)
+    if (entry.inputs.empty())
+    {
+      buffer.CopyFrom(blockPass.io);
+    }
+    else
+    {
+      for (size_t i = 0; i < entry.inputs.size(); ++i)
+      {
+        const AudioBlockView<float> input = graph.buffers_[static_cast<size_t>(entry.inputs[i])].GetView(numChannels, numSamples);
+        i == 0 ? buffer.CopyFrom(input) : buffer.AddFrom(input);
+      }
+    }
+
+    entry.processor->processBlock(buffer, blockPass.context);
+  }
+
+} // namespace Haze
@@ -0,0 +1,147 @@
+
+#pragma once
+
+#include "ProcessorBase.h"
+#include "DomainMailbox.h"
+#include "WorkerPool.h"
+#include <optional>
+
+namespace Haze
+{
+  // which thread runs a node
+  enum class ThreadDomain
+  {
+    Audio, // the audio callback
+    Ui,    // message thread, ui rate (analysis, metering)
+    Debug, // background/diagnostic work
+    NumDomains
+  };
+
+
+  // directed graph of processors, each tagged w/ the ThreadDomain that runs it
+  // an edge source -> destination means destination consumes source's output:
+  //  - within a domain it orders execution (destination runs after source, cycles are refused)
+  //  - across domains it becomes a FrameMailbox: source publishes frames whenever it runs and
+  //    destination reads the latest one whenever *its* domain runs, so neither thread ever waits on the other
+  // Prepare() flattens every domain into its own schedule; Process(domain) then runs one pass of that
+  // domain, either in topological order on the calling thread or spread across a WorkerPool
+  //
+  // audio domain edges can also carry audio: after Prepare(spec) every audio node owns an aligned buffer,
+  // and ProcessBlock() feeds each node the sum of its inputs' buffers (or the graph input) via processBlock()
+  class ProcessorGraph
+  {
+  public:
+    using NodeId = int;
+
+    static constexpr int DefaultFrameSize = 2048;
+
+    // topology (message thread, call Prepare() afterwards)
+    NodeId AddNode(std::unique_ptr<ProcessorInterface> processor, ThreadDomain domain = ThreadDomain::Audio);
+
+    // returns false for unknown nodes, duplicate edges and same-domain edges that would close a cycle
+    // (maxFrameSize only matters for cross-domain edges, see GetMailbox())
+    bool Connect(NodeId source, NodeId destination, int maxFrameSize = DefaultFrameSize);
+
+    [[nodiscard]] int GetNumNodes() const noexcept { return static_cast<int>(nodes_.size()); }
+    [[nodiscard]] ProcessorInterface& GetProcessor(NodeId node) const { return *nodes_[static_cast<size_t>(node)].processor; }
+    [[nodiscard]] ThreadDomain GetDomain(NodeId node) const { return nodes_[static_cast<size_t>(node)].domain; }
+
+    // same-domain outputs only
+    [[nodiscard]] const std::vector<NodeId>& GetOutputs(NodeId node) const { return nodes_[static_cast<size_t>(node)].outputs; }
+
+    // the mailbox behind a cross-domain edge (nullptr if there is none), hand it to both processors
+    [[nodiscard]] FrameMailbox* GetMailbox(NodeId source, NodeId destination) const;
+
+    // a domain's nodes in an order where every node comes after its (same-domain) inputs, valid after Prepare()
+    [[nodiscard]] const std::vector<NodeId>& GetExecutionOrder(ThreadDomain domain = ThreadDomain::Audio) const noexcept
+    {
+      return schedules_[static_cast<size_t>(domain)].order;
+    }
+
+    void Prepare();
+    [[nodiscard]] bool IsPrepared() const noexcept { return bIsPrepared_; }
+
+    // Prepare(), plus a buffer per audio node and ProcessorInterface::prepare(spec) on every processor
+    void Prepare(const ProcessSpec& spec);
+
+    // audio nodes w/o inputs, and w/o outputs (valid after Prepare())
+    [[nodiscard]] const std::vector<NodeId>& GetSources() const noexcept { return schedules_[static_cast<size_t>(ThreadDomain::Audio)].roots; }
+    [[nodiscard]] const std::vector<NodeId>& GetSinks() const noexcept { return sinks_; }
+
+    // one pass of a domain's nodes, from that domain's thread (never allocates)
+    // different domains may be processed concurrently, one thread per domain at a time,
+    // and domains processed concurrently need a WorkerPool each (a pool runs one pass at a time)
+    void Process(ThreadDomain domain = ThreadDomain::Audio);
+    void Process(WorkerPool& pool, ThreadDomain domain = ThreadDomain::Audio);
+
+    // one audio domain pass w/ audio, in place on io (needs Prepare(spec), never allocates):
+    //  - sources get a copy of io, every other node the sum of its inputs' outputs
+    //  - io ends up holding the sum of the sinks' outputs (and is left alone if there are no audio nodes)
+    // blocks longer than spec.maxBlockSize are run as several passes
+    void ProcessBlock(AudioBlockView<float> io, const BlockContext& context);
+    void ProcessBlock(WorkerPool& pool, AudioBlockView<float> io, const BlockContext& context);
+
+  private:
+    struct Node
+    {
+      std::unique_ptr<ProcessorInterface> processor;
+      ThreadDomain domain;
+      std::vector<NodeId> outputs;
+      std::vector<NodeId> inputs; // (same domain)
+    };
+
+    struct CrossDomainEdge
+    {
+      NodeId source;
+      NodeId destination;
+      std::unique_ptr<FrameMailbox> mailbox;
+    };
+
+    // the chunk an audio domain ProcessBlock() pass is working on, handed to its tasks as their context
+    // (only ever touched by the audio thread: other domains' passes never see it)
+    struct BlockPass
+    {
+      ProcessorGraph* graph = nullptr;
+      AudioBlockView<float> io;
+      BlockContext context;
+    };
+
+    struct Schedule
+    {
+      std::vector<NodeId> order;
+      std::vector<NodeId> roots;
+      TaskSet tasks;      // exec() per node
+      TaskSet blockTasks; // processBlock() per node (audio domain only)
+    };
+
+    bool Reaches(NodeId from, NodeId to) const;
+
+    // resets the counters of a domain's nodes, then runs one of its task sets
+    void RunTasks(WorkerPool& pool, ThreadDomain domain, const TaskSet& tasks);
+
+    template <typename RunPass>
+    void ProcessBlockChunks(AudioBlockView<float> io, const BlockContext& context, RunPass&& runPass);
+
+    static void RunNode(void* graph, int node);
+    static void RunNodeBlock(void* pass, int node);
+
+    std::vector<Node> nodes_;
+    std::vector<CrossDomainEdge> crossDomainEdges_;
+
+    // per domain schedules (task ids are node ids, so the successor arrays are shared)
+    std::array<Schedule, static_cast<size_t>(ThreadDomain::NumDomains)> schedules_;
+    std::vector<int> successorOffsets_;
+    std::vector<NodeId> successors_;
+    std::unique_ptr<std::atomic<int>[]> pendingInputs_;
+    bool bIsPrepared_ = false;
+
+    // audio buffers (after Prepare(spec)), one per node, empty for other domains
+    std::optional<ProcessSpec> spec_;
+    std::vector<AlignedAudioBuffer<float>> buffers_;
+    std::vector<NodeId> sinks_;
+
+    BlockPass blockPass_; // (audio thread)
+
+  }; // class ProcessorGraph
+
+} // namespace Haze
@@ -0,0 +1,190 @@
+
+#include "RealtimeCheck.h"
+
+#if HAZE_REALTIME_CHECKS
+ #include <atomic>
+ #include <cstdlib>
+ #include <mutex>
+ #include <new>
+ #include <utility>
+ #if JUCE_LINUX
+  #include <dlfcn.h>
+  #include <pthread.h>
+ #endif
+#endif
+
+namespace Haze
+{
+namespace RealtimeCheck
+{
+  juce::String Violation::ToString() const
+  {
+    const juce::String what = kind == Kind::Allocation ? "allocation of " + juce::String(static_cast<juce::int64>(numBytes)) + " bytes"
+                            : kind == Kind::Deallocation ? juce::String("deallocation")
+                            : juce::String("mutex lock");
+    return what + " on a realtime thread\n" + stackTrace;
+  }
+
+#if HAZE_REALTIME_CHECKS
+  namespace
+  {
+    thread_local int realtimeDepth = 0;
+    thread_local bool bIsReporting = false; // (recording a violation allocates and locks too)
+
+    std::atomic<int> numViolations { 0 };
+
+    std::mutex& GetMutex()
+    {
+      static std::mutex mutex;
+      return mutex;
+    }
+
+    std::vector<Violation>& GetViolations()
+    {
+      static std::vector<Violation> violations;
+      return violations;
+    }
+
+    // called from the interposed functions below
+    void Report(Kind kind, size_t numBytes) noexcept
+    {
+      if (realtimeDepth == 0 || bIsReporting)
+      {
+        return;
+      }
+
+      bIsReporting = true;
+      numViolations.fetch_add(1);
+      {
+        Violation violation { kind, numBytes, juce::SystemStats::getStackBacktrace() };
+        std::lock_guard<std::mutex> lock(GetMutex());
+        GetViolations().push_back(std::move(violation));
+      }
+      bIsReporting = false;
+    }
+  } // namespace
+
+  void EnterRealtime() noexcept { ++realtimeDepth; }
+  void LeaveRealtime() noexcept { jassert(realtimeDepth > 0); --realtimeDepth; }
+  bool IsRealtimeThread() noexcept { return realtimeDepth > 0; }
+
+  int GetNumViolations() noexcept { return numViolations.load(); }
+
+  std::vector<Violation> TakeViolations()
+  {
+    std::lock_guard<std::mutex> lock(GetMutex());
+    numViolations.store(0);
+    return std::exchange(GetViolations(), {});
+  }
+
+  bool CanDetectLocks() noexcept
+  {
+   #if JUCE_LINUX
+    return true;
+   #else
+    return false;
+   #endif
+  }
+#endif
+
+} // namespace RealtimeCheck
+} // namespace Haze
+
+
+#if HAZE_REALTIME_CHECKS
+
+// global allocation functions, every replaceable form (malloc/free underneath, same as the defaults)
+namespace
+{
+  void* Allocate(std::size_t size) noexcept
+  {
+    Haze::RealtimeCheck::Report(Haze::RealtimeCheck::Kind::Allocation, size);
+    return std::malloc(size > 0 ? size : 1);
+  }
+
+  void* AllocateAligned(std::size_t size, std::align_val_t alignment) noexcept
+  {
+    Haze::RealtimeCheck::Report(Haze::RealtimeCheck::Kind::Allocation, size);
+
+   #if JUCE_WINDOWS
+    return _aligned_malloc(size > 0 ? size : 1, static_cast<std::size_t>(alignment));
+   #else
+    void* ptr = nullptr;
+    return posix_memalign(&ptr, juce::jmax(static_cast<std::size_t>(alignment), sizeof(void*)), size > 0 ? size : 1) == 0 ? ptr : nullptr;
+   #endif
+  }
+
+  void Free(void* ptr) noexcept
+  {
+    if (ptr != nullptr)
+    {
+      Haze::RealtimeCheck::Report(Haze::RealtimeCheck::Kind::Deallocation, 0);
+      std::free(ptr);
+    }
+  }
+
+  void FreeAligned(void* ptr) noexcept
+  {
+    if (ptr != nullptr)
+    {
+      Haze::RealtimeCheck::Report(Haze::RealtimeCheck::Kind::Deallocation, 0);
+     #if JUCE_WINDOWS
+      _aligned_free(ptr);
+     #else
+      std::free(ptr);
+     #endif
+    }
+  }
+
+  void* AllocateOrThrow(void* ptr)
+  {
+    if (ptr == nullptr)
+    {
+      throw std::bad_alloc();
+    }
+    return ptr;
+  }
+} // namespace
+
+void* operator new(std::size_t size) { return AllocateOrThrow(Allocate(size)); }
+void* operator new[](std::size_t size) { return AllocateOrThrow(Allocate(size)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return Allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return Allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return AllocateOrThrow(AllocateAligned(size, alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return AllocateOrThrow(AllocateAligned(size, alignment)); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return AllocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return AllocateAligned(size, alignment); }
+
+void operator delete(void* ptr) noexcept { Free(ptr); }
+void operator delete[](void* ptr) noexcept { Free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { Free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { Free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { Free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { Free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(ptr); }
+
+#if JUCE_LINUX
+// interposes libc's pthread_mutex_lock (std::mutex, juce::CriticalSection, ... all end up here)
+extern "C" int pthread_mutex_lock(pthread_mutex_t* mutex)
+{
+  using LockFunction = int (*)(pthread_mutex_t*);
+  static std::atomic<LockFunction> next { nullptr };
+
+  LockFunction lock = next.load(std::memory_order_relaxed);
+  if (lock == nullptr)
+  {
+    lock = reinterpret_cast<LockFunction>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+    next.store(lock, std::memory_order_relaxed);
+  }
+
+  Haze::RealtimeCheck::Report(Haze::RealtimeCheck::Kind::Lock, 0);
+  return lock(mutex);
+}
+#endif
+
+#endif // HAZE_REALTIME_CHECKS
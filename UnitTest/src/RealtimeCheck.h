@@ -0,0 +1,71 @@
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+namespace Haze
+{
+  // realtime safety checker (test builds, HAZE_REALTIME_CHECKS=1)
+  //
+  // while a thread is inside a ScopedRealtimeThread, every global operator new/delete and every
+  // pthread_mutex_lock() it makes (std::mutex, juce::CriticalSection, ...) is recorded as a Violation,
+  // w/ the call stack that made it. the call itself still goes through, the test decides what to do.
+  // lock interception needs symbol interposition, so it is linux only; allocations are caught everywhere.
+  // w/o HAZE_REALTIME_CHECKS everything here is an inline no-op and nothing is intercepted
+  namespace RealtimeCheck
+  {
+    enum class Kind
+    {
+      Allocation,
+      Deallocation,
+      Lock
+    };
+
+    struct Violation
+    {
+      Kind kind;
+      size_t numBytes; // (allocations only)
+      juce::String stackTrace;
+
+      [[nodiscard]] juce::String ToString() const;
+    };
+
+   #if HAZE_REALTIME_CHECKS
+    constexpr bool IsEnabled = true;
+
+    // nestable, per thread
+    void EnterRealtime() noexcept;
+    void LeaveRealtime() noexcept;
+    [[nodiscard]] bool IsRealtimeThread() noexcept;
+
+    // violations recorded so far, by any thread
+    [[nodiscard]] int GetNumViolations() noexcept;
+    [[nodiscard]] std::vector<Violation> TakeViolations();
+
+    // whether this platform also intercepts locks
+    [[nodiscard]] bool CanDetectLocks() noexcept;
+   #else
+    constexpr bool IsEnabled = false;
+
+    inline void EnterRealtime() noexcept {}
+    inline void LeaveRealtime() noexcept {}
+    [[nodiscard]] inline bool IsRealtimeThread() noexcept { return false; }
+    [[nodiscard]] inline int GetNumViolations() noexcept { return 0; }
+    [[nodiscard]] inline std::vector<Violation> TakeViolations() { return {}; }
+    [[nodiscard]] inline bool CanDetectLocks() noexcept { return false; }
+   #endif
+
+    // marks the calling thread realtime for its lifetime (e.g. around an audio callback)
+    class ScopedRealtimeThread
+    {
+    public:
+      ScopedRealtimeThread() noexcept { EnterRealtime(); }
+      ~ScopedRealtimeThread() noexcept { LeaveRealtime(); }
+
+      JUCE_DECLARE_NON_COPYABLE(ScopedRealtimeThread)
+    };
+
+  } // namespace RealtimeCheck
+
+} // namespace Haze
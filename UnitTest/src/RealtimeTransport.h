@@ -0,0 +1,88 @@
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <type_traits>
+
+namespace Haze
+{
+  // values that fit in a lock-free std::atomic are published w/ a single store/load
+  // (std::atomic<T> may only be named for trivially copyable T, hence the two steps)
+  template <typename T, bool = std::is_trivially_copyable<T>::value>
+  struct IsAtomicTransportableImpl : std::bool_constant<std::atomic<T>::is_always_lock_free> {};
+
+  template <typename T>
+  struct IsAtomicTransportableImpl<T, false> : std::false_type {};
+
+  template <typename T>
+  constexpr bool IsAtomicTransportable = IsAtomicTransportableImpl<T>::value;
+
+
+  // single writer / single reader triple buffer
+  // the writer never waits on the reader and the reader never waits (or allocates): each side owns
+  // one slot, and the third "middle" slot is traded through one atomic exchange
+  template <typename T>
+  class TripleBuffer
+  {
+  public:
+    explicit TripleBuffer(const T& initial) : buffers_{ { initial, initial, initial } } {}
+
+    // writer side
+    void Write(const T& value)
+    {
+      buffers_[static_cast<size_t>(writeIndex_)] = value;
+      writeIndex_ = middle_.exchange(writeIndex_ | DirtyBit, std::memory_order_acq_rel) & IndexMask;
+    }
+
+    // reader side (latest published value, valid until the next Read())
+    const T& Read() const noexcept
+    {
+      if (middle_.load(std::memory_order_relaxed) & DirtyBit)
+      {
+        readIndex_ = middle_.exchange(readIndex_, std::memory_order_acq_rel) & IndexMask;
+      }
+
+      return buffers_[static_cast<size_t>(readIndex_)];
+    }
+
+  private:
+    static constexpr int IndexMask = 0x3;
+    static constexpr int DirtyBit = 0x4;
+
+    std::array<T, 3> buffers_;
+    int writeIndex_ = 0;                    // writer owned
+    mutable std::atomic<int> middle_ { 1 }; // shared
+    mutable int readIndex_ = 2;             // reader owned
+  }; // TripleBuffer<T>
+
+
+  // message thread -> audio thread mailbox for one parameter value
+  template <typename T, bool = IsAtomicTransportable<T>>
+  class RealtimeValue
+  {
+  public:
+    explicit RealtimeValue(const T& initial) : value_(initial) {}
+
+    void Store(const T& value) noexcept { value_.store(value, std::memory_order_release); }
+    T Load() const noexcept { return value_.load(std::memory_order_acquire); }
+
+  private:
+    std::atomic<T> value_;
+  }; // RealtimeValue<T> (atomic)
+
+  template <typename T>
+  class RealtimeValue<T, false>
+  {
+  public:
+    explicit RealtimeValue(const T& initial) : buffer_(initial) {}
+
+    void Store(const T& value) { buffer_.Write(value); }
+    const T& Load() const noexcept { return buffer_.Read(); }
+
+  private:
+    TripleBuffer<T> buffer_;
+  }; // RealtimeValue<T> (triple buffered)
+
+} // namespace Haze
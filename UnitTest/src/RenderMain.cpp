@@ -0,0 +1,207 @@
+
+/*
+  ==============================================================================
+
+    HazeRender: headless batch renderer
+
+    HazeRender --out=<folder> [options] <files and/or folders...>
+      --out=<folder>      where rendered files go (same name, .wav; name_ext.wav when inputs share a name)
+      --chain=<a,b,...>   processors in series (default: gainmix)
+      --preset=<file>     .hzpb preset applied to every processor in the chain
+      --bank=<file>       .hzpk bank, --preset then names a preset in it
+      --threads=<n>       files rendered in parallel (default: one per cpu)
+      --block=<n>         block size in samples (default: 512)
+      --bits=<n>          output bit depth (default: same as the input)
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "OfflineRenderer.h"
+#include "GainMixProcessor.h"
+#include "PresetBank.h"
+#include <iostream>
+#include <map>
+
+namespace
+{
+  // processors the chain can be built from; each gets the preset applied (if any) before it's prepared
+  using ProcessorFactory = std::function<std::unique_ptr<Haze::ProcessorInterface>(const Haze::BinaryPresetView*)>;
+
+  const std::map<juce::String, ProcessorFactory>& GetFactories()
+  {
+    static const std::map<juce::String, ProcessorFactory> factories {
+      { "gainmix", [](const Haze::BinaryPresetView* preset)
+        {
+          auto processor = std::make_unique<Haze::GainMixProcessor>();
+          if (preset != nullptr)
+          {
+            preset->ApplyTo(processor->GetParameterList());
+          }
+          return std::unique_ptr<Haze::ProcessorInterface>(std::move(processor));
+        } },
+    };
+
+    return factories;
+  }
+
+  int Fail(const juce::String& message)
+  {
+    std::cerr << "HazeRender: " << message << std::endl;
+    return 1;
+  }
+
+  juce::String Format(double value, int numDecimals, int width)
+  {
+    return juce::String(value, numDecimals).paddedLeft(' ', width);
+  }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  const juce::ArgumentList args(argc, argv);
+
+  // inputs: every non-option argument, folders expanded to the audio files directly inside them
+  juce::Array<juce::File> inputs;
+  for (const auto& arg : args.arguments)
+  {
+    if (arg.isOption())
+    {
+      continue;
+    }
+
+    const juce::File file = arg.resolveAsFile();
+    if (file.isDirectory())
+    {
+      for (const juce::File& child : file.findChildFiles(juce::File::findFiles, false, "*.wav;*.aif;*.aiff;*.flac"))
+      {
+        inputs.add(child);
+      }
+    }
+    else
+    {
+      inputs.add(file);
+    }
+  }
+
+  const juce::File outputFolder = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--out"));
+  if (!args.containsOption("--out") || inputs.isEmpty())
+  {
+    return Fail("usage: HazeRender --out=<folder> [--chain=gainmix,...] [--preset=<file>] [--bank=<file>] "
+                "[--threads=<n>] [--block=<n>] [--bits=<n>] <files and/or folders...>");
+  }
+
+  if (!outputFolder.createDirectory())
+  {
+    return Fail("can't create " + outputFolder.getFullPathName());
+  }
+
+  // chain
+  std::vector<ProcessorFactory> chain;
+  for (const juce::String& name : juce::StringArray::fromTokens(args.containsOption("--chain") ? args.getValueForOption("--chain") : "gainmix", ",", {}))
+  {
+    const auto factory = GetFactories().find(name.trim().toLowerCase());
+    if (factory == GetFactories().end())
+    {
+      return Fail("unknown processor '" + name + "'");
+    }
+    chain.push_back(factory->second);
+  }
+
+  // preset: a .hzpb file, or a name in a .hzpk bank (the bank/blob stays alive until all renders are done)
+  juce::MemoryBlock presetData;
+  std::unique_ptr<Haze::PresetBank> bank;
+  std::optional<Haze::BinaryPresetView> preset;
+
+  if (args.containsOption("--bank"))
+  {
+    bank = std::make_unique<Haze::PresetBank>(juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--bank")));
+    const int index = bank->IsValid() ? bank->IndexOf(args.getValueForOption("--preset")) : -1;
+    if (index < 0)
+    {
+      return Fail("no preset '" + args.getValueForOption("--preset") + "' in " + args.getValueForOption("--bank"));
+    }
+    preset = bank->GetPreset(index);
+  }
+  else if (args.containsOption("--preset"))
+  {
+    const juce::File presetFile = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--preset"));
+    if (!presetFile.loadFileAsData(presetData) || !(preset = Haze::BinaryPresetView(presetData))->IsValid())
+    {
+      return Fail("can't read preset " + presetFile.getFullPathName());
+    }
+  }
+
+  Haze::RenderSettings settings;
+  settings.blockSize = juce::jmax(1, args.containsOption("--block") ? args.getValueForOption("--block").getIntValue() : settings.blockSize);
+  settings.numThreads = args.getValueForOption("--threads").getIntValue();
+  settings.bitsPerSample = args.getValueForOption("--bits").getIntValue();
+
+  const Haze::OfflineRenderer renderer([&](Haze::ProcessorGraph& graph)
+  {
+    Haze::ProcessorGraph::NodeId previous = -1;
+    for (const ProcessorFactory& factory : chain)
+    {
+      const Haze::ProcessorGraph::NodeId node = graph.AddNode(factory(preset.has_value() ? &*preset : nullptr));
+      if (previous >= 0)
+      {
+        graph.Connect(previous, node);
+      }
+      previous = node;
+    }
+  }, settings);
+
+  // outputs are <name>.wav, or <name>_<ext>.wav when several inputs share a name (a.wav + a.flac)
+  std::map<juce::String, int> numInputsPerName;
+  for (const juce::File& input : inputs)
+  {
+    ++numInputsPerName[input.getFileNameWithoutExtension().toLowerCase()];
+  }
+
+  std::vector<Haze::OfflineRenderer::Job> jobs;
+  std::map<juce::File, juce::File> outputs;
+  for (const juce::File& input : inputs)
+  {
+    const juce::String name = input.getFileNameWithoutExtension();
+    const bool bIsShared = numInputsPerName[name.toLowerCase()] > 1;
+    const juce::File output = outputFolder.getChildFile(bIsShared ? name + "_" + input.getFileExtension().substring(1) + ".wav" : name + ".wav");
+
+    // (what's left: the same file twice, or same-named files in different folders)
+    if (const auto [existing, bIsNew] = outputs.emplace(output, input); !bIsNew)
+    {
+      return Fail(input.getFullPathName() + " and " + existing->second.getFullPathName() + " would both be rendered to " + output.getFullPathName());
+    }
+
+    jobs.push_back({ input, output });
+  }
+
+  const Haze::OfflineRenderer::Summary summary = renderer.Render(jobs);
+
+  // report
+  for (size_t i = 0; i < jobs.size(); ++i)
+  {
+    const Haze::OfflineRenderer::JobResult& result = summary.jobs[i];
+    if (result.WasSuccessful())
+    {
+      std::cout << jobs[i].input.getFileName() << ": " << Format(result.GetAudioSeconds(), 1, 8) << " s audio, "
+                << Format(result.GetRealtimeFactor(), 1, 8) << "x realtime ("
+                << Format(result.GetAudioSeconds() / juce::jmax(result.processSeconds, 1.0e-9), 1, 8) << "x processing only)" << std::endl;
+    }
+    else
+    {
+      std::cout << jobs[i].input.getFileName() << ": FAILED, " << result.error << std::endl;
+    }
+  }
+
+  std::cout << std::endl;
+  for (int worker = 0; worker < summary.numThreads; ++worker)
+  {
+    std::cout << "worker " << worker << ": " << Format(summary.GetRealtimeFactor(worker), 1, 8) << "x realtime" << std::endl;
+  }
+
+  std::cout << juce::String(static_cast<int>(jobs.size()) - summary.GetNumFailed()) << "/" << juce::String(static_cast<int>(jobs.size()))
+            << " files, " << Format(summary.GetAudioSeconds(), 1, 0) << " s audio in " << Format(summary.wallSeconds, 2, 0) << " s on "
+            << summary.numThreads << " thread(s): " << Format(summary.GetThroughput(), 1, 0) << "x realtime throughput" << std::endl;
+
+  return summary.GetNumFailed() == 0 ? 0 : 1;
+}
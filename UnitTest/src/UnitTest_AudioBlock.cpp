@@ -0,0 +1,108 @@
+
+#include "UnitTest_AudioBlock.h"
+#include "GainMixProcessor.h"
+
+namespace Haze
+{
+
+  void UnitTests::AudioBlockTest::runTest()
+  {
+    beginTest("Views and sub-blocks");
+    {
+      AlignedAudioBuffer<float> buffer(3, 100);
+      expectEquals(buffer.GetNumChannels(), 3);
+      expectEquals(buffer.GetNumSamples(), 100);
+
+      for (int ch = 0; ch < 3; ++ch)
+      {
+        expect(reinterpret_cast<std::uintptr_t>(buffer.GetChannel(ch)) % AlignedAudioBuffer<float>::Alignment == 0);
+        expectEquals(buffer.GetChannel(ch)[99], 0.f);
+      }
+
+      const AudioBlockView<float> view = buffer.GetView();
+      const AudioBlockView<float> sub = view.GetSubBlock(10, 20).GetChannelRange(1, 2);
+      expectEquals(sub.GetNumChannels(), 2);
+      expectEquals(sub.GetNumSamples(), 20);
+      expect(sub.GetChannel(0) == buffer.GetChannel(1) + 10);
+
+      juce::FloatVectorOperations::fill(buffer.GetChannel(1), 1.f, 100);
+      juce::FloatVectorOperations::fill(buffer.GetChannel(2), 1.f, 100);
+      sub.Multiply(4.f);
+      expectEquals(buffer.GetChannel(1)[9], 1.f);
+      expectEquals(buffer.GetChannel(1)[10], 4.f);
+      expectEquals(buffer.GetChannel(2)[29], 4.f);
+      expectEquals(buffer.GetChannel(2)[30], 1.f);
+      expectEquals(buffer.GetChannel(0)[15], 0.f);
+
+      AlignedAudioBuffer<double> other(2, 20);
+      const AudioBlockView<double> otherView = other.GetView();
+      juce::FloatVectorOperations::fill(other.GetChannel(0), 0.5, 20);
+      otherView.AddFrom(otherView);
+      expectEquals(other.GetChannel(0)[19], 1.0);
+      otherView.Clear();
+      expectEquals(other.GetChannel(0)[19], 0.0);
+
+      AlignedAudioBuffer<float> moved(std::move(buffer));
+      expectEquals(moved.GetChannel(1)[10], 4.f);
+      expectEquals(buffer.GetNumChannels(), 0);
+    }
+
+    beginTest("Gain/mix processor: settled, ramping, oversized blocks");
+    {
+      constexpr double SampleRate = 1000.0; // (20 sample ramps)
+
+      GainMixProcessor processor;
+      ParameterList& params = processor.GetParameterList();
+      processor.prepare({ SampleRate, 64, 2 });
+
+      AlignedAudioBuffer<float> buffer(2, 200);
+      const auto fillOnes = [&]
+      {
+        for (int ch = 0; ch < 2; ++ch)
+        {
+          juce::FloatVectorOperations::fill(buffer.GetChannel(ch), 1.f, 200);
+        }
+      };
+
+      // unity by default
+      fillOnes();
+      processor.processBlock(buffer.GetView(), {});
+      expectEquals(buffer.GetChannel(1)[199], 1.f);
+
+      // gain 1 -> 3, fully wet: 1 + 0.1 * (i + 1), then 3
+      *params[GainMixProcessor::Gain] = 3.f;
+      fillOnes();
+      processor.processBlock(buffer.GetView(), {}); // (200 samples, prepared for 64)
+      expectWithinAbsoluteError(buffer.GetChannel(0)[0], 1.1f, 1.0e-5f);
+      expectWithinAbsoluteError(buffer.GetChannel(1)[9], 2.f, 1.0e-5f);
+      expectEquals(buffer.GetChannel(0)[19], 3.f);
+      expectEquals(buffer.GetChannel(1)[199], 3.f);
+
+      // mix 1 -> 0.5 at gain 3: 1 + mix * 2, mix ramping down by 0.025 per sample
+      *params[GainMixProcessor::Mix] = 0.5f;
+      fillOnes();
+      processor.processBlock(buffer.GetView(), {});
+      expectWithinAbsoluteError(buffer.GetChannel(0)[9], 2.5f, 1.0e-5f);
+      expectWithinAbsoluteError(buffer.GetChannel(1)[19], 2.f, 1.0e-5f);
+      expectWithinAbsoluteError(buffer.GetChannel(1)[100], 2.f, 1.0e-5f);
+
+      // out of range values are clamped by the parameter
+      *params[GainMixProcessor::Gain] = 10.f;
+      *params[GainMixProcessor::Mix] = 1.f;
+      processor.exec(); // (advances the ramps w/o audio)
+      fillOnes();
+      processor.processBlock(buffer.GetView().GetSubBlock(0, 32), {});
+      expectEquals(buffer.GetChannel(0)[31], 4.f);
+      expectEquals(buffer.GetChannel(0)[32], 1.f);
+
+      // double path shares the float ramps
+      AlignedAudioBuffer<double> wide(1, 40);
+      juce::FloatVectorOperations::fill(wide.GetChannel(0), 0.5, 40);
+      *params[GainMixProcessor::Gain] = 2.f;
+      processor.processBlock(wide.GetView(), {});
+      expectWithinAbsoluteError(wide.GetChannel(0)[9], 0.5 * 3.0, 1.0e-5);
+      expectEquals(wide.GetChannel(0)[39], 1.0);
+    }
+  }
+
+} // namespace Haze
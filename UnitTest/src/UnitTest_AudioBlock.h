@@ -0,0 +1,23 @@
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace Haze
+{
+namespace UnitTests
+{
+
+  class AudioBlockTest : public juce::UnitTest
+  {
+  public:
+    // ctor
+    AudioBlockTest() : UnitTest("Audio blocks + gain/mix processor") {}
+
+    virtual void runTest() override final;
+
+  }; // AudioBlockTest
+
+  static AudioBlockTest BlockTest; // static addition to the test array
+
+} // UnitTests
+} // Haze
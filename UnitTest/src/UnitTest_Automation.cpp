@@ -0,0 +1,132 @@
+
+#include "UnitTest_Automation.h"
+#include "Automation.h"
+#include <cmath>
+
+namespace Haze
+{
+
+  void UnitTests::AutomationTest::runTest()
+  {
+    static const juce::Identifier Cutoff("cutoff");
+    static const juce::Identifier Mode("mode");
+    static const juce::Identifier Level("level");
+
+    beginTest("Compressor: lines collapse, every point stays within tolerance");
+    {
+      AutomationCompressor line;
+      for (int i = 0; i <= 1000; ++i)
+      {
+        line.Add(i * 10, 0.5f * static_cast<float>(i));
+      }
+      expectEquals(line.TakeLane().GetNumBreakpoints(), 2);
+
+      constexpr float Tolerance = 0.01f;
+      AutomationCompressor sine(Tolerance);
+      std::vector<float> points;
+      for (int i = 0; i < 10000; ++i)
+      {
+        points.push_back(std::sin(static_cast<float>(i) * 0.001f));
+        sine.Add(i, points.back());
+      }
+
+      const AutomationLane lane = sine.TakeLane();
+      float worstError = 0.f;
+      for (int i = 0; i < 10000; ++i)
+      {
+        worstError = juce::jmax(worstError, std::abs(lane.Evaluate(i) - points[static_cast<size_t>(i)]));
+      }
+      expect(worstError <= Tolerance * 1.001f, "error " + juce::String(worstError));
+      expect(lane.GetNumBreakpoints() < 100, juce::String(lane.GetNumBreakpoints()) + " breakpoints");
+    }
+
+    beginTest("Lane: held outside its breakpoints, blocks match Evaluate()");
+    {
+      AutomationLane lane;
+      lane.Add(100, 1.f);
+      lane.Add(200, 2.f);
+      lane.Add(201, -1.f);
+      lane.Add(400, 0.f);
+
+      expectEquals(lane.Evaluate(0), 1.f);
+      expectEquals(lane.Evaluate(150), 1.5f);
+      expectEquals(lane.Evaluate(201), -1.f);
+      expectEquals(lane.Evaluate(1000), 0.f);
+
+      // odd block size, so blocks straddle every breakpoint; then a jump backwards (stale hint)
+      std::vector<float> block(37);
+      int hint = -1;
+      float worstError = 0.f;
+      for (const juce::int64 start : { 0, 37, 74, 111, 148, 185, 222, 259, 296, 333, 370, 407, 160 })
+      {
+        lane.RenderBlock(start, block.data(), 37, hint);
+        for (int i = 0; i < 37; ++i)
+        {
+          worstError = juce::jmax(worstError, std::abs(block[static_cast<size_t>(i)] - lane.Evaluate(start + i)));
+        }
+      }
+      expect(worstError < 1.0e-5f, "error " + juce::String(worstError));
+    }
+
+    beginTest("Recorder: held values cost nothing, only float parameters get lanes");
+    {
+      ParameterList param_list;
+      param_list
+        .add(Cutoff, 100.f, ParamRange<float>(20.f, 20000.f))
+        .add(Mode, 0)
+        .add(Level, 0.f)
+      ;
+
+      ParamHandle<float> cutoff = param_list.GetHandle<float>(Cutoff);
+      ParamHandle<float> level = param_list.GetHandle<float>(Level);
+
+      AutomationRecorder recorder(param_list);
+      expectEquals(recorder.GetNumLanes(), 2);
+
+      // cutoff: held, then a step at 6400; level: a linear fade, one capture per 64 sample block
+      for (int block = 0; block < 200; ++block)
+      {
+        cutoff.Set(block < 100 ? 100.f : 5000.f);
+        level.Set(static_cast<float>(block) / 200.f);
+        recorder.Capture(block * 64);
+      }
+      recorder.Record(2, 200 * 64, 0.25f);
+
+      expectEquals(recorder.GetNumChanges(), static_cast<juce::int64>(2 + 200 + 1));
+
+      const AutomationRecording recording = recorder.Finish();
+      expectEquals(recording.parameterIndices[0], 0);
+      expectEquals(recording.parameterIndices[1], 2);
+
+      const AutomationLane& cutoffLane = recording.lanes[0];
+      expectEquals(cutoffLane.GetNumBreakpoints(), 3);
+      expectEquals(cutoffLane.Evaluate(99 * 64), 100.f);
+      expectEquals(cutoffLane.Evaluate(100 * 64), 5000.f);
+
+      const AutomationLane& levelLane = recording.lanes[1];
+      expect(levelLane.GetNumBreakpoints() <= 3);
+      expectWithinAbsoluteError(levelLane.Evaluate(50 * 64 + 32), 50.5f / 200.f, 1.0e-3f);
+      expectWithinAbsoluteError(levelLane.Evaluate(200 * 64), 0.25f, 1.0e-6f);
+      expect(recording.GetCompressionRatio() > 30.0);
+
+      // playback writes each block's first value back into the list
+      cutoff.Set(1.f);
+      AutomationPlayer player(recording, param_list);
+      player.Prepare(64);
+
+      player.RenderBlock(50 * 64, 64);
+      expectEquals(cutoff.Get(), 100.f);
+      expectWithinAbsoluteError(level.Get(), 0.25f, 1.0e-3f);
+      expectWithinAbsoluteError(player.GetLaneValues(1)[63], (50.f + 63.f / 64.f) / 200.f, 1.0e-3f);
+
+      // (captured once per block, so a step ramps over the block it happened in)
+      player.RenderBlock(99 * 64, 64);
+      expectEquals(player.GetLaneValues(0)[0], 100.f);
+      expect(player.GetLaneValues(0)[32] > 100.f && player.GetLaneValues(0)[32] < 5000.f);
+
+      player.RenderBlock(100 * 64, 64);
+      expectEquals(cutoff.Get(), 5000.f);
+    }
+  }
+
+} // namespace Haze
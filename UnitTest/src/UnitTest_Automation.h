@@ -0,0 +1,23 @@
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace Haze
+{
+namespace UnitTests
+{
+
+  class AutomationTest : public juce::UnitTest
+  {
+  public:
+    // ctor
+    AutomationTest() : UnitTest("Automation recording/playback") {}
+
+    virtual void runTest() override final;
+
+  }; // AutomationTest
+
+  static AutomationTest AutomationLaneTest; // static addition to the test array
+
+} // UnitTests
+} // Haze
@@ -0,0 +1,153 @@
+
+#include "UnitTest_BinaryPreset.h"
+#include "BinaryPreset.h"
+
+namespace Haze
+{
+
+  void UnitTests::BinaryPresetTest::runTest()
+  {
+    const juce::Identifier Freq("freq");
+    const juce::Identifier NumTaps("NumTaps");
+    const juce::Identifier Enabled("Enabled");
+    const juce::Identifier Label("Label");
+    const juce::Identifier Position("Position");
+    const juce::Identifier Gain("Gain");
+
+    const auto makeList = [&]()
+    {
+      auto list = std::make_unique<ParameterList>();
+      list->add(Freq, 500.f)
+           .add(NumTaps, 4)
+           .add(Enabled, true)
+           .add(Label, juce::String("init"))
+           .add(Position, juce::int64 { 0 })
+           .add(Gain, 1.0)
+      ;
+      return list;
+    };
+
+    beginTest("Round trip");
+    {
+      auto source = makeList();
+      *(*source)[Freq] = 1234.5f;
+      *(*source)[NumTaps] = -7;
+      *(*source)[Enabled] = false;
+      *(*source)[Label] = juce::String(juce::CharPointer_UTF8("caf\xc3\xa9"));
+      *(*source)[Position] = juce::int64 { 1 } << 40;
+      *(*source)[Gain] = 0.125;
+
+      juce::MemoryBlock block;
+      BinaryPreset::Encode(*source, block);
+
+      const BinaryPresetView view(block);
+      expect(view.IsValid());
+      expect(view.GetNumEntries() == 6);
+      expect(view.GetName(0) == Freq);
+      expect(view.GetType(0) == BinaryPreset::TypeTag::Float32);
+      expect(view.GetType(3) == BinaryPreset::TypeTag::String);
+
+      auto dest = makeList();
+      expect(view.ApplyTo(*dest) == 6);
+      expect((*dest)[Freq]->IsEqualTo(1234.5f));
+      expect((*dest)[NumTaps]->IsEqualTo(-7));
+      expect((*dest)[Enabled]->IsEqualTo(false));
+      expect((*dest)[Label]->IsEqualTo(juce::String(juce::CharPointer_UTF8("caf\xc3\xa9"))));
+      expect((*dest)[Position]->IsEqualTo(juce::int64 { 1 } << 40));
+      expect((*dest)[Gain]->IsEqualTo(0.125));
+    }
+
+    beginTest("Entries are matched by name when layouts differ");
+    {
+      auto source = makeList();
+      *(*source)[Gain] = 2.0;
+
+      juce::MemoryBlock block;
+      BinaryPreset::Encode(*source, block);
+
+      ParameterList dest;
+      dest
+        .add(Gain, 0.0)
+        .add(juce::Identifier("NotInPreset"), 3)
+      ;
+      expect(BinaryPresetView(block).ApplyTo(dest) == 1);
+      expect(dest[Gain]->IsEqualTo(2.0));
+    }
+
+    // random lists survive a round trip, and random damage never gets past validation unnoticed
+    beginTest("Fuzz");
+    {
+      juce::Random rng = getRandom();
+      int numRoundTrips = 0;
+      int numCorruptAccepted = 0;
+
+      for (int iteration = 0; iteration < 200; ++iteration)
+      {
+        ParameterList source;
+        const int numParams = rng.nextInt(40);
+        for (int i = 0; i < numParams; ++i)
+        {
+          const juce::Identifier name("fuzz_" + juce::String(i));
+          switch (rng.nextInt(6))
+          {
+            case 0: source.add(name, rng.nextBool()); break;
+            case 1: source.add(name, rng.nextInt()); break;
+            case 2: source.add(name, rng.nextInt64()); break;
+            case 3: source.add(name, rng.nextFloat() * 1.0e6f - 5.0e5f); break;
+            case 4: source.add(name, rng.nextDouble()); break;
+            default: source.add(name, juce::String::repeatedString("x", rng.nextInt(20))); break;
+          }
+        }
+
+        juce::MemoryBlock block;
+        BinaryPreset::Encode(source, block);
+
+        // round trip into a list w/ the same layout (shuffled values)
+        ParameterSnapshot expected;
+        source.CaptureSnapshot(expected);
+        const BinaryPresetView view(block);
+        bool bRoundTripped = view.IsValid() && view.GetNumEntries() == numParams;
+        for (int i = 0; bRoundTripped && i < numParams; ++i)
+        {
+          bRoundTripped = view.GetName(i) == source.GetName(i) && view.GetValue(i) == expected.values[static_cast<size_t>(i)];
+        }
+        numRoundTrips += bRoundTripped ? 1 : 0;
+
+        // damage: truncate, or flip a few bytes. either validation fails, or every accessor stays in bounds
+        juce::MemoryBlock damaged(block);
+        if (rng.nextBool() && damaged.getSize() > 0)
+        {
+          damaged.setSize(static_cast<size_t>(rng.nextInt(static_cast<int>(damaged.getSize()))));
+        }
+        else
+        {
+          for (int flips = 0; flips < 4 && damaged.getSize() > 0; ++flips)
+          {
+            damaged[static_cast<size_t>(rng.nextInt(static_cast<int>(damaged.getSize())))] = static_cast<char>(rng.nextInt(256));
+          }
+        }
+
+        const BinaryPresetView damagedView(damaged);
+        if (damagedView.IsValid())
+        {
+          for (int i = 0; i < damagedView.GetNumEntries(); ++i)
+          {
+            juce::ignoreUnused(damagedView.GetValue(i));
+          }
+          numCorruptAccepted += 1;
+        }
+      }
+
+      expect(numRoundTrips == 200);
+      logMessage("  damaged blobs that still validated (structurally sound, values changed): " + juce::String(numCorruptAccepted) + "/200");
+    }
+
+    beginTest("Rejects foreign data");
+    {
+      const char garbage[] = "<Parameter_List freq=\"500.0\"/>";
+      expect(!BinaryPresetView(garbage, sizeof(garbage)).IsValid());
+      expect(!BinaryPresetView(nullptr, 0).IsValid());
+    }
+  }
+
+} // Haze
@@ -0,0 +1,23 @@
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace Haze
+{
+namespace UnitTests
+{
+
+  class BinaryPresetTest : public juce::UnitTest
+  {
+  public:
+    // ctor
+    BinaryPresetTest() : UnitTest("Binary preset format") {}
+
+    virtual void runTest() override final;
+
+  }; // BinaryPresetTest
+
+  static BinaryPresetTest PresetTest; // static addition to the test array
+
+} // UnitTests
+} // Haze
@@ -0,0 +1,90 @@
+
+#include "UnitTest_ModulationMatrix.h"
+#include "ModulationMatrix.h"
+
+namespace Haze
+{
+
+  void UnitTests::ModulationMatrixTest::runTest()
+  {
+    static const juce::Identifier Cutoff("cutoff");
+    static const juce::Identifier Pan("pan");
+    static const juce::Identifier Detune("detune");
+
+    ParameterList param_list;
+    param_list
+      .add(Cutoff, 1000.f, ParamRange<float>(0.f, 2000.f))
+      .add(Pan, 0.f, ParamRange<float>(-1.f, 1.f))
+      .add(Detune, 0.f)
+    ;
+
+    constexpr int BlockSize = 16;
+    constexpr int NumSources = 2;
+
+    ModulationMatrix matrix(param_list, NumSources);
+    const int cutoff = matrix.AddTarget(Cutoff);
+    const int pan = matrix.AddTarget(Pan);
+    const int detune = matrix.AddTarget(Detune);
+    matrix.Prepare(BlockSize);
+
+    // source 0: ramp -1..1, source 1: constant 1
+    for (int i = 0; i < BlockSize; ++i)
+    {
+      matrix.GetSourceBuffer(0)[i] = -1.f + 2.f * static_cast<float>(i) / (BlockSize - 1);
+      matrix.GetSourceBuffer(1)[i] = 1.f;
+    }
+
+    beginTest("Unrouted targets hold their base value");
+    {
+      matrix.RenderBlock(BlockSize);
+      for (int i = 0; i < BlockSize; ++i)
+      {
+        expectEquals(matrix.GetTargetValues(cutoff)[i], 1000.f);
+        expectEquals(matrix.GetTargetValues(pan)[i], 0.f);
+      }
+    }
+
+    beginTest("Routes add depth * range * source, clamped into the range");
+    {
+      matrix.SetDepth(0, cutoff, 0.25f); // +-500
+      matrix.SetDepth(1, cutoff, 0.1f);  // +200
+      matrix.SetDepth(0, pan, 1.f);      // +-2, clamped to +-1
+      matrix.SetDepth(1, detune, -3.f);  // unranged: -3 per unit
+      expectEquals(matrix.GetNumRoutes(), 4);
+
+      matrix.RenderBlock(BlockSize);
+      for (int i = 0; i < BlockSize; ++i)
+      {
+        const float lfo = matrix.GetSourceBuffer(0)[i];
+        expectWithinAbsoluteError(matrix.GetTargetValues(cutoff)[i], 1000.f + 500.f * lfo + 200.f, 1.0e-3f);
+        expectWithinAbsoluteError(matrix.GetTargetValues(pan)[i], juce::jlimit(-1.f, 1.f, 2.f * lfo), 1.0e-6f);
+        expectEquals(matrix.GetTargetValues(detune)[i], -3.f);
+      }
+
+      // the ParameterList keeps its base values
+      expectEquals(param_list[Cutoff]->Get<float>(), 1000.f);
+      expectEquals(param_list[Pan]->Get<float>(), 0.f);
+      expectEquals(param_list[Detune]->Get<float>(), 0.f);
+    }
+
+    beginTest("Base value changes and route edits apply to the next block");
+    {
+      param_list[Cutoff]->SetAsVar(1500.f);
+      matrix.SetDepth(0, cutoff, 0.f); // (removes the route)
+      matrix.SetDepth(1, cutoff, 0.5f);
+      expectEquals(matrix.GetNumRoutes(), 3);
+      expectEquals(matrix.GetDepth(1, cutoff), 0.5f);
+      expectEquals(matrix.GetDepth(0, cutoff), 0.f);
+
+      matrix.RenderBlock(BlockSize);
+      expectEquals(matrix.GetTargetValues(cutoff)[0], 2000.f); // 1500 + 1000, clamped
+      expectEquals(matrix.GetTargetValues(detune)[BlockSize - 1], -3.f);
+
+      matrix.SetDepth(1, detune, 0.f);
+      matrix.SetDepth(1, cutoff, 0.f);
+      matrix.SetDepth(0, pan, 0.f);
+      expectEquals(matrix.GetNumRoutes(), 0);
+    }
+  }
+
+} // namespace Haze
@@ -0,0 +1,23 @@
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace Haze
+{
+namespace UnitTests
+{
+
+  class ModulationMatrixTest : public juce::UnitTest
+  {
+  public:
+    // ctor
+    ModulationMatrixTest() : UnitTest("Modulation matrix") {}
+
+    virtual void runTest() override final;
+
+  }; // ModulationMatrixTest
+
+  static ModulationMatrixTest ModMatrixTest; // static addition to the test array
+
+} // UnitTests
+} // Haze
@@ -0,0 +1,126 @@
+
+#include "UnitTest_OfflineRenderer.h"
+#include "OfflineRenderer.h"
+#include "GainMixProcessor.h"
+
+namespace Haze
+{
+  namespace
+  {
+    // numChannels x numSamples of (channel + 1) * 0.1
+    void WriteTestFile(const juce::File& file, int numChannels, int numSamples)
+    {
+      file.deleteFile();
+      juce::WavAudioFormat wav;
+      std::unique_ptr<juce::FileOutputStream> stream(file.createOutputStream());
+      std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(stream.get(), 48000.0, static_cast<unsigned int>(numChannels), 32, {}, 0));
+      jassert(writer != nullptr);
+      stream.release();
+
+      juce::AudioBuffer<float> buffer(numChannels, numSamples);
+      for (int ch = 0; ch < numChannels; ++ch)
+      {
+        juce::FloatVectorOperations::fill(buffer.getWritePointer(ch), static_cast<float>(ch + 1) * 0.1f, numSamples);
+      }
+      writer->writeFromAudioSampleBuffer(buffer, 0, numSamples);
+    }
+  } // namespace
+
+  void UnitTests::OfflineRendererTest::runTest()
+  {
+    // two gain/mix stages at 0.5 each
+    const auto builder = [](ProcessorGraph& graph)
+    {
+      ProcessorGraph::NodeId previous = -1;
+      for (int stage = 0; stage < 2; ++stage)
+      {
+        auto processor = std::make_unique<GainMixProcessor>();
+        *processor->GetParameterList()[GainMixProcessor::Gain] = 0.5f;
+
+        const ProcessorGraph::NodeId node = graph.AddNode(std::move(processor));
+        if (previous >= 0)
+        {
+          graph.Connect(previous, node);
+        }
+        previous = node;
+      }
+    };
+
+    RenderSettings settings;
+    settings.blockSize = 256;
+    settings.numThreads = 3;
+    settings.bitsPerSample = 32;
+    const OfflineRenderer renderer(builder, settings);
+
+    beginTest("Renders every file through its own graph, in parallel");
+    {
+      constexpr int NumFiles = 5;
+      std::vector<std::unique_ptr<juce::TemporaryFile>> files;
+      std::vector<OfflineRenderer::Job> jobs;
+
+      for (int i = 0; i < NumFiles; ++i)
+      {
+        const juce::File input = files.emplace_back(std::make_unique<juce::TemporaryFile>(".wav"))->getFile();
+        const juce::File output = files.emplace_back(std::make_unique<juce::TemporaryFile>(".wav"))->getFile();
+        WriteTestFile(input, 1 + i % 2, 1000 + i * 300); // (not a multiple of the block size)
+        jobs.push_back({ input, output });
+      }
+      const juce::File unused = files.emplace_back(std::make_unique<juce::TemporaryFile>(".wav"))->getFile();
+      jobs.push_back({ juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("haze_render_missing.wav"), unused });
+
+      const OfflineRenderer::Summary summary = renderer.Render(jobs);
+      expectEquals(summary.numThreads, 3);
+      expectEquals(summary.GetNumFailed(), 1);
+      expect(!summary.jobs.back().WasSuccessful());
+      expect(summary.GetThroughput() > 0.0);
+
+      juce::AudioFormatManager formats;
+      formats.registerBasicFormats();
+      for (int i = 0; i < NumFiles; ++i)
+      {
+        const OfflineRenderer::JobResult& result = summary.jobs[static_cast<size_t>(i)];
+        expect(result.WasSuccessful(), result.error);
+        expectEquals(result.numSamples, static_cast<juce::int64>(1000 + i * 300));
+        expect(juce::isPositiveAndBelow(result.worker, 3));
+        expect(summary.GetRealtimeFactor(result.worker) > 0.0);
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(jobs[static_cast<size_t>(i)].output));
+        expect(reader != nullptr);
+        if (reader != nullptr)
+        {
+          expectEquals(static_cast<int>(reader->numChannels), 1 + i % 2);
+          expectEquals(reader->lengthInSamples, result.numSamples);
+
+          juce::AudioBuffer<float> rendered(static_cast<int>(reader->numChannels), static_cast<int>(reader->lengthInSamples));
+          reader->read(&rendered, 0, rendered.getNumSamples(), 0, true, true);
+          for (int ch = 0; ch < rendered.getNumChannels(); ++ch)
+          {
+            expectWithinAbsoluteError(rendered.getReadPointer(ch)[0], static_cast<float>(ch + 1) * 0.025f, 1.0e-6f);
+            expectWithinAbsoluteError(rendered.getReadPointer(ch)[rendered.getNumSamples() - 1], static_cast<float>(ch + 1) * 0.025f, 1.0e-6f);
+          }
+        }
+      }
+    }
+
+    beginTest("Jobs sharing an output: only the first one renders");
+    {
+      juce::TemporaryFile first(".wav");
+      juce::TemporaryFile second(".wav");
+      juce::TemporaryFile output(".wav");
+      WriteTestFile(first.getFile(), 1, 1000);
+      WriteTestFile(second.getFile(), 2, 500);
+
+      const OfflineRenderer::Summary summary = renderer.Render({ { first.getFile(), output.getFile() }, { second.getFile(), output.getFile() } });
+      expectEquals(summary.GetNumFailed(), 1);
+      expect(summary.jobs[0].WasSuccessful(), summary.jobs[0].error);
+      expect(!summary.jobs[1].WasSuccessful());
+      expectEquals(summary.jobs[1].worker, -1); // (never ran)
+
+      juce::AudioFormatManager formats;
+      formats.registerBasicFormats();
+      std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(output.getFile()));
+      expect(reader != nullptr && reader->numChannels == 1 && reader->lengthInSamples == 1000);
+    }
+  }
+
+} // namespace Haze
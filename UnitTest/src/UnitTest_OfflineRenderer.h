@@ -0,0 +1,23 @@
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace Haze
+{
+namespace UnitTests
+{
+
+  class OfflineRendererTest : public juce::UnitTest
+  {
+  public:
+    // ctor
+    OfflineRendererTest() : UnitTest("Offline renderer") {}
+
+    virtual void runTest() override final;
+
+  }; // OfflineRendererTest
+
+  static OfflineRendererTest RenderTest; // static addition to the test array
+
+} // UnitTests
+} // Haze
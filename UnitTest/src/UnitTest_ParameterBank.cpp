@@ -0,0 +1,69 @@
+
+#include "UnitTest_ParameterBank.h"
+#include "ParameterBank.h"
+
+namespace Haze
+{
+
+  void UnitTests::ParameterBankTest::runTest()
+  {
+    const juce::Identifier Freq("freq");
+    const juce::Identifier Q("q");
+    const juce::Identifier NumTaps("NumTaps");
+    const juce::Identifier Enabled("Enabled");
+
+    beginTest("Values of one type are contiguous and aligned");
+    ParameterBank bank;
+    bank
+      .add(Freq, 500.f, {"Freq.", "filter cutoff freq.", "hz", false, true })
+      .add(NumTaps, 4)
+      .add(Q, 0.7f)
+      .add(Enabled, true)
+    ;
+
+    expect(bank.GetColumn<float>().size() == 2);
+    expect(bank.GetColumn<int>().size() == 1);
+    expect(bank.GetColumn<bool>().size() == 1);
+    expect(bank.GetColumn<float>()[0] == 500.f && bank.GetColumn<float>()[1] == 0.7f);
+    expect(reinterpret_cast<std::uintptr_t>(bank.GetColumn<float>().data()) % AlignedColumn<float>::Alignment == 0);
+    expect(bank.GetMetadata(bank.IndexOf(Freq)).bIsLogarithmic_);
+
+    beginTest("Typed access");
+    bank.Get<float>(Q) = 2.f;
+    bank.Get<int>(NumTaps) = 10;
+    expect(bank.GetColumn<float>()[1] == 2.f);
+    expect(bank.GetAsVar(bank.IndexOf(NumTaps)) == juce::var(10));
+
+    beginTest("Mirror a ParameterList");
+    ParameterList param_list;
+    param_list
+      .add(Freq, 500.f)
+      .add(NumTaps, 4)
+      .add(juce::Identifier("Label"), juce::String("skipped"))
+      .add(Enabled, true)
+    ;
+
+    ParameterBank mirror = ParameterBank::FromList(param_list);
+    expect(mirror.GetNumParameters() == 3);
+
+    *param_list[Freq] = 15.f;
+    mirror.CaptureFrom(param_list);
+    expect(mirror.Get<float>(Freq) == 15.f);
+
+    mirror.Get<bool>(Enabled) = false;
+    mirror.ApplyTo(param_list);
+    expect(param_list[Enabled]->IsEqualTo(false));
+
+    beginTest("juce::ValueTree sync");
+    juce::ValueTree bankTree = bank.GetStateAsTree();
+    bank.SyncToTree(bankTree);
+    bankTree.setProperty(Freq, 1234.0, nullptr);
+    expect(bank.Get<float>(Freq) == 1234.f);
+
+    // a property the bank doesn't know is ignored
+    bankTree.setProperty("unknown", 1.0, nullptr);
+    expect(bank.Get<float>(Freq) == 1234.f);
+    bank.DesyncFromTree(bankTree);
+  }
+
+} // Haze
@@ -0,0 +1,23 @@
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace Haze
+{
+namespace UnitTests
+{
+
+  class ParameterBankTest : public juce::UnitTest
+  {
+  public:
+    // ctor
+    ParameterBankTest() : UnitTest("Parameter bank (SoA storage)") {}
+
+    virtual void runTest() override final;
+
+  }; // ParameterBankTest
+
+  static ParameterBankTest BankTest; // static addition to the test array
+
+} // UnitTests
+} // Haze
@@ -0,0 +1,152 @@
+
+#include "UnitTest_ParameterControls.h"
+#include "ParameterControls.h"
+#include <cmath>
+
+namespace Haze
+{
+
+  void UnitTests::ParameterControlsTest::runTest()
+  {
+    static const juce::Identifier Bypass("bypass");
+    static const juce::Identifier Mix("mix");
+    static const juce::Identifier Freq("freq");
+    static const juce::Identifier Voices("voices");
+    static const juce::Identifier Label("label");
+    static const juce::Identifier Drive("drive");
+
+    ParameterList param_list;
+    param_list
+      .add(Bypass, false)
+      .add(Mix, 0.5f, ParamRange<float>(0.f, 1.f), {"Mix", "dry/wet", "", /*bPreferSliderOverKnob*/true})
+      .add(Freq, 1000.f, ParamRange<float>(20.f, 20000.f), {"Freq", "cutoff", "Hz", false, /*bIsLogarithmic*/true})
+      .add(Voices, 8)
+      .add(Label, juce::String("lead"))
+      .add(Drive, 2.f, ParamRange<float>(0.f, 10.f), {"Drive"})
+    ;
+
+    beginTest("Control kinds follow type, range and metadata");
+    {
+      expect(param_list.GetControlKind(0) == ControlKind::Toggle);
+      expect(param_list.GetControlKind(1) == ControlKind::Slider);
+      expect(param_list.GetControlKind(2) == ControlKind::Knob);
+      expect(param_list.GetControlKind(3) == ControlKind::NumberBox);
+      expect(param_list.GetControlKind(4) == ControlKind::Text);
+    }
+
+    beginTest("Generated controls show and edit their parameter");
+    {
+      auto freq = param_list.CreateComponent(2);
+      auto& knob = dynamic_cast<juce::Slider&>(freq->GetEditor());
+      expect(knob.getSliderStyle() == juce::Slider::RotaryHorizontalVerticalDrag);
+      expectEquals(knob.getValue(), 1000.0);
+      expectWithinAbsoluteError(knob.valueToProportionOfLength(std::sqrt(20.0 * 20000.0)), 0.5, 1.0e-6); // (log: centred geometrically)
+
+      knob.setValue(50000.0, juce::sendNotificationSync);
+      expectEquals(param_list[Freq]->Get<float>(), 20000.f);
+
+      auto bypass = param_list.CreateComponent(0);
+      auto& toggle = dynamic_cast<juce::ToggleButton&>(bypass->GetEditor());
+      toggle.setToggleState(true, juce::sendNotificationSync);
+      expect(param_list[Bypass]->Get<bool>());
+
+      auto mix = param_list.CreateComponent(1);
+      expect(dynamic_cast<juce::Slider&>(mix->GetEditor()).getSliderStyle() == juce::Slider::LinearHorizontal);
+
+      // re-bound to another entry of the same kind: new range, new value
+      freq->Bind(param_list, 5);
+      expectEquals(knob.getMaximum(), 10.0);
+      expectEquals(knob.getValue(), 2.0);
+    }
+
+    beginTest("ParameterChangeSet coalesces marks until they're taken");
+    {
+      ParameterChangeSet changes(130);
+      expect(changes.IsEmpty());
+
+      for (int i = 0; i < 10; ++i)
+      {
+        changes.Mark(64);
+      }
+      changes.Mark(129);
+      changes.Mark(0);
+
+      std::vector<int> taken;
+      expectEquals(changes.TakeChanges([&](int index) { taken.push_back(index); }), 3);
+      expect(taken == std::vector<int> { 0, 64, 129 });
+      expect(changes.IsEmpty());
+
+      changes.MarkAll();
+      expectEquals(changes.TakeChanges([](int) {}), 130);
+    }
+
+    beginTest("ParameterListView repaints a changed control once per frame");
+    {
+      constexpr int RowHeight = 30;
+      ParameterListView view(param_list, RowHeight);
+      view.setSize(400, param_list.GetNumParameters() * RowHeight);
+      expectEquals(view.FlushChanges(), 0);
+
+      // automation: 100 writes between two frames
+      const ParamHandle<float> mix = param_list.GetHandle<float>(Mix);
+      for (int i = 1; i <= 100; ++i)
+      {
+        mix.Set(static_cast<float>(i) / 200.f);
+        view.MarkChanged(1);
+      }
+
+      expectEquals(view.FlushChanges(), 1);
+      auto* mixControl = dynamic_cast<ParameterControl*>(view.GetListBox().getComponentForRowNumber(1));
+      expect(mixControl != nullptr);
+      expectEquals(dynamic_cast<juce::Slider&>(mixControl->GetEditor()).getValue(), 0.5);
+      expectEquals(view.FlushChanges(), 0);
+
+      // marked, but the control already shows the value: nothing repaints
+      view.MarkChanged(1);
+      expectEquals(view.FlushChanges(), 0);
+
+      // tree writes (i.e. from a ParameterFeedback) mark their entries too
+      juce::ValueTree tree = param_list.GetStateAsTree();
+      param_list.SyncToTree(tree);
+      view.WatchTree(tree);
+
+      tree.setProperty(Mix, 0.25f, nullptr);
+      tree.setProperty(Freq, 440.f, nullptr);
+      tree.setProperty(Freq, 500.f, nullptr);
+      expectEquals(view.FlushChanges(), 2);
+      expectEquals(view.FlushChanges(), 0);
+
+      param_list.DesyncFromTree(tree);
+    }
+
+    beginTest("ParameterListView only builds the rows on screen");
+    {
+      ParameterList large_list;
+      for (int i = 0; i < 2000; ++i)
+      {
+        large_list.add(juce::Identifier("param_" + juce::String(i)), static_cast<float>(i) / 2000.f, ParamRange<float>(0.f, 1.f));
+      }
+
+      constexpr int RowHeight = 30;
+      ParameterListView view(large_list, RowHeight);
+      view.setSize(400, 10 * RowHeight);
+
+      const int numVisible = view.GetNumLiveControls();
+      expect(numVisible >= 10 && numVisible <= 16, juce::String(numVisible) + " live controls"); // (+ a few spare rows)
+
+      // scrolling recycles the controls that went off screen
+      for (int row = 0; row < 2000; row += 7)
+      {
+        view.GetListBox().scrollToEnsureRowIsOnscreen(row);
+      }
+      view.GetListBox().scrollToEnsureRowIsOnscreen(1999);
+      expect(view.GetNumLiveControls() <= numVisible);
+      expect(view.GetNumControlsCreated() <= 2 * numVisible, juce::String(view.GetNumControlsCreated()) + " controls built");
+
+      auto* last = dynamic_cast<ParameterControl*>(view.GetListBox().getComponentForRowNumber(1999));
+      expect(last != nullptr && last->GetParameterIndex() == 1999);
+      expectEquals(dynamic_cast<juce::Slider&>(last->GetEditor()).getValue(), static_cast<double>(1999.f / 2000.f));
+    }
+  }
+
+} // namespace Haze
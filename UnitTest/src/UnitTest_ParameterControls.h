@@ -0,0 +1,23 @@
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace Haze
+{
+namespace UnitTests
+{
+
+  class ParameterControlsTest : public juce::UnitTest
+  {
+  public:
+    // ctor
+    ParameterControlsTest() : UnitTest("Generated parameter controls") {}
+
+    virtual void runTest() override final;
+
+  }; // ParameterControlsTest
+
+  static ParameterControlsTest ControlsTest; // static addition to the test array
+
+} // UnitTests
+} // Haze
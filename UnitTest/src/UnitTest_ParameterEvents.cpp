@@ -0,0 +1,117 @@
+
+#include "UnitTest_ParameterEvents.h"
+#include "ParameterEvents.h"
+#include "GainMixProcessor.h"
+
+namespace Haze
+{
+
+  void UnitTests::ParameterEventsTest::runTest()
+  {
+    beginTest("Queue: sorted, stable, bounded");
+    {
+      ParameterEventQueue queue(4);
+      expect(queue.Add(10, 0, 1.f));
+      expect(queue.Add(5, 1, 2.f));
+      expect(queue.Add(10, 2, 3.f)); // (after the first one at 10)
+      expect(queue.Add(0, 3, 4.f));
+      expect(!queue.Add(1, 4, 5.f));
+      expectEquals(queue.GetNumEvents(), 4);
+
+      juce::String order;
+      for (const ParameterEvent& event : queue)
+      {
+        order << event.parameterIndex;
+      }
+      expectEquals(order, juce::String("3102"));
+    }
+
+    beginTest("Dispatch splits at event offsets, later events carry over");
+    {
+      ParameterEventQueue queue;
+      queue.Add(0, 0, 1.f);
+      queue.Add(40, 1, 2.f);
+      queue.Add(40, 2, 3.f);
+      queue.Add(100, 3, 4.f);
+      queue.Add(130, 4, 5.f);
+
+      juce::String log;
+      const auto apply = [&log](const ParameterEvent& event) { log << "e" << event.parameterIndex << " "; };
+      const auto process = [&log](int start, int numSamples) { log << start << "+" << numSamples << " "; };
+
+      queue.Dispatch(100, apply, process);
+      expectEquals(log, juce::String("e0 0+40 e1 e2 40+60 "));
+      expectEquals(queue.GetNumEvents(), 2);
+      expectEquals(queue.begin()->sampleOffset, 0);
+
+      log.clear();
+      queue.Dispatch(100, apply, process);
+      expectEquals(log, juce::String("e3 0+30 e4 30+70 "));
+      expect(queue.IsEmpty());
+
+      log.clear();
+      queue.Dispatch(64, apply, process);
+      expectEquals(log, juce::String("0+64 "));
+    }
+
+    beginTest("GainMixProcessor ramps start at the event's sample");
+    {
+      constexpr int BlockSize = 256;
+      constexpr int EventOffset = 100;
+      constexpr int RampLength = 20; // (1 kHz * RampSeconds)
+
+      GainMixProcessor processor;
+      processor.prepare({ 1000.0, 64, 1 }); // (block is chunked too)
+      processor.getParameterEvents()->Add(EventOffset, GainMixProcessor::GainIndex, 2.f);
+
+      AlignedAudioBuffer<float> buffer(1, BlockSize);
+      juce::FloatVectorOperations::fill(buffer.GetChannel(0), 1.f, BlockSize);
+      processor.processBlock(buffer.GetView(), {});
+
+      const float* samples = buffer.GetChannel(0);
+      bool bUntouched = true;
+      for (int i = 0; i < EventOffset; ++i)
+      {
+        bUntouched &= samples[i] == 1.f;
+      }
+      expect(bUntouched);
+      expect(samples[EventOffset] > 1.f && samples[EventOffset] < 2.f);
+      expectEquals(samples[EventOffset + RampLength - 1], 2.f);
+      expectEquals(samples[BlockSize - 1], 2.f);
+
+      // the event holds until the parameter itself changes
+      juce::FloatVectorOperations::fill(buffer.GetChannel(0), 1.f, BlockSize);
+      processor.processBlock(buffer.GetView(), {});
+      expectEquals(buffer.GetChannel(0)[0], 2.f);
+
+      // out of range values are clamped, as parameter writes are
+      processor.getParameterEvents()->Add(0, GainMixProcessor::MixIndex, -3.f);
+      processor.exec();
+      juce::FloatVectorOperations::fill(buffer.GetChannel(0), 1.f, BlockSize);
+      processor.processBlock(buffer.GetView(), {});
+      expectEquals(buffer.GetChannel(0)[BlockSize - 1], 1.f); // (all dry)
+    }
+
+    beginTest("ProcessorProxy forwards events to the processor that runs the block");
+    {
+      ProcessorReclaimer reclaimer(60 * 60 * 1000);
+      ProcessorProxy proxy(reclaimer);
+      proxy.prepare({ 1000.0, 64, 1 });
+
+      proxy.getParameterEvents()->Add(0, GainMixProcessor::GainIndex, 3.f);
+      proxy.exec(); // (no processor, dropped)
+      expect(proxy.getParameterEvents()->IsEmpty());
+
+      proxy.SetProcessor(std::make_unique<GainMixProcessor>());
+      proxy.getParameterEvents()->Add(10, GainMixProcessor::GainIndex, 3.f);
+
+      AlignedAudioBuffer<float> buffer(1, 64);
+      juce::FloatVectorOperations::fill(buffer.GetChannel(0), 1.f, 64);
+      proxy.processBlock(buffer.GetView(), {});
+      expectEquals(buffer.GetChannel(0)[9], 1.f);
+      expectEquals(buffer.GetChannel(0)[63], 3.f);
+      reclaimer.ReclaimNow();
+    }
+  }
+
+} // namespace Haze
@@ -0,0 +1,23 @@
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace Haze
+{
+namespace UnitTests
+{
+
+  class ParameterEventsTest : public juce::UnitTest
+  {
+  public:
+    // ctor
+    ParameterEventsTest() : UnitTest("Sample-accurate parameter events") {}
+
+    virtual void runTest() override final;
+
+  }; // ParameterEventsTest
+
+  static ParameterEventsTest EventTest; // static addition to the test array
+
+} // UnitTests
+} // Haze
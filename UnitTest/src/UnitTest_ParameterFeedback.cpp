@@ -0,0 +1,70 @@
+
+#include "UnitTest_ParameterFeedback.h"
+#include "ParameterFeedback.h"
+
+namespace Haze
+{
+
+  void UnitTests::ParameterFeedbackTest::runTest()
+  {
+    const juce::Identifier Level("level");
+    const juce::Identifier NumVoices("NumVoices");
+    const juce::Identifier Clipping("Clipping");
+
+    ParameterList param_list;
+    param_list
+      .add(Level, 0.f)
+      .add(NumVoices, 0)
+      .add(Clipping, false)
+    ;
+
+    juce::ValueTree paramListTree = param_list.GetStateAsTree();
+    param_list.SyncToTree(paramListTree);
+
+    ParameterFeedback feedback(param_list, paramListTree, 16);
+
+    const int level = param_list.IndexOf(Level);
+    const int numVoices = param_list.IndexOf(NumVoices);
+    const int clipping = param_list.IndexOf(Clipping);
+
+    beginTest("Pushed values reach the tree and the parameter list");
+    expect(feedback.Push(level, 0.5));
+    expect(feedback.Push(numVoices, 3.0));
+    expect(feedback.Push(clipping, 1.0));
+    expect(feedback.Drain() == 3);
+
+    expect(param_list[Level]->IsEqualTo(0.5f));
+    expect(param_list[NumVoices]->IsEqualTo(3));
+    expect(param_list[Clipping]->IsEqualTo(true));
+
+    // (tree keeps each property's type)
+    expect(paramListTree[NumVoices].isInt());
+    expect(paramListTree[Clipping].isBool());
+
+    beginTest("Updates are coalesced, last write wins");
+    for (int i = 1; i <= 10; ++i)
+    {
+      feedback.Push(level, i / 10.0);
+    }
+    feedback.Push(numVoices, 7.0);
+    expect(feedback.Drain() == 2);
+    expect(param_list[Level]->IsEqualTo(1.f));
+    expect(param_list[NumVoices]->IsEqualTo(7));
+
+    expect(feedback.Drain() == 0);
+
+    beginTest("A full fifo drops updates instead of blocking");
+    int numAccepted = 0;
+    for (int i = 0; i < 100; ++i)
+    {
+      numAccepted += feedback.Push(level, static_cast<double>(i)) ? 1 : 0;
+    }
+    expect(numAccepted < 100);
+    expect(feedback.GetNumDropped() == 100 - numAccepted);
+
+    feedback.Drain();
+    expect(param_list[Level]->IsEqualTo(static_cast<float>(numAccepted - 1)));
+    expect(feedback.Push(level, 0.25));
+  }
+
+} // Haze
@@ -0,0 +1,23 @@
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace Haze
+{
+namespace UnitTests
+{
+
+  class ParameterFeedbackTest : public juce::UnitTest
+  {
+  public:
+    // ctor
+    ParameterFeedbackTest() : UnitTest("DSP to UI parameter feedback") {}
+
+    virtual void runTest() override final;
+
+  }; // ParameterFeedbackTest
+
+  static ParameterFeedbackTest FeedbackTest; // static addition to the test array
+
+} // UnitTests
+} // Haze
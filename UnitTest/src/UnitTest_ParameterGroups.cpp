@@ -0,0 +1,191 @@
+
+#include "UnitTest_ParameterGroups.h"
+#include "ParameterTypes.h"
+#include "ParameterFeedback.h"
+
+namespace Haze
+{
+
+  void UnitTests::ParameterGroupsTest::runTest()
+  {
+    static const juce::Identifier Output("output");
+    static const juce::Identifier Eq("eq");
+    static const juce::Identifier Low("low");
+    static const juce::Identifier High("high");
+    static const juce::Identifier LowFreq("low_freq");
+    static const juce::Identifier LowGain("low_gain");
+    static const juce::Identifier HighFreq("high_freq");
+    static const juce::Identifier HighGain("high_gain");
+    static const juce::Identifier EqBypass("eq_bypass");
+
+    // counts the property changes a tree's listeners are told about
+    struct CountingListener : public juce::ValueTree::Listener
+    {
+      void valueTreePropertyChanged(juce::ValueTree&, const juce::Identifier&) override { ++numChanges; }
+      int numChanges = 0;
+    };
+
+    ParameterList param_list;
+    param_list
+      .add(Output, 0.f)
+      .BeginGroup(Eq)
+        .add(EqBypass, 0.f)
+        .BeginGroup(Low)
+          .add(LowFreq, 100.f)
+          .add(LowGain, 0.f)
+        .EndGroup()
+        .BeginGroup(High)
+          .add(HighFreq, 8000.f)
+          .add(HighGain, 0.f)
+        .EndGroup()
+      .EndGroup()
+    ;
+
+    const int eq = param_list.FindGroup(Eq);
+    const int low = param_list.FindGroup(Low);
+    const int high = param_list.FindGroup(High);
+
+    beginTest("Groups nest, and map to child trees");
+    {
+      expectEquals(param_list.GetNumGroups(), 4);
+      expectEquals(param_list.GetParentGroup(low), eq);
+      expectEquals(param_list.GetParentGroup(eq), static_cast<int>(ParameterList::RootGroup));
+      expectEquals(param_list.GetGroupOf(param_list.IndexOf(HighGain)), high);
+      expectEquals(param_list.GetGroupOf(param_list.IndexOf(Output)), static_cast<int>(ParameterList::RootGroup));
+      expect(param_list.GetGroupParameters(low) == std::vector<int> { 2, 3 });
+
+      const juce::ValueTree tree = param_list.GetStateAsTree();
+      expect(tree.hasType(ParameterList::ListTreeType));
+      expectEquals(tree.getNumProperties(), 1);
+      expectEquals(tree.getNumChildren(), 1);
+
+      const juce::ValueTree lowTree = param_list.GetGroupTree(tree, low);
+      expect(lowTree.hasType(Low) && lowTree == tree.getChild(0).getChild(0));
+      expectEquals(static_cast<float>(lowTree.getProperty(LowFreq)), 100.f);
+
+      // w/o groups: the flat layout, as before
+      ParameterList flat_list;
+      flat_list.add(LowFreq, 100.f).add(LowGain, 0.f);
+      expectEquals(flat_list.GetStateAsTree().getNumProperties(), 2);
+      expectEquals(flat_list.GetStateAsTree().getNumChildren(), 0);
+    }
+
+    beginTest("Sync is scoped to each group's subtree");
+    {
+      juce::ValueTree tree = param_list.GetStateAsTree();
+      param_list.SyncToTree(tree);
+
+      // ui pages listen to their own group
+      juce::ValueTree lowTree = param_list.GetGroupTree(tree, low);
+      juce::ValueTree highTree = param_list.GetGroupTree(tree, high);
+      CountingListener lowPage, highPage;
+      lowTree.addListener(&lowPage);
+      highTree.addListener(&highPage);
+
+      lowTree.setProperty(LowGain, -6.f, nullptr);
+      lowTree.setProperty(LowFreq, 120.f, nullptr);
+      tree.setProperty(Output, 0.5f, nullptr);
+
+      expectEquals(param_list[LowGain]->Get<float>(), -6.f);
+      expectEquals(param_list[LowFreq]->Get<float>(), 120.f);
+      expectEquals(param_list[Output]->Get<float>(), 0.5f);
+      expectEquals(lowPage.numChanges, 2);
+      expectEquals(highPage.numChanges, 0);
+
+      // a per-band preset, into the synced tree: only that band's page hears about it
+      juce::ValueTree preset = param_list.GetGroupStateAsTree(high);
+      preset.setProperty(HighGain, 3.f, nullptr);
+      for (int i = 0; i < preset.getNumProperties(); ++i)
+      {
+        highTree.setProperty(preset.getPropertyName(i), preset.getProperty(preset.getPropertyName(i)), nullptr);
+      }
+      expectEquals(param_list[HighGain]->Get<float>(), 3.f);
+      expectEquals(highPage.numChanges, 1);
+      expectEquals(lowPage.numChanges, 2);
+
+      lowTree.removeListener(&lowPage);
+      highTree.removeListener(&highPage);
+
+      param_list.DesyncFromTree(tree);
+      lowTree.setProperty(LowGain, 0.f, nullptr);
+      expectEquals(param_list[LowGain]->Get<float>(), -6.f);
+    }
+
+    beginTest("Group restore only touches that group");
+    {
+      juce::ValueTree preset = param_list.GetGroupStateAsTree(eq);
+      preset.getChildWithName(Low).setProperty(LowFreq, 200.f, nullptr);
+      preset.setProperty(EqBypass, 1.f, nullptr);
+
+      param_list[Output]->SetAsVar(0.25f);
+      param_list.RestoreGroup(eq, preset);
+
+      expectEquals(param_list[EqBypass]->Get<float>(), 1.f);
+      expectEquals(param_list[LowFreq]->Get<float>(), 200.f);
+      expectEquals(param_list[HighGain]->Get<float>(), 3.f);
+      expectEquals(param_list[Output]->Get<float>(), 0.25f); // (outside the group)
+    }
+
+    beginTest("Unknown properties in a group subtree are skipped");
+    {
+      juce::ValueTree preset = param_list.GetGroupStateAsTree(eq);
+      juce::ValueTree lowTree = preset.getChildWithName(Low);
+      lowTree.setProperty("low_q", 0.7f, nullptr); // (not a parameter, i.e. from a newer version)
+      lowTree.setProperty(LowGain, -3.f, nullptr);
+
+      param_list.RestoreGroup(eq, preset);
+      expectEquals(param_list[LowGain]->Get<float>(), -3.f);
+
+      juce::ValueTree tree = param_list.GetStateAsTree();
+      tree.getChildWithName(Eq).getChildWithName(Low).setProperty("low_q", 0.7f, nullptr);
+      tree.getChildWithName(Eq).getChildWithName(Low).setProperty(LowGain, -4.f, nullptr);
+
+      ParameterSnapshot snapshot;
+      param_list.CaptureSnapshot(tree, snapshot);
+      expectEquals(static_cast<float>(snapshot.values[static_cast<size_t>(param_list.IndexOf(LowGain))]), -4.f);
+
+      param_list.SyncToTree(tree);
+      expectEquals(param_list[LowGain]->Get<float>(), -4.f);
+      param_list.DesyncFromTree(tree);
+    }
+
+    beginTest("Flat trees restore into a grouped list, syncing adds the missing subtrees");
+    {
+      juce::ValueTree flat(ParameterList::ListTreeType);
+      flat.setProperty(HighFreq, 5000.f, nullptr);
+      flat.setProperty(Output, 1.f, nullptr);
+
+      param_list.RestoreFromTree(flat);
+      expectEquals(param_list[HighFreq]->Get<float>(), 5000.f);
+      expectEquals(param_list[Output]->Get<float>(), 1.f);
+
+      param_list.SyncToTree(flat);
+      juce::ValueTree highTree = param_list.GetGroupTree(flat, high);
+      expect(highTree.isValid());
+      expectEquals(static_cast<float>(highTree.getProperty(HighFreq)), 5000.f);
+
+      highTree.setProperty(HighFreq, 6000.f, nullptr);
+      expectEquals(param_list[HighFreq]->Get<float>(), 6000.f);
+      param_list.DesyncFromTree(flat);
+    }
+
+    beginTest("Feedback bound before SyncToTree holds values back until their subtree exists");
+    {
+      juce::ValueTree flat(ParameterList::ListTreeType);
+      ParameterFeedback feedback(param_list, flat, 16);
+
+      feedback.Push(param_list.IndexOf(LowGain), 3.0);
+      feedback.Push(param_list.IndexOf(Output), 0.5);
+      expectEquals(feedback.Drain(), 1); // (output lives in the root tree)
+      expect(!flat.hasProperty(LowGain));
+
+      param_list.SyncToTree(flat);
+      expectEquals(feedback.Drain(), 1);
+      expectEquals(static_cast<float>(param_list.GetGroupTree(flat, low).getProperty(LowGain)), 3.f);
+      expectEquals(param_list[LowGain]->Get<float>(), 3.f);
+      expectEquals(param_list[Output]->Get<float>(), 0.5f);
+      param_list.DesyncFromTree(flat);
+    }
+  }
+
+} // namespace Haze
@@ -0,0 +1,23 @@
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace Haze
+{
+namespace UnitTests
+{
+
+  class ParameterGroupsTest : public juce::UnitTest
+  {
+  public:
+    // ctor
+    ParameterGroupsTest() : UnitTest("Parameter groups") {}
+
+    virtual void runTest() override final;
+
+  }; // ParameterGroupsTest
+
+  static ParameterGroupsTest GroupsTest; // static addition to the test array
+
+} // UnitTests
+} // Haze
@@ -0,0 +1,134 @@
+
+#include "UnitTest_ParameterHistory.h"
+#include "ParameterHistory.h"
+
+namespace Haze
+{
+
+  void UnitTests::ParameterHistoryTest::runTest()
+  {
+    static const juce::Identifier Gain("gain");
+    static const juce::Identifier Cutoff("cutoff");
+    static const juce::Identifier Voices("voices");
+
+    const auto makeList = [](ParameterList& param_list)
+    {
+      param_list
+        .add(Gain, 1.f, ParamRange<float>(0.f, 4.f))
+        .add(Cutoff, 1000.f)
+        .add(Voices, 8)
+      ;
+    };
+
+    beginTest("A drag is one undo step, undo/redo restore both ends");
+    {
+      ParameterList param_list;
+      makeList(param_list);
+      ParameterHistory history(param_list, ParameterHistory::DefaultMaxBytes, /*coalesceMs*/0);
+
+      history.BeginGesture();
+      for (int tick = 1; tick <= 100; ++tick)
+      {
+        history.Set(Gain, 1.f + static_cast<float>(tick) * 0.01f);
+      }
+      history.EndGesture();
+
+      expectEquals(history.GetNumTransactions(), 1);
+      expectEquals(param_list[Gain]->Get<float>(), 2.f);
+
+      expect(history.Undo());
+      expectEquals(param_list[Gain]->Get<float>(), 1.f);
+      expect(!history.Undo());
+
+      expect(history.Redo());
+      expectEquals(param_list[Gain]->Get<float>(), 2.f);
+      expect(!history.Redo());
+    }
+
+    beginTest("Gestures group parameters, new edits drop the redo steps");
+    {
+      ParameterList param_list;
+      makeList(param_list);
+      ParameterHistory history(param_list, ParameterHistory::DefaultMaxBytes, 0);
+
+      history.Set(Voices, 4);
+      history.BeginGesture();
+      history.Set(Gain, 0.5f);
+      history.Set(Cutoff, 500.f);
+      history.Set(Gain, 0.25f);
+      history.EndGesture();
+      expectEquals(history.GetNumTransactions(), 2);
+
+      expect(history.Undo());
+      expectEquals(param_list[Gain]->Get<float>(), 1.f);
+      expectEquals(param_list[Cutoff]->Get<float>(), 1000.f);
+      expectEquals(param_list[Voices]->Get<int>(), 4);
+
+      history.Set(Cutoff, 2000.f);
+      expect(!history.CanRedo());
+      expectEquals(history.GetNumTransactions(), 2);
+
+      expect(history.Undo());
+      expect(history.Undo());
+      expectEquals(param_list[Cutoff]->Get<float>(), 1000.f);
+      expectEquals(param_list[Voices]->Get<int>(), 8);
+    }
+
+    beginTest("W/o gestures: runs on one parameter coalesce, no-op edits leave no step");
+    {
+      ParameterList param_list;
+      makeList(param_list);
+      ParameterHistory history(param_list, ParameterHistory::DefaultMaxBytes, /*coalesceMs*/60 * 1000);
+
+      history.Set(Gain, 2.f);
+      history.Set(Gain, 3.f);
+      history.Set(Cutoff, 10.f); // (another parameter: new step)
+      history.Set(Cutoff, 20.f);
+      history.CloseTransaction();
+      history.Set(Cutoff, 30.f);
+      expectEquals(history.GetNumTransactions(), 3);
+
+      // clamped into the range, and dragged back to where it started
+      history.Set(Gain, 10.f);
+      history.Set(Gain, 3.f);
+      expect(history.Undo());
+      expectEquals(history.GetNumTransactions(), 3);
+      expectEquals(param_list[Cutoff]->Get<float>(), 20.f);
+
+      expect(history.Undo());
+      expect(history.Undo());
+      expectEquals(param_list[Gain]->Get<float>(), 1.f);
+    }
+
+    beginTest("Memory stays within budget, the oldest steps go first");
+    {
+      ParameterList param_list;
+      makeList(param_list);
+
+      constexpr size_t Budget = 4096;
+      ParameterHistory history(param_list, Budget, 0);
+
+      for (int i = 0; i < 1000; ++i)
+      {
+        history.Set(Cutoff, static_cast<float>(i + 1));
+        history.CloseTransaction();
+        expect(history.GetNumBytes() <= Budget);
+      }
+
+      const int numKept = history.GetNumTransactions();
+      expect(numKept > 10 && numKept < 1000);
+
+      int numUndone = 0;
+      while (history.Undo())
+      {
+        ++numUndone;
+      }
+      expectEquals(numUndone, numKept);
+      expectEquals(param_list[Cutoff]->Get<float>(), static_cast<float>(1000 - numKept));
+
+      history.SetMaxBytes(0); // (the newest always stays)
+      expectEquals(history.GetNumTransactions(), 1);
+    }
+  }
+
+} // namespace Haze
@@ -0,0 +1,23 @@
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace Haze
+{
+namespace UnitTests
+{
+
+  class ParameterHistoryTest : public juce::UnitTest
+  {
+  public:
+    // ctor
+    ParameterHistoryTest() : UnitTest("Parameter undo/redo history") {}
+
+    virtual void runTest() override final;
+
+  }; // ParameterHistoryTest
+
+  static ParameterHistoryTest HistoryTest; // static addition to the test array
+
+} // UnitTests
+} // Haze
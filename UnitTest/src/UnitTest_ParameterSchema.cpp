@@ -0,0 +1,81 @@
+
+#include "UnitTest_ParameterSchema.h"
+#include "ParameterTypes.h"
+
+namespace Haze
+{
+
+  void UnitTests::ParameterSchemaTest::runTest()
+  {
+    static const juce::Identifier Gain("gain");
+    static const juce::Identifier Voices("voices");
+    static const juce::Identifier Filter("filter");
+    static const juce::Identifier Cutoff("cutoff");
+    static const juce::Identifier Drive("drive");
+
+    ParameterList prototype;
+    prototype
+      .add(Gain, 0.5f, ParamRange<float>(0.f, 1.f), {"Gain", "output level", "dB"})
+      .add(Voices, 8)
+      .BeginGroup(Filter)
+        .add(Cutoff, 1000.f, ParamRange<float>(20.f, 20000.f), {"Cutoff", "", "Hz", false, /*bIsLogarithmic*/true})
+      .EndGroup()
+    ;
+    prototype[Gain]->SetAsVar(0.9f);
+
+    const ParameterSchema::Ptr schema = prototype.GetSchema();
+
+    beginTest("Instances share the layout, and start at its defaults");
+    {
+      ParameterList instance(schema);
+      expect(instance.GetSchema() == schema);
+      expectEquals(instance.GetNumParameters(), 3);
+      expect(&instance.GetMetadata(0) == &prototype.GetMetadata(0)); // (the same strings, not a copy)
+      expect(instance.GetName(2) == Cutoff);
+      expectEquals(instance.GetGroupOf(2), instance.FindGroup(Filter));
+
+      expectEquals(instance[Gain]->Get<float>(), 0.5f); // (the default, not the prototype's value)
+      expectEquals(instance[Voices]->Get<int>(), 8);
+      expectEquals(schema->GetDefault(0).GetAsVar(), juce::var(0.5f));
+      expect(instance.GetStateAsTree().getChildWithName(Filter).isValid());
+    }
+
+    beginTest("Values are per instance, ranges come w/ the schema");
+    {
+      ParameterList a(schema);
+      ParameterList b(schema);
+
+      a[Cutoff]->SetAsVar(50000.f);
+      b[Voices]->SetAsVar(2);
+
+      expectEquals(a[Cutoff]->Get<float>(), 20000.f);
+      expectEquals(b[Cutoff]->Get<float>(), 1000.f);
+      expectEquals(a[Voices]->Get<int>(), 8);
+      expectEquals(b[Voices]->Get<int>(), 2);
+
+      ParameterList realtime(schema, ParameterList::TransportMode::Realtime);
+      const ParamHandle<float> gain = realtime.GetHandle<float>(Gain);
+      gain.Set(0.25f);
+      expectEquals(static_cast<float>(gain.Load()), 0.25f);
+    }
+
+    beginTest("Adding to a list w/ a shared schema copies it first");
+    {
+      ParameterList instance(schema);
+      const int numShared = schema->getReferenceCount();
+
+      instance.add(Drive, 1.f);
+      expect(instance.GetSchema() != schema);
+      expectEquals(schema->getReferenceCount(), numShared - 1);
+      expectEquals(instance.GetNumParameters(), 4);
+      expectEquals(instance[Gain]->Get<float>(), 0.5f);
+      expectEquals(instance.GetSchema()->GetMetadata(0).Units_, juce::String("dB"));
+
+      // the shared layout is untouched
+      expectEquals(schema->GetNumParameters(), 3);
+      expectEquals(schema->IndexOf(Drive), static_cast<int>(IdentifierIndex::NotFound));
+      expectEquals(ParameterList(schema).GetNumParameters(), 3);
+    }
+  }
+
+} // namespace Haze
@@ -0,0 +1,23 @@
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace Haze
+{
+namespace UnitTests
+{
+
+  class ParameterSchemaTest : public juce::UnitTest
+  {
+  public:
+    // ctor
+    ParameterSchemaTest() : UnitTest("Shared parameter schema") {}
+
+    virtual void runTest() override final;
+
+  }; // ParameterSchemaTest
+
+  static ParameterSchemaTest SchemaTest; // static addition to the test array
+
+} // UnitTests
+} // Haze
@@ -0,0 +1,130 @@
+
+#include "UnitTest_ParameterSmoothing.h"
+#include "ParameterSmoothing.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Haze
+{
+
+  void UnitTests::ParameterSmoothingTest::runTest()
+  {
+    constexpr double SampleRate = 1000.0;
+    constexpr double RampSeconds = 0.1; // 100 samples
+
+    beginTest("Ramp kernels");
+    {
+      std::vector<float> ramp(37);
+      FillLinearRamp(ramp.data(), 1.f, 0.5f, 37);
+      bool bMatches = true;
+      for (size_t i = 0; i < ramp.size(); ++i)
+      {
+        bMatches &= std::abs(ramp[i] - (1.f + 0.5f * static_cast<float>(i + 1))) < 1.0e-4f;
+      }
+      expect(bMatches, "linear ramp");
+
+      FillMultiplicativeRamp(ramp.data(), 1.f, 1.01f, 37);
+      bMatches = true;
+      for (size_t i = 0; i < ramp.size(); ++i)
+      {
+        bMatches &= std::abs(ramp[i] - std::pow(1.01f, static_cast<float>(i + 1))) < 1.0e-4f;
+      }
+      expect(bMatches, "multiplicative ramp");
+    }
+
+    // block rendering must agree w/ stepping one sample at a time, across block boundaries
+    for (const auto ramp : { ParamSmoother::Ramp::Linear, ParamSmoother::Ramp::Multiplicative })
+    {
+      beginTest(ramp == ParamSmoother::Ramp::Linear ? "Linear ramp: block == per-sample" : "Multiplicative ramp: block == per-sample");
+
+      ParamSmoother blockSmoother(ramp, 100.f);
+      ParamSmoother sampleSmoother(ramp, 100.f);
+      blockSmoother.Prepare(SampleRate, RampSeconds);
+      sampleSmoother.Prepare(SampleRate, RampSeconds);
+      blockSmoother.SetTarget(1000.f);
+      sampleSmoother.SetTarget(1000.f);
+
+      std::vector<float> block(32);
+      float worstError = 0.f;
+      for (int b = 0; b < 5; ++b) // 160 samples: the ramp ends mid-block
+      {
+        const bool bRendered = blockSmoother.RenderBlock(block.data(), 32);
+        for (int i = 0; i < 32; ++i)
+        {
+          const float expected = sampleSmoother.GetNextValue();
+          const float actual = bRendered ? block[static_cast<size_t>(i)] : blockSmoother.GetCurrent();
+          worstError = juce::jmax(worstError, std::abs(expected - actual) / expected);
+        }
+      }
+
+      expect(worstError < 1.0e-4f, "relative error " + juce::String(worstError));
+      expect(!blockSmoother.IsSmoothing());
+      expect(blockSmoother.GetCurrent() == 1000.f);
+    }
+
+    beginTest("Settled smoother skips rendering");
+    {
+      ParamSmoother smoother(ParamSmoother::Ramp::Linear, 1.f);
+      smoother.Prepare(SampleRate, RampSeconds);
+
+      std::vector<float> block(64, -1.f);
+      expect(!smoother.RenderBlock(block.data(), 64));
+      expect(block[0] == -1.f); // untouched
+
+      smoother.SetTarget(1.f);
+      expect(!smoother.RenderBlock(block.data(), 64));
+
+      smoother.SetTarget(2.f);
+      expect(smoother.RenderBlock(block.data(), 64));
+      expect(block[63] > 1.f && block[63] < 2.f);
+    }
+
+    beginTest("Multiplicative ramp to or from zero falls back to linear");
+    {
+      ParamSmoother smoother(ParamSmoother::Ramp::Multiplicative, 0.f);
+      smoother.Prepare(SampleRate, RampSeconds);
+
+      std::vector<float> block(64);
+      for (const float target : { 100.f, 0.f, 50.f })
+      {
+        smoother.SetTarget(target);
+        while (smoother.RenderBlock(block.data(), 64))
+        {
+          expect(std::all_of(block.begin(), block.end(), [](float x) { return std::isfinite(x) && x >= 0.f && x <= 100.f; }));
+        }
+        expect(smoother.GetCurrent() == target);
+      }
+    }
+
+    beginTest("SmoothedParam follows its parameter, log metadata picks a multiplicative ramp");
+    {
+      const juce::Identifier Freq("freq");
+      const juce::Identifier Gain("gain");
+
+      ParameterList param_list(ParameterList::TransportMode::Realtime);
+      param_list
+        .add(Freq, 500.f, {"Freq.", "filter cutoff freq.", "hz", false, /*bIsLogarithmic*/true })
+        .add(Gain, 0.f)
+      ;
+
+      SmoothedParam freq(param_list, Freq);
+      SmoothedParam gain(param_list, Gain);
+      freq.Prepare(SampleRate, RampSeconds);
+      gain.Prepare(SampleRate, RampSeconds);
+
+      expect(freq.GetSmoother().GetRamp() == ParamSmoother::Ramp::Multiplicative);
+      expect(gain.GetSmoother().GetRamp() == ParamSmoother::Ramp::Linear);
+
+      std::vector<float> block(100);
+      expect(!freq.RenderBlock(block.data(), 100));
+      expect(freq.GetCurrent() == 500.f);
+
+      *param_list[Freq] = 5000.f;
+      expect(freq.RenderBlock(block.data(), 100));
+      expect(std::abs(block[49] - 1581.14f) < 1.f); // geometric midpoint, sqrt(500 * 5000)
+      expect(block[99] == 5000.f);
+      expect(!freq.RenderBlock(block.data(), 100));
+    }
+  }
+
+} // Haze
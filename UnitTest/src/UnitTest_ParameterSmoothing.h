@@ -0,0 +1,23 @@
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace Haze
+{
+namespace UnitTests
+{
+
+  class ParameterSmoothingTest : public juce::UnitTest
+  {
+  public:
+    // ctor
+    ParameterSmoothingTest() : UnitTest("Parameter smoothing") {}
+
+    virtual void runTest() override final;
+
+  }; // ParameterSmoothingTest
+
+  static ParameterSmoothingTest SmoothingTest; // static addition to the test array
+
+} // UnitTests
+} // Haze
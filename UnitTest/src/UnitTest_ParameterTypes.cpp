@@ -66,6 +66,23 @@ namespace Haze
     expect(param_list[NumTaps]->IsEqualTo(222) == true);
 
 
+    beginTest("Parameter handles (typed access without indexing or casting)");
+    ParamHandle<float> freqHandle = param_list.GetHandle<float>(Freq);
+    expect(freqHandle.IsValid());
+    expect(freqHandle.Get() == param_list[Freq]->Get<float>());
+
+    freqHandle.Set(42.f);
+    expect(param_list[Freq]->IsEqualTo(42.f));
+
+    *param_list[Freq] = 15.f;
+    expect(freqHandle.IsEqualTo(15.f));
+    expect(&freqHandle.GetRef() == &param_list[Freq]->GetRef<float>());
+
+    // handles stay valid as the list grows
+    param_list.add(juce::Identifier("Gain"), 1.f);
+    expect(*freqHandle == 15.f);
+
+
     // ...bootstrap a juce::ValueTree from that list
     beginTest("Bootstrap juce::ValueTree from ParameterList");
     auto xmlString = param_list.GetStateAsTree().toXmlString();
@@ -91,14 +108,120 @@ namespace Haze
     // ...so that when the value tree chanegs, my parameters will update internally
     paramListTree.setProperty({"Enabled"}, true, nullptr);
     expect(param_list[Enabled]->IsEqualTo(true));
+
+    // ...save and restore the whole list in one go (i.e. presets)
+    beginTest("Bulk snapshot capture/restore");
+    const float savedFreq = param_list[Freq]->Get<float>();
+    ParameterSnapshot snapshot;
+    param_list.CaptureSnapshot(snapshot);
+    expect(snapshot.values.size() == static_cast<size_t>(param_list.GetNumParameters()));
+
+    *param_list[Freq] = 99.f;
+    *param_list[NumTaps] = 3;
+    param_list.RestoreSnapshot(snapshot);
+    expect(param_list[Freq]->IsEqualTo(savedFreq));
+    expect(param_list[NumTaps]->IsEqualTo(222));
+
+    beginTest("Restore from a juce::ValueTree (in order, out of order, partial)");
+    juce::ValueTree presetTree = param_list.GetStateAsTree();
+    presetTree.setProperty(Freq, 440.0, nullptr);
+    param_list.RestoreFromTree(presetTree);
+    expect(param_list[Freq]->IsEqualTo(440.f));
+
+    juce::ValueTree shuffledTree(presetTree.getType());
+    shuffledTree.setProperty(NumTaps, 8, nullptr);
+    shuffledTree.setProperty(Freq, 220.0, nullptr);
+    param_list.RestoreFromTree(shuffledTree);
+    expect(param_list[Freq]->IsEqualTo(220.f));
+    expect(param_list[NumTaps]->IsEqualTo(8));
+
+    param_list.CaptureSnapshot(presetTree, snapshot);
+    expect(param_list[Freq]->IsEqualTo(220.f)); // (list untouched)
+    param_list.RestoreSnapshot(snapshot);
+    expect(param_list[Freq]->IsEqualTo(440.f));
+    expect(param_list[NumTaps]->IsEqualTo(222));
+
+    // ...load trees w/ properties that aren't parameters (older presets, renamed ids): they're ignored
+    beginTest("Restore, sync and capture skip unknown tree properties");
+    juce::ValueTree strayTree(presetTree.getType());
+    strayTree.setProperty("retired_param", 1.0, nullptr);
+    strayTree.setProperty(Freq, 330.0, nullptr);
+    param_list.RestoreFromTree(strayTree);
+    expect(param_list[Freq]->IsEqualTo(330.f));
+
+    strayTree.setProperty(Freq, 110.0, nullptr);
+    param_list.CaptureSnapshot(strayTree, snapshot);
+    expect(snapshot.values.size() == static_cast<size_t>(param_list.GetNumParameters()));
+    expect(static_cast<float>(snapshot.values[static_cast<size_t>(param_list.IndexOf(Freq))]) == 110.f);
+
+    param_list.SyncToTree(strayTree);
+    expect(param_list[Freq]->IsEqualTo(110.f));
+    strayTree.setProperty("retired_param", 2.0, nullptr);
+    strayTree.setProperty(Freq, 120.0, nullptr);
+    expect(param_list[Freq]->IsEqualTo(120.f));
+    param_list.DesyncFromTree(strayTree);
+    param_list.RestoreSnapshot(snapshot);
+
+    // ...look up parameters by name quickly, even in very large lists
+    beginTest("Parameter lookup in a large list");
+    ParameterList big_list;
+    for (int i = 0; i < 1000; ++i)
+    {
+      big_list.add(juce::Identifier("param_" + juce::String(i)), int { i });
+    }
+
+    bool bAllFound = true;
+    for (int i = 0; i < 1000; ++i)
+    {
+      // (fresh Identifier each time, resolves to the same pooled string)
+      bAllFound &= big_list[juce::Identifier("param_" + juce::String(i))]->IsEqualTo(i);
+    }
+    expect(bAllFound);
+
+    // ...give numeric parameters a range that every write is clamped/snapped into
+    beginTest("Typed range and clamp policy");
+    static_assert(ParamRange<int>(0, 10).Clamp(12) == 10);
+    static_assert(ParamRange<int>(0, 10, 4).Clamp(7) == 8);
+    static_assert(ParamRange<float>(-1.f, 1.f).Clamp(-3.f) == -1.f);
+
+    const juce::Identifier Cutoff("Cutoff");
+    const juce::Identifier Octave("Octave");
+    const juce::Identifier Label("Label");
+
+    ParameterList ranged_list;
+    ranged_list
+      .add(Cutoff, 50000.f, ParamRange<float>(20.f, 20000.f, 0.f, 0.3), {"Cutoff", "filter cutoff freq.", "hz", false, true })
+      .add(Octave, 0, { -2, 2, 1 })
+      .add(Label, juce::String("unranged"))
+    ;
+    expect(ranged_list[Cutoff]->IsEqualTo(20000.f)); // (default clamped too)
+
+    *ranged_list[Cutoff] = 5.f;
+    expect(ranged_list[Cutoff]->IsEqualTo(20.f));
+
+    ranged_list[Cutoff]->SetAsVar(1.0e6);
+    expect(ranged_list[Cutoff]->IsEqualTo(20000.f));
+
+    ranged_list.GetHandle<int>(Octave).Set(7);
+    expect(ranged_list[Octave]->IsEqualTo(2));
+
+    ranged_list[Octave]->SetAsVar(-9);
+    expect(ranged_list[Octave]->IsEqualTo(-2));
+
+    juce::ValueTree rangedTree = ranged_list.GetStateAsTree();
+    rangedTree.setProperty(Cutoff, -1.0, nullptr);
+    ranged_list.RestoreFromTree(rangedTree);
+    expect(ranged_list[Cutoff]->IsEqualTo(20.f));
+
+    // (ranges can be added later, the current value is clamped right away)
+    param_list[NumTaps]->SetRange(ParamRange<int>(1, 64));
+    *param_list[NumTaps] = 0;
+    expect(param_list[NumTaps]->IsEqualTo(1));
+
+    const ParamRange<float> skewed(20.f, 20000.f, 0.f, 0.3);
+    expectWithinAbsoluteError(skewed.ConvertFrom0to1(skewed.ConvertTo0to1(1000.f)), 1000.f, 0.01f);
+    expectEquals(skewed.ConvertTo0to1(20.f), 0.0);
+    expectEquals(skewed.ConvertTo0to1(20000.f), 1.0);
   }
   
 } // Haze
-
-
-// random thought:
-/*
- *  it would be badass to have separate execution edges for different threads
- *  (i.e. UI thread vs Audio thread vs debug thread?)
- *  Data could be exchanged, but execution graphs would be separate
-*/
@@ -0,0 +1,124 @@
+
+#include "UnitTest_PresetBank.h"
+#include "PresetBank.h"
+
+namespace Haze
+{
+
+  void UnitTests::PresetBankTest::runTest()
+  {
+    const juce::Identifier Freq("freq");
+    const juce::Identifier NumTaps("NumTaps");
+    const juce::Identifier Label("Label");
+
+    ParameterList param_list;
+    param_list.add(Freq, 500.f)
+              .add(NumTaps, 4)
+              .add(Label, juce::String("init"))
+    ;
+
+    // preset i: freq = 100 * i, taps = i, label = name
+    const juce::StringArray names { "Pad", "Bass 01", "Arp", "Lead", "Bass 02", "Zither", "caf\xc3\xa9" };
+
+    PresetBankWriter writer;
+    for (int i = 0; i < names.size(); ++i)
+    {
+      *param_list[Freq] = 100.f * static_cast<float>(i);
+      *param_list[NumTaps] = int { i };
+      *param_list[Label] = names[i];
+      expect(writer.AddPreset(names[i], param_list));
+    }
+
+    juce::TemporaryFile bankFile(".hzpk");
+    expect(writer.WriteTo(bankFile.getFile()));
+
+    beginTest("Duplicate names are rejected");
+    {
+      expect(!writer.AddPreset("Lead", param_list));
+      expectEquals(writer.GetNumPresets(), names.size());
+    }
+
+    beginTest("Index is sorted and searchable");
+    {
+      const PresetBank bank(bankFile.getFile());
+      expect(bank.IsValid());
+      expectEquals(bank.GetNumPresets(), names.size());
+
+      for (int i = 1; i < bank.GetNumPresets(); ++i)
+      {
+        expect(strcmp(bank.GetPresetName(i - 1).toRawUTF8(), bank.GetPresetName(i).toRawUTF8()) < 0);
+      }
+
+      for (const juce::String& name : names)
+      {
+        const int index = bank.IndexOf(name);
+        expect(index >= 0);
+        expect(bank.GetPresetName(index) == name);
+      }
+
+      expectEquals(bank.IndexOf("Bass"), -1);
+      expectEquals(bank.IndexOf("Bass 01 "), -1);
+      expectEquals(bank.IndexOf("zz"), -1);
+      expectEquals(bank.IndexOf(""), -1);
+    }
+
+    beginTest("Presets decode on demand");
+    {
+      const PresetBank bank(bankFile.getFile());
+
+      for (int i = 0; i < names.size(); ++i)
+      {
+        expect(bank.LoadPreset(names[i], param_list));
+        expectEquals(param_list[Freq]->Get<float>(), 100.f * static_cast<float>(i));
+        expectEquals(param_list[NumTaps]->Get<int>(), i);
+        expect(param_list[Label]->Get<juce::String>() == names[i]);
+      }
+
+      *param_list[NumTaps] = 42;
+      expect(!bank.LoadPreset("missing", param_list));
+      expectEquals(param_list[NumTaps]->Get<int>(), 42);
+    }
+
+    beginTest("Empty bank");
+    {
+      juce::TemporaryFile emptyFile(".hzpk");
+      expect(PresetBankWriter().WriteTo(emptyFile.getFile()));
+
+      const PresetBank bank(emptyFile.getFile());
+      expect(bank.IsValid());
+      expectEquals(bank.GetNumPresets(), 0);
+      expectEquals(bank.IndexOf("Pad"), -1);
+    }
+
+    beginTest("Damaged files");
+    {
+      juce::MemoryBlock original;
+      expect(bankFile.getFile().loadFileAsData(original));
+
+      juce::TemporaryFile damagedFile(".hzpk");
+
+      // header/index truncated: the bank itself is rejected
+      expect(damagedFile.getFile().replaceWithData(original.getData(), 40));
+      expect(!PresetBank(damagedFile.getFile()).IsValid());
+      expectEquals(PresetBank(damagedFile.getFile()).GetNumPresets(), 0);
+
+      // missing file
+      expect(!PresetBank(damagedFile.getFile().getSiblingFile("does_not_exist.hzpk")).IsValid());
+
+      // a damaged preset only fails that preset
+      juce::MemoryBlock damaged(original);
+      const int leadIndex = PresetBank(bankFile.getFile()).IndexOf("Lead");
+      const size_t leadOffset = BinaryPreset::ReadLE<juce::uint64>(static_cast<const juce::uint8*>(original.getData())
+                                                                    + PresetBankFormat::HeaderSize
+                                                                    + PresetBankFormat::IndexEntrySize * static_cast<size_t>(leadIndex) + 8);
+      damaged[leadOffset] = 'X'; // preset magic
+
+      expect(damagedFile.getFile().replaceWithData(damaged.getData(), damaged.getSize()));
+      const PresetBank bank(damagedFile.getFile());
+      expect(bank.IsValid());
+      expect(!bank.LoadPreset("Lead", param_list));
+      expect(bank.LoadPreset("Pad", param_list));
+    }
+  }
+
+} // namespace Haze
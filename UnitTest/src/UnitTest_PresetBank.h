@@ -0,0 +1,23 @@
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace Haze
+{
+namespace UnitTests
+{
+
+  class PresetBankTest : public juce::UnitTest
+  {
+  public:
+    // ctor
+    PresetBankTest() : UnitTest("Memory-mapped preset bank") {}
+
+    virtual void runTest() override final;
+
+  }; // PresetBankTest
+
+  static PresetBankTest MappedBankTest; // static addition to the test array
+
+} // UnitTests
+} // Haze
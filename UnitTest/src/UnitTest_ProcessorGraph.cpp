@@ -0,0 +1,389 @@
+
+#include "UnitTest_ProcessorGraph.h"
+#include "ProcessorGraph.h"
+#include <thread>
+
+namespace Haze
+{
+  namespace
+  {
+    // stamps every exec() w/ a global sequence number
+    class StampProcessor : public ProcessorInterface
+    {
+    public:
+      explicit StampProcessor(std::atomic<int>& clock) : clock_(clock) {}
+
+      const ParameterList& getUiParameterList() const override { return params_; }
+
+      void exec() override
+      {
+        stamp_ = clock_.fetch_add(1) + 1;
+        ++numCalls_;
+      }
+
+      int stamp_ = 0;
+      int numCalls_ = 0;
+
+    private:
+      std::atomic<int>& clock_;
+      ParameterList params_;
+    };
+
+    // scales its block, remembering where the last one started
+    class ScaleProcessor : public ProcessorInterface
+    {
+    public:
+      explicit ScaleProcessor(float gain) : gain_(gain) {}
+
+      const ParameterList& getUiParameterList() const override { return params_; }
+
+      void exec() override {}
+
+      using ProcessorInterface::processBlock;
+      void processBlock(AudioBlockView<float> block, const BlockContext& context) override
+      {
+        block.Multiply(gain_);
+        lastPosition_ = context.samplePosition;
+      }
+
+      juce::int64 lastPosition_ = -1;
+
+    private:
+      const float gain_;
+      ParameterList params_;
+    };
+
+    // a non-audio node: counts its exec()s, and must never be handed a block
+    class ExecOnlyProcessor : public ProcessorInterface
+    {
+    public:
+      const ParameterList& getUiParameterList() const override { return params_; }
+
+      void exec() override { ++numCalls_; }
+
+      using ProcessorInterface::processBlock;
+      void processBlock(AudioBlockView<float>, const BlockContext&) override { bGotBlock_ = true; }
+
+      int numCalls_ = 0;
+      bool bGotBlock_ = false;
+
+    private:
+      ParameterList params_;
+    };
+
+    // publishes frames filled w/ its block count
+    class FrameWriter : public ProcessorInterface
+    {
+    public:
+      const ParameterList& getUiParameterList() const override { return params_; }
+
+      void exec() override
+      {
+        ++numBlocks_;
+        if (mailbox_ != nullptr)
+        {
+          std::fill(mailbox_->BeginWrite(), mailbox_->BeginWrite() + 64, static_cast<float>(numBlocks_));
+          mailbox_->EndWrite(64);
+        }
+      }
+
+      FrameMailbox* mailbox_ = nullptr;
+      int numBlocks_ = 0;
+
+    private:
+      ParameterList params_;
+    };
+
+    // checks every frame it sees is whole and newer than the last one
+    class FrameReader : public ProcessorInterface
+    {
+    public:
+      const ParameterList& getUiParameterList() const override { return params_; }
+
+      void exec() override
+      {
+        ++numBlocks_;
+        const FrameMailbox::Frame frame = mailbox_->Read();
+        if (frame.sequence == 0)
+        {
+          return;
+        }
+
+        bIsConsistent_ &= frame.numSamples == 64 && frame.sequence >= lastSequence_
+                          && std::all_of(frame.data, frame.data + frame.numSamples, [&](float x) { return x == frame.data[0]; });
+        lastSequence_ = frame.sequence;
+        lastValue_ = frame.data[0];
+      }
+
+      FrameMailbox* mailbox_ = nullptr;
+      int numBlocks_ = 0;
+      juce::uint32 lastSequence_ = 0;
+      float lastValue_ = 0.f;
+      bool bIsConsistent_ = true;
+
+    private:
+      ParameterList params_;
+    };
+  } // namespace
+
+  void UnitTests::ProcessorGraphTest::runTest()
+  {
+    beginTest("Work-stealing deque");
+    {
+      WorkStealingDeque deque(4);
+      expect(deque.Push(1) && deque.Push(2) && deque.Push(3) && deque.Push(4));
+      expect(!deque.Push(5)); // full
+      expectEquals(deque.Steal(), 1); // thieves take the oldest...
+      expectEquals(deque.Pop(), 4);   // ...the owner the newest
+      expectEquals(deque.Pop(), 3);
+      expectEquals(deque.Steal(), 2);
+      expectEquals(deque.Pop(), int { WorkStealingDeque::Empty });
+      expectEquals(deque.Steal(), int { WorkStealingDeque::Empty });
+    }
+
+    std::atomic<int> clock { 0 };
+    std::vector<StampProcessor*> processors;
+
+    // diamond-ish graph: 0 -> {1, 2, 3} -> 4, 2 -> 5, {4, 5} -> 6, plus unconnected 7
+    ProcessorGraph graph;
+    for (int i = 0; i < 8; ++i)
+    {
+      auto processor = std::make_unique<StampProcessor>(clock);
+      processors.push_back(processor.get());
+      graph.AddNode(std::move(processor));
+    }
+
+    const std::vector<std::pair<int, int>> edges { {0, 1}, {0, 2}, {0, 3}, {1, 4}, {2, 4}, {3, 4}, {2, 5}, {4, 6}, {5, 6} };
+
+    beginTest("Connections");
+    {
+      for (const auto& edge : edges)
+      {
+        expect(graph.Connect(edge.first, edge.second));
+      }
+
+      expect(!graph.Connect(0, 1));  // duplicate
+      expect(!graph.Connect(6, 0));  // cycle
+      expect(!graph.Connect(4, 2));  // cycle
+      expect(!graph.Connect(3, 3));  // self
+      expect(!graph.Connect(0, 42)); // unknown
+      expect(!graph.IsPrepared());
+    }
+
+    const auto expectOrdered = [&]()
+    {
+      bool bOk = true;
+      for (const auto& edge : edges)
+      {
+        bOk &= processors[static_cast<size_t>(edge.first)]->stamp_ < processors[static_cast<size_t>(edge.second)]->stamp_;
+      }
+      return bOk;
+    };
+
+    beginTest("Serial processing follows the edges");
+    {
+      graph.Prepare();
+      expect(graph.IsPrepared());
+      expectEquals(static_cast<int>(graph.GetExecutionOrder().size()), graph.GetNumNodes());
+
+      graph.Process();
+      expect(expectOrdered());
+      for (auto* processor : processors)
+      {
+        expectEquals(processor->numCalls_, 1);
+      }
+    }
+
+    for (const int numThreads : { 1, 2, 4, 8 })
+    {
+      beginTest("Parallel processing, " + juce::String(numThreads) + " thread(s)");
+
+      constexpr int NumBlocks = 500;
+      WorkerPool pool(numThreads);
+
+      bool bAllOrdered = true;
+      for (int block = 0; block < NumBlocks; ++block)
+      {
+        graph.Process(pool);
+        bAllOrdered &= expectOrdered();
+      }
+      expect(bAllOrdered);
+
+      // every node ran exactly once per block
+      bool bAllCounted = true;
+      for (auto* processor : processors)
+      {
+        bAllCounted &= processor->numCalls_ == 1 + NumBlocks;
+        processor->numCalls_ = 1;
+      }
+      expect(bAllCounted);
+    }
+
+    beginTest("Wide graph spreads across threads");
+    {
+      // many independent nodes feeding one sink
+      std::atomic<int> wideClock { 0 };
+      ProcessorGraph wide;
+      const ProcessorGraph::NodeId sink = wide.AddNode(std::make_unique<StampProcessor>(wideClock));
+      for (int i = 0; i < 200; ++i)
+      {
+        expect(wide.Connect(wide.AddNode(std::make_unique<StampProcessor>(wideClock)), sink));
+      }
+      wide.Prepare();
+
+      WorkerPool pool(4);
+      for (int block = 0; block < 100; ++block)
+      {
+        wide.Process(pool);
+      }
+
+      expectEquals(wideClock.load(), 201 * 100);
+      expectEquals(static_cast<StampProcessor&>(wide.GetProcessor(sink)).stamp_, 201 * 100); // (always last)
+    }
+
+    beginTest("Thread domains");
+    {
+      ProcessorGraph domains;
+      auto* writer = new FrameWriter();
+      auto* reader = new FrameReader();
+      const ProcessorGraph::NodeId audioNode = domains.AddNode(std::unique_ptr<ProcessorInterface>(writer), ThreadDomain::Audio);
+      const ProcessorGraph::NodeId uiNode = domains.AddNode(std::unique_ptr<ProcessorInterface>(reader), ThreadDomain::Ui);
+
+      expect(domains.Connect(audioNode, uiNode, 64));
+      expect(!domains.Connect(audioNode, uiNode)); // duplicate
+      expect(domains.Connect(uiNode, audioNode));  // feedback across domains is fine (no ordering)
+      expect(domains.GetOutputs(audioNode).empty());
+
+      writer->mailbox_ = domains.GetMailbox(audioNode, uiNode);
+      reader->mailbox_ = domains.GetMailbox(audioNode, uiNode);
+      expect(writer->mailbox_ != nullptr && domains.GetMailbox(uiNode, audioNode) != nullptr);
+      expect(domains.GetMailbox(audioNode, audioNode) == nullptr);
+
+      domains.Prepare();
+      expect(domains.GetExecutionOrder(ThreadDomain::Audio) == std::vector<int> { audioNode });
+      expect(domains.GetExecutionOrder(ThreadDomain::Ui) == std::vector<int> { uiNode });
+      expect(domains.GetExecutionOrder(ThreadDomain::Debug).empty());
+
+      // each domain runs only its own nodes
+      domains.Process(ThreadDomain::Ui);
+      expectEquals(reader->numBlocks_, 1);
+      expectEquals(writer->numBlocks_, 0);
+      expectEquals(reader->lastSequence_, juce::uint32 { 0 });
+
+      domains.Process(ThreadDomain::Audio);
+      domains.Process(ThreadDomain::Audio);
+      domains.Process(ThreadDomain::Ui);
+      expectEquals(reader->lastValue_, 2.f); // (latest frame only)
+
+      // audio + ui concurrently, the reader never sees a torn or stale frame
+      constexpr int NumAudioBlocks = 20000;
+      std::atomic<bool> bAudioDone { false };
+      std::thread audioThread([&domains, &bAudioDone]
+      {
+        WorkerPool pool(1);
+        for (int i = 0; i < NumAudioBlocks; ++i)
+        {
+          domains.Process(pool, ThreadDomain::Audio);
+        }
+        bAudioDone.store(true);
+      });
+
+      while (!bAudioDone.load())
+      {
+        domains.Process(ThreadDomain::Ui);
+      }
+      audioThread.join();
+      domains.Process(ThreadDomain::Ui);
+
+      expect(reader->bIsConsistent_);
+      expectEquals(reader->lastValue_, static_cast<float>(2 + NumAudioBlocks));
+    }
+
+    beginTest("Audio flows along the edges");
+    {
+      // a(x2) -> b(x3) -> d(x1), a -> c(x5) -> d, and e(x7) on its own: out = 2*3 + 2*5 + 7 = 23 x in
+      ProcessorGraph graph;
+      auto* sinkProcessor = new ScaleProcessor(1.f);
+      const ProcessorGraph::NodeId a = graph.AddNode(std::make_unique<ScaleProcessor>(2.f));
+      const ProcessorGraph::NodeId b = graph.AddNode(std::make_unique<ScaleProcessor>(3.f));
+      const ProcessorGraph::NodeId c = graph.AddNode(std::make_unique<ScaleProcessor>(5.f));
+      const ProcessorGraph::NodeId d = graph.AddNode(std::unique_ptr<ProcessorInterface>(sinkProcessor));
+      const ProcessorGraph::NodeId e = graph.AddNode(std::make_unique<ScaleProcessor>(7.f));
+      graph.AddNode(std::make_unique<ScaleProcessor>(0.f), ThreadDomain::Ui); // (never sees audio)
+      graph.Connect(a, b);
+      graph.Connect(a, c);
+      graph.Connect(b, d);
+      graph.Connect(c, d);
+
+      graph.Prepare({ 48000.0, 128, 2 });
+      expect(graph.GetSources() == std::vector<ProcessorGraph::NodeId> { a, e });
+      expect(graph.GetSinks() == std::vector<ProcessorGraph::NodeId> { e, d } || graph.GetSinks() == std::vector<ProcessorGraph::NodeId> { d, e });
+
+      AlignedAudioBuffer<float> io(2, 300); // (longer than prepared for: 3 passes)
+      WorkerPool pool(2);
+      for (const bool bUsePool : { false, true })
+      {
+        for (int ch = 0; ch < 2; ++ch)
+        {
+          for (int i = 0; i < 300; ++i)
+          {
+            io.GetChannel(ch)[i] = static_cast<float>(ch + 1) * 0.01f;
+          }
+        }
+
+        bUsePool ? graph.ProcessBlock(pool, io.GetView(), { 48000.0, 1000 }) : graph.ProcessBlock(io.GetView(), { 48000.0, 1000 });
+
+        expectWithinAbsoluteError(io.GetChannel(0)[0], 0.23f, 1.0e-6f);
+        expectWithinAbsoluteError(io.GetChannel(0)[299], 0.23f, 1.0e-6f);
+        expectWithinAbsoluteError(io.GetChannel(1)[150], 0.46f, 1.0e-6f);
+        expectEquals(sinkProcessor->lastPosition_, static_cast<juce::int64>(1000 + 256));
+      }
+    }
+
+    beginTest("ProcessBlock on the audio thread, Process(Ui) alongside");
+    {
+      ProcessorGraph graph;
+      auto* uiProcessor = new ExecOnlyProcessor();
+      const ProcessorGraph::NodeId gain = graph.AddNode(std::make_unique<ScaleProcessor>(2.f));
+      graph.Connect(gain, graph.AddNode(std::make_unique<ScaleProcessor>(3.f)));
+      graph.AddNode(std::unique_ptr<ProcessorInterface>(uiProcessor), ThreadDomain::Ui);
+      graph.Prepare({ 48000.0, 64, 2 });
+
+      constexpr int NumAudioBlocks = 5000;
+      for (const bool bUsePool : { false, true })
+      {
+        std::atomic<bool> bAudioDone { false };
+        bool bAudioIsCorrect = true;
+        std::thread audioThread([&]
+        {
+          WorkerPool pool(2);
+          AlignedAudioBuffer<float> io(2, 64);
+          for (int i = 0; i < NumAudioBlocks; ++i)
+          {
+            for (int ch = 0; ch < 2; ++ch)
+            {
+              juce::FloatVectorOperations::fill(io.GetChannel(ch), 1.f, 64);
+            }
+            bUsePool ? graph.ProcessBlock(pool, io.GetView(), {}) : graph.ProcessBlock(io.GetView(), {});
+            bAudioIsCorrect &= io.GetChannel(1)[63] == 6.f;
+          }
+          bAudioDone.store(true);
+        });
+
+        // (the ui pass runs its nodes' exec(), whatever the audio thread is in the middle of)
+        const int numCallsBefore = uiProcessor->numCalls_;
+        WorkerPool uiPool(1);
+        for (int pass = 0; !bAudioDone.load(); ++pass)
+        {
+          pass % 2 == 0 ? graph.Process(ThreadDomain::Ui) : graph.Process(uiPool, ThreadDomain::Ui);
+        }
+        audioThread.join();
+
+        expect(bAudioIsCorrect);
+        expect(!uiProcessor->bGotBlock_);
+        expect(uiProcessor->numCalls_ > numCallsBefore);
+      }
+    }
+  }
+
+} // namespace Haze
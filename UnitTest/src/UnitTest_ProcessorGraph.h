@@ -0,0 +1,23 @@
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace Haze
+{
+namespace UnitTests
+{
+
+  class ProcessorGraphTest : public juce::UnitTest
+  {
+  public:
+    // ctor
+    ProcessorGraphTest() : UnitTest("Processor graph + work-stealing pool") {}
+
+    virtual void runTest() override final;
+
+  }; // ProcessorGraphTest
+
+  static ProcessorGraphTest GraphTest; // static addition to the test array
+
+} // UnitTests
+} // Haze
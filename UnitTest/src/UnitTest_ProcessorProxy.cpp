@@ -0,0 +1,242 @@
+
+#include "UnitTest_ProcessorProxy.h"
+#include "ProcessorBase.h"
+#include "GainMixProcessor.h"
+#include "RealtimeCheck.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <new>
+#include <thread>
+
+namespace Haze
+{
+  namespace
+  {
+    // records which instance the proxy ran w/o trusting that instance's memory:
+    // every TrackedProcessor lives in a slot of its own that is never reused, and deleting it leaves a
+    // Tombstone in that slot. a processor run after it was freed runs Tombstone::exec(), never a newer
+    // processor that happens to sit at the same address
+    class TrackedProcessor : public ProcessorInterface
+    {
+    public:
+      static constexpr int MaxInstances = 4096; // (per test run)
+
+      explicit TrackedProcessor(int generation)
+      {
+        generations[SlotOf(this)] = generation;
+        numAlive.fetch_add(1);
+      }
+
+      ~TrackedProcessor() override { numAlive.fetch_sub(1); }
+
+      const ParameterList& getUiParameterList() const override { return params_; }
+
+      // (the generation comes from the slot table, not from this object)
+      void exec() override { lastGeneration = generations[SlotOf(this)]; }
+
+      static void* operator new(size_t size);
+      static void operator delete(void* ptr);
+
+      static inline std::atomic<int> numAlive { 0 };
+      static inline bool bRanDeleted = false;  // (audio thread) a Tombstone ran
+      static inline int lastGeneration = -1;   // (audio thread)
+
+    private:
+      static size_t SlotOf(const void* ptr);
+
+      // per slot, written before the instance is published to the proxy
+      static inline std::array<int, MaxInstances> generations {};
+
+      ParameterList params_;
+    };
+
+    // what a deleted TrackedProcessor's slot holds from then on
+    class Tombstone : public ProcessorInterface
+    {
+    public:
+      const ParameterList& getUiParameterList() const override
+      {
+        static const ParameterList none;
+        return none;
+      }
+
+      void exec() override { TrackedProcessor::bRanDeleted = true; }
+    };
+
+    struct TrackedSlots
+    {
+      static constexpr size_t Size = std::max(sizeof(TrackedProcessor), sizeof(Tombstone));
+
+      alignas(std::max_align_t) static inline std::byte memory[TrackedProcessor::MaxInstances][Size];
+      static inline std::atomic<int> numUsed { 0 };
+    };
+
+    void* TrackedProcessor::operator new(size_t size)
+    {
+      jassert(size <= TrackedSlots::Size);
+      juce::ignoreUnused(size);
+
+      const int slot = TrackedSlots::numUsed.fetch_add(1);
+      jassert(slot < MaxInstances);
+      return TrackedSlots::memory[slot];
+    }
+
+    void TrackedProcessor::operator delete(void* ptr)
+    {
+      // (runs after the destructors: the slot is raw memory again, and stays taken)
+      new (ptr) Tombstone();
+    }
+
+    size_t TrackedProcessor::SlotOf(const void* ptr)
+    {
+      return static_cast<size_t>(static_cast<const std::byte*>(ptr) - &TrackedSlots::memory[0][0]) / TrackedSlots::Size;
+    }
+  } // namespace
+
+  void UnitTests::ProcessorProxyTest::runTest()
+  {
+    ProcessorReclaimer reclaimer(60 * 60 * 1000); // (reclaims only when asked to, so the counts below are exact)
+
+    beginTest("Swap on the next block");
+    {
+      ProcessorProxy proxy(reclaimer, std::make_unique<TrackedProcessor>(0));
+      proxy.exec();
+      expectEquals(TrackedProcessor::lastGeneration, 0);
+
+      proxy.SetProcessor(std::make_unique<TrackedProcessor>(1));
+      proxy.SetProcessor(std::make_unique<TrackedProcessor>(2)); // replaces 1 before the audio thread saw it
+      expectEquals(TrackedProcessor::numAlive.load(), 2);
+
+      proxy.exec();
+      expectEquals(TrackedProcessor::lastGeneration, 2);
+      expectEquals(proxy.GetNumSwaps(), 1);
+
+      // 0 is retired, not freed (that's the reclaimer's job)
+      expectEquals(TrackedProcessor::numAlive.load(), 2);
+      reclaimer.ReclaimNow();
+      expectEquals(TrackedProcessor::numAlive.load(), 1);
+    }
+    expectEquals(TrackedProcessor::numAlive.load(), 0);
+
+    beginTest("SetProcessor(nullptr) retires the running processor");
+    {
+      ProcessorProxy proxy(reclaimer, std::make_unique<TrackedProcessor>(0));
+      proxy.exec();
+
+      proxy.SetProcessor(std::make_unique<TrackedProcessor>(1));
+      proxy.SetProcessor(nullptr); // (1 never reaches the audio thread: freed right away)
+      expectEquals(TrackedProcessor::numAlive.load(), 1);
+      expectEquals(proxy.getUiParameterList().GetNumParameters(), 0);
+
+      TrackedProcessor::lastGeneration = -1;
+      proxy.exec();
+      expectEquals(TrackedProcessor::lastGeneration, -1); // (nothing runs)
+      expectEquals(proxy.GetNumSwaps(), 1);
+
+      reclaimer.ReclaimNow();
+      expectEquals(TrackedProcessor::numAlive.load(), 0);
+
+      // and it takes a processor again
+      proxy.SetProcessor(std::make_unique<TrackedProcessor>(2));
+      proxy.exec();
+      expectEquals(TrackedProcessor::lastGeneration, 2);
+    }
+    expectEquals(TrackedProcessor::numAlive.load(), 0);
+
+    beginTest("A full retire fifo postpones swaps");
+    {
+      ProcessorProxy proxy(reclaimer);
+      proxy.exec(); // (empty proxy is a no-op)
+
+      int generation = 0;
+      for (; generation < 200 && proxy.GetNumSwaps() == generation; ++generation)
+      {
+        proxy.SetProcessor(std::make_unique<TrackedProcessor>(generation));
+        proxy.exec();
+      }
+      expect(generation < 200);
+      expectEquals(TrackedProcessor::lastGeneration, generation - 2); // (last one is still pending)
+
+      reclaimer.ReclaimNow();
+      proxy.exec();
+      expectEquals(TrackedProcessor::lastGeneration, generation - 1);
+    }
+    expectEquals(TrackedProcessor::numAlive.load(), 0);
+
+    beginTest("Blocks go to the current processor, new processors arrive prepared");
+    {
+      ProcessorProxy proxy(reclaimer, std::make_unique<TrackedProcessor>(0));
+      AlignedAudioBuffer<float> buffer(1, 32);
+      proxy.processBlock(buffer.GetView(), {}); // (TrackedProcessor falls back on exec())
+      expectEquals(TrackedProcessor::lastGeneration, 0);
+
+      proxy.prepare({ 48000.0, 32, 1 });
+      auto gain = std::make_unique<GainMixProcessor>();
+      gain->GetParameterList()[GainMixProcessor::Gain]->SetAsVar(2.f);
+      proxy.SetProcessor(std::move(gain));
+
+      juce::FloatVectorOperations::fill(buffer.GetChannel(0), 1.f, 32);
+      proxy.processBlock(buffer.GetView(), {});
+      expectEquals(buffer.GetChannel(0)[31], 2.f); // (prepare() starts it at its parameter's value, no ramp)
+      reclaimer.ReclaimNow();
+    }
+    expectEquals(TrackedProcessor::numAlive.load(), 0);
+
+    beginTest("Stress: 1000 swaps/s while exec() runs");
+    {
+      constexpr int NumSwaps = 1000;
+
+      ProcessorReclaimer backgroundReclaimer(5);
+      ProcessorProxy proxy(backgroundReclaimer, std::make_unique<TrackedProcessor>(0));
+      std::atomic<bool> bStop { false };
+
+      bool bMonotonic = true;
+      double maxExecMicroseconds = 0.0;
+      juce::int64 numBlocks = 0;
+
+      std::thread audioThread([&]
+      {
+        RealtimeCheck::ScopedRealtimeThread realtime;
+        int previous = 0;
+        while (!bStop.load(std::memory_order_relaxed))
+        {
+          const juce::int64 start = juce::Time::getHighResolutionTicks();
+          proxy.exec();
+          const juce::int64 end = juce::Time::getHighResolutionTicks();
+
+          maxExecMicroseconds = juce::jmax(maxExecMicroseconds, juce::Time::highResolutionTicksToSeconds(end - start) * 1.0e6);
+          bMonotonic &= TrackedProcessor::lastGeneration >= previous;
+          previous = TrackedProcessor::lastGeneration;
+          ++numBlocks;
+        }
+      });
+
+      for (int generation = 1; generation <= NumSwaps; ++generation)
+      {
+        proxy.SetProcessor(std::make_unique<TrackedProcessor>(generation));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+
+      // let the audio thread pick up the last one and the reclaimer free the rest
+      for (int i = 0; i < 1000 && TrackedProcessor::numAlive.load() > 1; ++i)
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+
+      bStop.store(true);
+      audioThread.join();
+
+      expect(!TrackedProcessor::bRanDeleted, "exec() ran a freed processor");
+      expect(bMonotonic);
+      expectEquals(TrackedProcessor::lastGeneration, NumSwaps);
+      expect(proxy.GetNumSwaps() > 0 && proxy.GetNumSwaps() <= NumSwaps);
+      expectEquals(TrackedProcessor::numAlive.load(), 1);
+      expect(RealtimeCheck::TakeViolations().empty(), "exec() allocated or locked");
+      logMessage("  " + juce::String(proxy.GetNumSwaps()) + " swaps over " + juce::String(numBlocks) + " blocks, slowest exec(): "
+                 + juce::String(maxExecMicroseconds, 1) + " us");
+    }
+    expectEquals(TrackedProcessor::numAlive.load(), 0);
+  }
+
+} // namespace Haze
@@ -0,0 +1,23 @@
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace Haze
+{
+namespace UnitTests
+{
+
+  class ProcessorProxyTest : public juce::UnitTest
+  {
+  public:
+    // ctor
+    ProcessorProxyTest() : UnitTest("ProcessorProxy hot swap") {}
+
+    virtual void runTest() override final;
+
+  }; // ProcessorProxyTest
+
+  static ProcessorProxyTest ProxyTest; // static addition to the test array
+
+} // UnitTests
+} // Haze
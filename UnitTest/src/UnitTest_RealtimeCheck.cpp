@@ -0,0 +1,221 @@
+
+#include "UnitTest_RealtimeCheck.h"
+#include "RealtimeCheck.h"
+#include "ProcessorGraph.h"
+#include "GainMixProcessor.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace Haze
+{
+  namespace
+  {
+    // keeps the compiler from eliding the new/delete pair under test
+    int* volatile sink = nullptr;
+
+    juce::String Describe(const std::vector<RealtimeCheck::Violation>& violations)
+    {
+      return violations.empty() ? juce::String() : violations.front().ToString();
+    }
+
+    // allocates in exec(), but only when a pool worker (not the thread that called Run()) runs it
+    class WorkerAllocatingProcessor : public ProcessorInterface
+    {
+    public:
+      explicit WorkerAllocatingProcessor(std::thread::id caller) : caller_(caller) {}
+
+      const ParameterList& getUiParameterList() const override { return params_; }
+
+      void exec() override
+      {
+        std::this_thread::sleep_for(std::chrono::microseconds(200)); // (long enough for the workers to wake up and steal)
+
+        if (std::this_thread::get_id() != caller_)
+        {
+          sink = new int(42);
+          delete sink;
+          numWorkerRuns.fetch_add(1);
+        }
+      }
+
+      static inline std::atomic<int> numWorkerRuns { 0 };
+
+    private:
+      const std::thread::id caller_;
+      ParameterList params_;
+    };
+  } // namespace
+
+  void UnitTests::RealtimeCheckTest::runTest()
+  {
+    if (!RealtimeCheck::IsEnabled)
+    {
+      beginTest("Disabled (build w/ HAZE_REALTIME_CHECKS=1)");
+      expect(!RealtimeCheck::IsRealtimeThread());
+      return;
+    }
+
+    juce::ignoreUnused(RealtimeCheck::TakeViolations());
+
+    beginTest("Allocations, frees and locks on a realtime thread are caught");
+    {
+      std::mutex mutex;
+      {
+        RealtimeCheck::ScopedRealtimeThread realtime;
+        expect(RealtimeCheck::IsRealtimeThread());
+
+        sink = new int(42);
+        delete sink;
+
+        mutex.lock();
+        mutex.unlock();
+      }
+      expect(!RealtimeCheck::IsRealtimeThread());
+
+      const auto violations = RealtimeCheck::TakeViolations();
+      const auto count = [&violations](RealtimeCheck::Kind kind)
+      {
+        return std::count_if(violations.begin(), violations.end(), [kind](const auto& v) { return v.kind == kind; });
+      };
+
+      expectEquals(static_cast<int>(count(RealtimeCheck::Kind::Allocation)), 1);
+      expectEquals(static_cast<int>(count(RealtimeCheck::Kind::Deallocation)), 1);
+      expectEquals(static_cast<int>(count(RealtimeCheck::Kind::Lock)), RealtimeCheck::CanDetectLocks() ? 1 : 0);
+      expect(violations.front().numBytes == sizeof(int));
+      expect(violations.front().stackTrace.isNotEmpty());
+      expectEquals(RealtimeCheck::GetNumViolations(), 0);
+
+      // other threads are left alone
+      sink = new int(42);
+      delete sink;
+      expect(RealtimeCheck::TakeViolations().empty());
+    }
+
+    beginTest("Pool workers running a realtime caller's tasks are checked too");
+    {
+      ProcessorGraph graph;
+      for (int i = 0; i < 16; ++i)
+      {
+        graph.AddNode(std::make_unique<WorkerAllocatingProcessor>(std::this_thread::get_id()));
+      }
+      graph.Prepare();
+      WorkerPool pool(4);
+
+      // (until the workers have picked up some of the nodes)
+      for (int block = 0; block < 1000 && WorkerAllocatingProcessor::numWorkerRuns.load() == 0; ++block)
+      {
+        RealtimeCheck::ScopedRealtimeThread realtime;
+        graph.Process(pool);
+      }
+      expect(WorkerAllocatingProcessor::numWorkerRuns.load() > 0);
+      expect(!RealtimeCheck::TakeViolations().empty());
+
+      // and aren't when the caller isn't realtime
+      std::this_thread::sleep_for(std::chrono::milliseconds(10)); // (workers done w/ the last realtime run)
+      graph.Process(pool);
+      expect(RealtimeCheck::TakeViolations().empty());
+    }
+
+    beginTest("Known offender: GetStateAsTree()");
+    {
+      ParameterList list;
+      list.add("a", 1.f);
+      {
+        RealtimeCheck::ScopedRealtimeThread realtime;
+        juce::ignoreUnused(list.GetStateAsTree());
+      }
+      expect(!RealtimeCheck::TakeViolations().empty());
+    }
+
+    beginTest("Parameter read paths");
+    {
+      ParameterList list(ParameterList::TransportMode::Realtime);
+      list.add("float", 0.5f, ParamRange<float> { 0.f, 1.f })
+          .add("int", 3)
+          .add("bool", true);
+
+      const ParamHandle<float> floatHandle = list.GetHandle<float>("float");
+      const ParamHandle<int> intHandle = list.GetHandle<int>("int");
+      const ParamHandle<bool> boolHandle = list.GetHandle<bool>("bool");
+      const juce::Identifier floatId("float");
+      const int boolIndex = list.IndexOf("bool");
+
+      SmoothedParam smoothed(list, floatId);
+      smoothed.Prepare(1000.0, 0.1);
+      floatHandle.Set(1.f);
+      std::vector<float> ramp(64);
+
+      float sum = 0.f;
+      {
+        RealtimeCheck::ScopedRealtimeThread realtime;
+
+        sum += floatHandle.Load() + floatHandle.Get() + static_cast<float>(intHandle.Load() + intHandle.Get());
+        sum += boolHandle.Load() ? 1.f : 0.f;
+        sum += list[floatId]->Get<float>();
+        sum += list.GetParameter(boolIndex).Get<bool>() ? 1.f : 0.f;
+        sum += list.IndexOf(floatId) >= 0 ? 1.f : 0.f;
+        sum += floatHandle.IsEqualTo(1.f) ? 1.f : 0.f;
+        smoothed.RenderBlock(ramp.data(), static_cast<int>(ramp.size()));
+      }
+      expect(sum > 0.f && ramp.back() > 0.5f);
+
+      const auto violations = RealtimeCheck::TakeViolations();
+      expect(violations.empty(), Describe(violations));
+    }
+
+    beginTest("Processors: GainMixProcessor, ProcessorGraph (serial and pooled), ProcessorProxy");
+    {
+      constexpr int BlockSize = 128;
+      const ProcessSpec spec { 48000.0, BlockSize, 2 };
+
+      GainMixProcessor gainMix;
+      gainMix.prepare(spec);
+      gainMix.GetParameterList()[GainMixProcessor::Gain]->SetAsVar(2.f);
+
+      ProcessorGraph graph;
+      const ProcessorGraph::NodeId first = graph.AddNode(std::make_unique<GainMixProcessor>());
+      const ProcessorGraph::NodeId second = graph.AddNode(std::make_unique<GainMixProcessor>());
+      graph.Connect(first, second);
+      graph.Prepare(spec);
+      WorkerPool pool(4); // (workers go to sleep between blocks: waking them must not lock)
+
+      ProcessorReclaimer reclaimer(60 * 60 * 1000);
+      ProcessorProxy proxy(reclaimer, std::make_unique<GainMixProcessor>());
+      proxy.prepare(spec);
+
+      AlignedAudioBuffer<float> floats(2, BlockSize * 3); // (longer than prepared, gets chunked)
+      AlignedAudioBuffer<double> doubles(2, BlockSize);
+
+      for (int block = 0; block < 8; ++block)
+      {
+        // message thread side: new targets and a new processor every other block
+        gainMix.GetParameterList()[GainMixProcessor::Mix]->SetAsVar(static_cast<float>(block % 2));
+        if (block % 2 == 0)
+        {
+          proxy.SetProcessor(std::make_unique<GainMixProcessor>());
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(10)); // (an audio callback's worth of idle)
+
+        const BlockContext context { spec.sampleRate, static_cast<juce::int64>(block * BlockSize) };
+        RealtimeCheck::ScopedRealtimeThread realtime;
+        gainMix.getParameterEvents()->Add(block * 16, GainMixProcessor::GainIndex, 1.5f);
+        proxy.getParameterEvents()->Add(block * 16, GainMixProcessor::MixIndex, 0.5f);
+        gainMix.processBlock(floats.GetView(), context);
+        gainMix.processBlock(doubles.GetView(), context);
+        gainMix.exec();
+        graph.ProcessBlock(floats.GetView(), context);
+        graph.ProcessBlock(pool, floats.GetView(), context);
+        proxy.processBlock(floats.GetView(2, BlockSize), context);
+        proxy.exec();
+      }
+      expectEquals(proxy.GetNumSwaps(), 4);
+      reclaimer.ReclaimNow();
+
+      const auto violations = RealtimeCheck::TakeViolations();
+      expect(violations.empty(), Describe(violations));
+    }
+  }
+
+} // namespace Haze
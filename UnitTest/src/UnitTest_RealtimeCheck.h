@@ -0,0 +1,23 @@
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace Haze
+{
+namespace UnitTests
+{
+
+  class RealtimeCheckTest : public juce::UnitTest
+  {
+  public:
+    // ctor
+    RealtimeCheckTest() : UnitTest("Realtime safety") {}
+
+    virtual void runTest() override final;
+
+  }; // RealtimeCheckTest
+
+  static RealtimeCheckTest RealtimeTest; // static addition to the test array
+
+} // UnitTests
+} // Haze
@@ -0,0 +1,132 @@
+
+#include "UnitTest_RealtimeTransport.h"
+#include "ParameterTypes.h"
+#include <thread>
+
+namespace Haze
+{
+
+  void UnitTests::RealtimeTransportTest::runTest()
+  {
+    const juce::Identifier Freq("freq");
+    const juce::Identifier Label("label");
+
+    beginTest("Writes are published to Load()");
+    {
+      ParameterList param_list(ParameterList::TransportMode::Realtime);
+      param_list
+        .add(Freq, 500.f)
+        .add(Label, juce::String("init"))
+      ;
+
+      auto freq = param_list.GetHandle<float>(Freq);
+      auto label = param_list.GetHandle<juce::String>(Label);
+      expect(freq.Load() == 500.f);
+      expect(label.Load() == "init");
+
+      *param_list[Freq] = 15.f;
+      param_list[Label]->SetAsVar("updated");
+      expect(freq.Load() == 15.f);
+      expect(label.Load() == "updated");
+
+      // the message thread can poke the storage directly, but has to publish explicitly
+      freq.GetRef() = 20.f;
+      expect(freq.Load() == 15.f);
+      param_list.GetHandle<float>(Freq).Set(freq.Get());
+      expect(freq.Load() == 20.f);
+    }
+
+    beginTest("Direct transport reads the underlying storage");
+    {
+      ParameterList param_list;
+      param_list.add(Freq, 500.f);
+
+      auto freq = param_list.GetHandle<float>(Freq);
+      freq.GetRef() = 20.f;
+      expect(freq.Load() == 20.f);
+    }
+
+    // writer hammers SetAsVar (as the ValueTree listener would) while a reader polls like an audio callback
+    beginTest("Stress: concurrent SetAsVar vs. Load (no torn values)");
+    {
+      constexpr int NumWrites = 200000;
+
+      ParameterList param_list(ParameterList::TransportMode::Realtime);
+      param_list
+        .add(Freq, 0.f)
+        .add(Label, juce::String("a"))
+      ;
+
+      auto& freqParam = param_list[Freq];
+      auto& labelParam = param_list[Label];
+      const auto freq = param_list.GetHandle<float>(Freq);
+      const auto label = param_list.GetHandle<juce::String>(Label);
+
+      std::atomic<bool> bWriterDone { false };
+
+      std::thread writer([&]()
+      {
+        for (int i = 1; i <= NumWrites; ++i)
+        {
+          // floats: strictly increasing integers (exact in a float up to 2^24)
+          freqParam->SetAsVar(static_cast<double>(i));
+
+          // strings: one repeated character, length tied to the character
+          const int c = i % 26;
+          labelParam->SetAsVar(juce::String::repeatedString(juce::String::charToString(static_cast<char>('a' + c)), c + 1));
+        }
+
+        bWriterDone = true;
+      });
+
+      int numReads = 0;
+      int numTornFloats = 0;
+      int numTornStrings = 0;
+      int numOutOfOrder = 0;
+      float lastFreq = 0.f;
+      juce::int64 worstTicks = 0;
+
+      while (!bWriterDone.load())
+      {
+        const juce::int64 start = juce::Time::getHighResolutionTicks();
+        const float f = freq.Load();
+        const juce::String& s = label.Load();
+        const juce::int64 elapsed = juce::Time::getHighResolutionTicks() - start;
+        worstTicks = juce::jmax(worstTicks, elapsed);
+
+        if (f != std::floor(f) || f < 0.f || f > static_cast<float>(NumWrites))
+        {
+          ++numTornFloats;
+        }
+
+        if (f < lastFreq)
+        {
+          ++numOutOfOrder;
+        }
+        lastFreq = f;
+
+        const int len = s.length();
+        const juce::juce_wchar first = s[0];
+        bool bIsConsistent = len >= 1 && len <= 26 && first == static_cast<juce::juce_wchar>('a' + len - 1);
+        for (int i = 1; bIsConsistent && i < len; ++i)
+        {
+          bIsConsistent = s[i] == first;
+        }
+        numTornStrings += bIsConsistent ? 0 : 1;
+
+        ++numReads;
+      }
+
+      writer.join();
+
+      expect(numTornFloats == 0, "torn float reads: " + juce::String(numTornFloats));
+      expect(numTornStrings == 0, "torn string reads: " + juce::String(numTornStrings));
+      expect(numOutOfOrder == 0, "float reads went back in time: " + juce::String(numOutOfOrder));
+      expect(freq.Load() == static_cast<float>(NumWrites));
+
+      logMessage("  " + juce::String(numReads) + " reads during " + juce::String(NumWrites) + " writes, worst-case read latency: "
+                 + juce::String(juce::Time::highResolutionTicksToSeconds(worstTicks) * 1.0e9, 0) + " ns");
+    }
+  }
+
+} // Haze
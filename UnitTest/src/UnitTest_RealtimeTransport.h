@@ -0,0 +1,23 @@
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace Haze
+{
+namespace UnitTests
+{
+
+  class RealtimeTransportTest : public juce::UnitTest
+  {
+  public:
+    // ctor
+    RealtimeTransportTest() : UnitTest("Realtime parameter transport") {}
+
+    virtual void runTest() override final;
+
+  }; // RealtimeTransportTest
+
+  static RealtimeTransportTest TransportTest; // static addition to the test array
+
+} // UnitTests
+} // Haze
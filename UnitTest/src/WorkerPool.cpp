@@ -0,0 +1,335 @@
+
+#include "WorkerPool.h"
+#include "RealtimeCheck.h"
+
+#if JUCE_WINDOWS
+ #include <windows.h>
+#elif JUCE_MAC || JUCE_IOS
+ #include <dispatch/dispatch.h>
+#else
+ #include <cerrno>
+#endif
+
+namespace Haze
+{
+// WorkStealingDeque impl:
+  WorkStealingDeque::WorkStealingDeque(int capacity)
+  {
+    const auto size = static_cast<std::int64_t>(juce::nextPowerOfTwo(juce::jmax(capacity, 2)));
+    tasks_ = std::make_unique<std::atomic<int>[]>(static_cast<size_t>(size));
+    mask_ = size - 1;
+  }
+
+  bool WorkStealingDeque::Push(int task) noexcept
+  {
+    const std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    const std::int64_t top = top_.load(std::memory_order_acquire);
+    if (bottom - top > mask_)
+    {
+      return false;
+    }
+
+    tasks_[static_cast<size_t>(bottom & mask_)].store(task, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  int WorkStealingDeque::Pop() noexcept
+  {
+    const std::int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t top = top_.load(std::memory_order_relaxed);
+
+    if (top > bottom)
+    {
+      // was empty
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return Empty;
+    }
+
+    int task = tasks_[static_cast<size_t>(bottom & mask_)].load(std::memory_order_relaxed);
+    if (top == bottom)
+    {
+      // last one: race the thieves for it
+      if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+      {
+        task = Empty;
+      }
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    return task;
+  }
+
+  int WorkStealingDeque::Steal() noexcept
+  {
+    std::int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+
+    if (top >= bottom)
+    {
+      return Empty;
+    }
+
+    const int task = tasks_[static_cast<size_t>(top & mask_)].load(std::memory_order_relaxed);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+    {
+      return Empty; // lost the race, the caller looks elsewhere
+    }
+
+    return task;
+  }
+
+// WakeSemaphore impl:
+  WakeSemaphore::WakeSemaphore()
+  {
+   #if JUCE_WINDOWS
+    handle_ = CreateSemaphoreW(nullptr, 0, LONG_MAX, nullptr);
+   #elif JUCE_MAC || JUCE_IOS
+    handle_ = dispatch_semaphore_create(0);
+   #else
+    sem_init(&semaphore_, 0, 0);
+   #endif
+  }
+
+  WakeSemaphore::~WakeSemaphore()
+  {
+   #if JUCE_WINDOWS
+    CloseHandle(handle_);
+   #elif JUCE_MAC || JUCE_IOS
+    dispatch_release(static_cast<dispatch_semaphore_t>(handle_));
+   #else
+    sem_destroy(&semaphore_);
+   #endif
+  }
+
+  void WakeSemaphore::Post(int count) noexcept
+  {
+    if (count <= 0)
+    {
+      return;
+    }
+
+   #if JUCE_WINDOWS
+    ReleaseSemaphore(handle_, count, nullptr);
+   #else
+    for (int i = 0; i < count; ++i)
+    {
+     #if JUCE_MAC || JUCE_IOS
+      dispatch_semaphore_signal(static_cast<dispatch_semaphore_t>(handle_));
+     #else
+      sem_post(&semaphore_);
+     #endif
+    }
+   #endif
+  }
+
+  void WakeSemaphore::Wait() noexcept
+  {
+   #if JUCE_WINDOWS
+    WaitForSingleObject(handle_, INFINITE);
+   #elif JUCE_MAC || JUCE_IOS
+    dispatch_semaphore_wait(static_cast<dispatch_semaphore_t>(handle_), DISPATCH_TIME_FOREVER);
+   #else
+    while (sem_wait(&semaphore_) != 0 && errno == EINTR)
+    {
+    }
+   #endif
+  }
+
+// WorkerPool impl:
+  WorkerPool::WorkerPool(int numThreads, int maxTasks)
+  : maxTasks_(maxTasks)
+  {
+    jassert(numThreads >= 1);
+
+    for (int i = 0; i < juce::jmax(numThreads, 1); ++i)
+    {
+      deques_.push_back(std::make_unique<WorkStealingDeque>(maxTasks));
+    }
+
+    for (int i = 1; i < GetNumThreads(); ++i)
+    {
+      workers_.emplace_back([this, i] { WorkerLoop(i); });
+    }
+  }
+
+  WorkerPool::~WorkerPool()
+  {
+    bQuit_.store(true, std::memory_order_seq_cst);
+    wake_.Post(static_cast<int>(workers_.size()));
+
+    for (auto& worker : workers_)
+    {
+      worker.join();
+    }
+  }
+
+  void WorkerPool::Run(const TaskSet& tasks)
+  {
+    jassert(tasks.numTasks <= maxTasks_);
+
+    if (tasks.numTasks <= 0)
+    {
+      return;
+    }
+
+    // another thread is in Run(): both sets would share current_ and remaining_
+    const bool bWasRunning = bIsRunning_.exchange(true, std::memory_order_acquire);
+    jassert(!bWasRunning);
+    juce::ignoreUnused(bWasRunning);
+
+    current_.store(&tasks, std::memory_order_release);
+    remaining_.store(tasks.numTasks, std::memory_order_release);
+    bIsRealtimeRun_.store(RealtimeCheck::IsRealtimeThread(), std::memory_order_relaxed);
+
+    for (int i = 0; i < tasks.numRoots; ++i)
+    {
+      const bool bPushed = deques_[0]->Push(tasks.roots[i]);
+      jassert(bPushed); // (capacity is maxTasks, a task is only ever queued once per run)
+      juce::ignoreUnused(bPushed);
+    }
+
+    // every worker that registered as sleeping before the new generation gets one post
+    generation_.fetch_add(1, std::memory_order_seq_cst);
+    wake_.Post(numSleeping_.exchange(0, std::memory_order_seq_cst));
+
+    Participate(0);
+    bIsRunning_.store(false, std::memory_order_release);
+  }
+
+  void WorkerPool::WorkerLoop(int threadIndex)
+  {
+    constexpr int NumSpins = 2000; // blocks tend to arrive back to back, stay awake for a bit
+
+    juce::uint32 seenGeneration = generation_.load(std::memory_order_acquire);
+    while (true)
+    {
+      for (int spin = 0; spin < NumSpins && generation_.load(std::memory_order_acquire) == seenGeneration && !bQuit_.load(std::memory_order_relaxed); ++spin)
+      {
+        std::this_thread::yield();
+      }
+
+      const auto bIsIdle = [this, seenGeneration]
+      {
+        return generation_.load(std::memory_order_seq_cst) == seenGeneration && !bQuit_.load(std::memory_order_seq_cst);
+      };
+
+      // register, then re-check: either Run() counts this worker (and posts) or the new generation is seen here.
+      // losing that race leaves a post behind, which only costs a spurious wake later
+      while (bIsIdle())
+      {
+        numSleeping_.fetch_add(1, std::memory_order_seq_cst);
+        if (bIsIdle())
+        {
+          wake_.Wait();
+        }
+      }
+
+      if (bQuit_.load())
+      {
+        return;
+      }
+
+      seenGeneration = generation_.load(std::memory_order_acquire);
+
+      // (a worker runs the caller's tasks: realtime checks cover it like they cover the caller)
+      if (bIsRealtimeRun_.load(std::memory_order_relaxed))
+      {
+        RealtimeCheck::ScopedRealtimeThread realtime;
+        Participate(threadIndex);
+      }
+      else
+      {
+        Participate(threadIndex);
+      }
+    }
+  }
+
+  void WorkerPool::Participate(int threadIndex)
+  {
+    juce::uint32 rng = static_cast<juce::uint32>(threadIndex) * 0x9E3779B9u + 1u;
+
+    while (remaining_.load(std::memory_order_acquire) > 0)
+    {
+      const int task = FindTask(threadIndex, rng);
+      if (task != WorkStealingDeque::Empty)
+      {
+        Execute(threadIndex, task);
+      }
+      else
+      {
+        std::this_thread::yield(); // everything left is waiting on inputs that are running elsewhere
+      }
+    }
+  }
+
+  int WorkerPool::FindTask(int threadIndex, juce::uint32& rng) noexcept
+  {
+    const int task = deques_[static_cast<size_t>(threadIndex)]->Pop();
+    if (task != WorkStealingDeque::Empty)
+    {
+      return task;
+    }
+
+    // steal, starting at a random victim so the thieves spread out
+    const int numThreads = GetNumThreads();
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+
+    const int first = static_cast<int>(rng % static_cast<juce::uint32>(numThreads));
+    for (int i = 0; i < numThreads; ++i)
+    {
+      const int victim = (first + i) % numThreads;
+      if (victim != threadIndex)
+      {
+        const int stolen = deques_[static_cast<size_t>(victim)]->Steal();
+        if (stolen != WorkStealingDeque::Empty)
+        {
+          return stolen;
+        }
+      }
+    }
+
+    return WorkStealingDeque::Empty;
+  }
+
+  void WorkerPool::Execute(int threadIndex, int task)
+  {
+    const TaskSet& tasks = *current_.load(std::memory_order_acquire);
+    WorkStealingDeque& deque = *deques_[static_cast<size_t>(threadIndex)];
+
+    while (task != WorkStealingDeque::Empty)
+    {
+      tasks.run(tasks.context, task);
+
+      // the first successor this unlocks runs right here, the rest are up for grabs
+      int next = WorkStealingDeque::Empty;
+      for (int i = tasks.successorOffsets[task]; i < tasks.successorOffsets[task + 1]; ++i)
+      {
+        const int successor = tasks.successors[i];
+        if (tasks.pendingInputs[successor].fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+          if (next == WorkStealingDeque::Empty)
+          {
+            next = successor;
+          }
+          else
+          {
+            const bool bPushed = deque.Push(successor);
+            jassert(bPushed);
+            juce::ignoreUnused(bPushed);
+          }
+        }
+      }
+
+      remaining_.fetch_sub(1, std::memory_order_acq_rel);
+      task = next;
+    }
+  }
+
+} // namespace Haze
@@ -0,0 +1,130 @@
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if ! (JUCE_WINDOWS || JUCE_MAC || JUCE_IOS)
+ #include <semaphore.h>
+#endif
+
+namespace Haze
+{
+  // bounded Chase-Lev work-stealing deque of task indices
+  // the owning thread pushes/pops at the bottom, any other thread steals from the top.
+  // fixed capacity (no growth, no allocation after construction)
+  class WorkStealingDeque
+  {
+  public:
+    static constexpr int Empty = -1;
+
+    explicit WorkStealingDeque(int capacity);
+
+    // owner only, returns false when full
+    bool Push(int task) noexcept;
+    int Pop() noexcept;
+
+    // any thread
+    int Steal() noexcept;
+
+  private:
+    std::unique_ptr<std::atomic<int>[]> tasks_;
+    std::int64_t mask_;
+    alignas(64) std::atomic<std::int64_t> top_ { 0 };
+    alignas(64) std::atomic<std::int64_t> bottom_ { 0 };
+  }; // class WorkStealingDeque
+
+
+  // counting semaphore on the os primitive, so Post() takes no mutex (std::condition_variable needs one):
+  // an atomic + futex on linux, a dispatch semaphore on apple, a kernel semaphore on windows
+  class WakeSemaphore
+  {
+  public:
+    // ctor
+    WakeSemaphore();
+    ~WakeSemaphore();
+
+    // wakes up to count waiters (realtime safe)
+    void Post(int count) noexcept;
+    void Wait() noexcept;
+
+  private:
+   #if JUCE_WINDOWS || JUCE_MAC || JUCE_IOS
+    void* handle_ = nullptr;
+   #else
+    sem_t semaphore_;
+   #endif
+
+    JUCE_DECLARE_NON_COPYABLE(WakeSemaphore)
+  }; // class WakeSemaphore
+
+
+  // a dependency graph of tasks, as WorkerPool::Run sees it
+  // (owned by the caller, see ProcessorGraph)
+  struct TaskSet
+  {
+    int numTasks = 0;
+
+    const int* roots = nullptr; // tasks w/o inputs
+    int numRoots = 0;
+
+    // task i unlocks successors[successorOffsets[i] .. successorOffsets[i + 1])
+    const int* successorOffsets = nullptr;
+    const int* successors = nullptr;
+
+    // inputs still outstanding per task, set to each task's number of inputs before every Run()
+    std::atomic<int>* pendingInputs = nullptr;
+
+    void (*run)(void* context, int task) = nullptr;
+    void* context = nullptr;
+  };
+
+
+  // runs a TaskSet on a fixed set of threads
+  // the calling (audio) thread takes part in every Run() instead of waiting on the others:
+  // each thread works its own deque and steals from the others when it runs dry
+  class WorkerPool
+  {
+  public:
+    // numThreads includes the calling thread (1 == everything runs on the caller)
+    explicit WorkerPool(int numThreads, int maxTasks = 1024);
+    ~WorkerPool();
+
+    [[nodiscard]] int GetNumThreads() const noexcept { return static_cast<int>(deques_.size()); }
+    [[nodiscard]] int GetMaxTasks() const noexcept { return maxTasks_; }
+
+    // returns once every task has run (no allocation, no locks)
+    // one Run() at a time: a pool works a single set, so each concurrently processed domain needs its own pool
+    // (w/ HAZE_REALTIME_CHECKS, workers count as realtime threads while they work a realtime caller's set)
+    void Run(const TaskSet& tasks);
+
+  private:
+    void WorkerLoop(int threadIndex);
+
+    // works until the current set is finished
+    void Participate(int threadIndex);
+    int FindTask(int threadIndex, juce::uint32& rng) noexcept;
+    void Execute(int threadIndex, int task);
+
+    std::vector<std::unique_ptr<WorkStealingDeque>> deques_; // [0] belongs to the caller of Run()
+    std::vector<std::thread> workers_;
+    const int maxTasks_;
+
+    std::atomic<bool> bIsRunning_ { false }; // (catches overlapping Run()s)
+    std::atomic<bool> bIsRealtimeRun_ { false }; // Run()'s caller is a RealtimeCheck realtime thread
+    std::atomic<const TaskSet*> current_ { nullptr };
+    alignas(64) std::atomic<int> remaining_ { 0 };
+
+    // idle workers sleep here between runs
+    WakeSemaphore wake_;
+    std::atomic<juce::uint32> generation_ { 0 };
+    std::atomic<int> numSleeping_ { 0 };
+    std::atomic<bool> bQuit_ { false };
+
+  }; // class WorkerPool
+
+} // namespace Haze